@@ -6,6 +6,8 @@
  * 
  * @editor  Alex Hansen, alexander.hansen@colorado.edu
  * @date    July 1, 2026
+ * @log     Non-blocking reader: bulk drain + latest-frame mailbox (Oct 17, 2026)
+ *          Per-frame handler for the PM extended mode (Oct 17, 2026)
  ******************************************************************************/
 #include "Arduino.h"
 #include "PMS.h"
@@ -46,6 +48,7 @@ void PMS::passiveMode()
 }
 
 // Drop unread sensor bytes so the next read starts from a fresh Plantower frame.
+// Spins for up to 250 ms - setup() only; the sampling loop uses poll()/take().
 void PMS::clearInput(uint16_t quietTime)
 {
   const uint16_t maxClearTime = 250;
@@ -65,11 +68,8 @@ void PMS::clearInput(uint16_t quietTime)
     }
   }
 
-  _status = STATUS_WAITING;
-  _index = 0;
-  _frameLen = 0;
-  _checksum = 0;
-  _calculatedChecksum = 0;
+  resetParser();
+  _fresh = false;
 }
 
 // Request read in Passive Mode.
@@ -82,126 +82,182 @@ void PMS::requestRead()
   }
 }
 
-// Non-blocking function for parse response.
+// Non-blocking: true (and data filled) if a new frame has been parsed.
 bool PMS::read(DATA& data)
 {
-  _data = &data;
-  loop();
-  
-  return _status == STATUS_OK;
+  uint32_t arrived;
+
+  poll();
+  return take(data, arrived);
 }
 
 // Blocking function for parse response. Default timeout is 1s.
 bool PMS::readUntil(DATA& data, uint16_t timeout)
 {
-  _data = &data;
   uint32_t start = millis();
   do
   {
-    loop();
-    if (_status == STATUS_OK) break;
+    if (read(data)) return true;
   } while (millis() - start < timeout);
 
-  return _status == STATUS_OK;
+  return false;
 }
 
-void PMS::loop()
+// Non-blocking clearInput(): drops buffered bytes, any partial frame and an
+// untaken frame, so the next published frame answers the next request.
+void PMS::discardInput()
 {
-  _status = STATUS_WAITING;
-  if (_stream->available())
+  for (int n = _stream->available(); n > 0; n--)
   {
-    uint8_t ch = _stream->read();
+    _stream->read();
+  }
+
+  resetParser();
+  _fresh = false;
+}
 
-    switch (_index)
+// Non-blocking: runs every byte already buffered (the serial RX interrupt fills
+// that buffer) through the frame parser. Valid frames land in the mailbox.
+void PMS::poll()
+{
+  for (int n = _stream->available(); n > 0; n--)
+  {
+    parse(_stream->read());
+  }
+}
+
+// True if a frame arrived since the last take().
+bool PMS::hasFrame() const
+{
+  return _fresh;
+}
+
+// Copies the latest frame and the millis() it arrived at; false if nothing new.
+bool PMS::take(DATA& data, uint32_t& arrived)
+{
+  if (!_fresh) return false;
+
+  data = _frame;
+  arrived = _frameTime;
+  _fresh = false;
+  return true;
+}
+
+// Every frame published from now on is also passed to handler (NULL: none).
+void PMS::onFrame(FrameHandler handler)
+{
+  _onFrame = handler;
+}
+
+void PMS::resetParser()
+{
+  _index = 0;
+  _frameLen = 0;
+  _checksum = 0;
+  _calculatedChecksum = 0;
+}
+
+// One byte of the frame state machine: 0x42 0x4D, length, payload, checksum.
+void PMS::parse(uint8_t ch)
+{
+  switch (_index)
+  {
+  case 0:
+    if (ch != 0x42)
     {
-    case 0:
-      if (ch != 0x42)
-      {
-        return;
-      }
-      _calculatedChecksum = ch;
-      break;
+      return;
+    }
+    _calculatedChecksum = ch;
+    break;
 
-    case 1:
-      if (ch != 0x4D)
-      {
-        _index = 0;
-        return;
-      }
-      _calculatedChecksum += ch;
-      break;
+  case 1:
+    if (ch != 0x4D)
+    {
+      _index = 0;
+      return;
+    }
+    _calculatedChecksum += ch;
+    break;
 
-    case 2:
-      _calculatedChecksum += ch;
-      _frameLen = ch << 8;
-      break;
+  case 2:
+    _calculatedChecksum += ch;
+    _frameLen = ch << 8;
+    break;
 
-    case 3:
-      _frameLen |= ch;
-      // Unsupported sensor, different frame length, transmission error e.t.c.
-      if (_frameLen != 2 * 9 + 2 && _frameLen != 2 * 13 + 2)
+  case 3:
+    _frameLen |= ch;
+    // Unsupported sensor, different frame length, transmission error e.t.c.
+    if (_frameLen != 2 * 9 + 2 && _frameLen != 2 * 13 + 2)
+    {
+      _index = 0;
+      return;
+    }
+    _calculatedChecksum += ch;
+    break;
+
+  default:
+    if (_index == _frameLen + 2)
+    {
+      _checksum = ch << 8;
+    }
+    else if (_index == _frameLen + 2 + 1)
+    {
+      _checksum |= ch;
+
+      if (_calculatedChecksum == _checksum)
       {
-        _index = 0;
-        return;
+        publish();
       }
+      _index = 0;
+      return;
+    }
+    else
+    {
       _calculatedChecksum += ch;
-      break;
+      uint8_t payloadIndex = _index - 4;
 
-    default:
-      if (_index == _frameLen + 2)
-      {
-        _checksum = ch << 8;
-      }
-      else if (_index == _frameLen + 2 + 1)
+      if (payloadIndex < sizeof(_payload))
       {
-        _checksum |= ch;
-
-        if (_calculatedChecksum == _checksum)
-        {
-          _status = STATUS_OK;
-
-          // Standard Particles, CF=1.
-          _data->pm10_standard = makeWord(_payload[0], _payload[1]);
-          _data->pm25_standard = makeWord(_payload[2], _payload[3]);
-          _data->pm100_standard = makeWord(_payload[4], _payload[5]);
-
-          // Atmospheric Environment.
-          _data->pm10_env = makeWord(_payload[6], _payload[7]);
-          _data->pm25_env = makeWord(_payload[8], _payload[9]);
-          _data->pm100_env = makeWord(_payload[10], _payload[11]);
-
-          // Total particles
-          uint8_t dataWords = _frameLen/2 - 1; // subtract checksum
-          if (dataWords >= 12) {
-            _data->particles_03um = makeWord(_payload[12], _payload[13]);
-            _data->particles_05um = makeWord(_payload[14], _payload[15]);
-            _data->particles_10um = makeWord(_payload[16], _payload[17]);
-            _data->particles_25um = makeWord(_payload[18], _payload[19]);
-            _data->particles_50um = makeWord(_payload[20], _payload[21]);
-            _data->particles_100um = makeWord(_payload[22], _payload[23]);
-            _data->hasParticles = true;
-          }
-          else {
-            _data->hasParticles = false;
-          }
-        }
-        _index = 0;
-        return;
+        _payload[payloadIndex] = ch;
       }
-      else
-      {
-        _calculatedChecksum += ch;
-        uint8_t payloadIndex = _index - 4;
+    }
 
-        if (payloadIndex < sizeof(_payload))
-        {
-          _payload[payloadIndex] = ch;
-        }
-      }
+    break;
+  }
 
-      break;
-    }
+  _index++;
+}
+
+// Decodes the checksum-valid payload into the mailbox, stamped with its arrival.
+void PMS::publish()
+{
+  // Standard Particles, CF=1.
+  _frame.pm10_standard = makeWord(_payload[0], _payload[1]);
+  _frame.pm25_standard = makeWord(_payload[2], _payload[3]);
+  _frame.pm100_standard = makeWord(_payload[4], _payload[5]);
 
-    _index++;
+  // Atmospheric Environment.
+  _frame.pm10_env = makeWord(_payload[6], _payload[7]);
+  _frame.pm25_env = makeWord(_payload[8], _payload[9]);
+  _frame.pm100_env = makeWord(_payload[10], _payload[11]);
+
+  // Total particles
+  uint8_t dataWords = _frameLen/2 - 1; // subtract checksum
+  if (dataWords >= 12) {
+    _frame.particles_03um = makeWord(_payload[12], _payload[13]);
+    _frame.particles_05um = makeWord(_payload[14], _payload[15]);
+    _frame.particles_10um = makeWord(_payload[16], _payload[17]);
+    _frame.particles_25um = makeWord(_payload[18], _payload[19]);
+    _frame.particles_50um = makeWord(_payload[20], _payload[21]);
+    _frame.particles_100um = makeWord(_payload[22], _payload[23]);
+    _frame.hasParticles = true;
+  }
+  else {
+    _frame.hasParticles = false;
   }
+
+  _frameTime = millis();
+  _fresh = true;
+
+  if (_onFrame) _onFrame(_frame);
 }
@@ -6,6 +6,8 @@
  * 
  * @editor  Alex Hansen, alexander.hansen@colorado.edu
  * @date    June 29, 2026
+ * @log     Non-blocking reader: bulk drain + latest-frame mailbox (Oct 17, 2026)
+ *          Per-frame handler for the PM extended mode (Oct 17, 2026)
  ******************************************************************************/
 #ifndef PMS_H
 #define PMS_H
@@ -53,14 +55,21 @@ public:
   bool read(DATA& data);
   bool readUntil(DATA& data, uint16_t timeout = SINGLE_RESPONSE_TIME);
 
+  // Latest-frame mailbox
+  void discardInput();
+  void poll();
+  bool hasFrame() const;
+  bool take(DATA& data, uint32_t& arrived);
+
+  // Called with every frame as it is published (from poll()), taken or not
+  typedef void (*FrameHandler)(const DATA& data);
+  void onFrame(FrameHandler handler);
+
 private:
-  enum STATUS { STATUS_WAITING, STATUS_OK };
   enum MODE { MODE_ACTIVE, MODE_PASSIVE };
 
   uint8_t _payload[24];
   Stream* _stream;
-  DATA* _data;
-  STATUS _status;
   MODE _mode = MODE_ACTIVE;
 
   uint8_t _index = 0;
@@ -68,7 +77,14 @@ private:
   uint16_t _checksum;
   uint16_t _calculatedChecksum;
 
-  void loop();
+  DATA _frame;              // last checksum-valid frame
+  uint32_t _frameTime = 0;  // millis() when its last byte was parsed
+  bool _fresh = false;      // _frame not taken yet
+  FrameHandler _onFrame = nullptr;
+
+  void resetParser();
+  void parse(uint8_t ch);
+  void publish();
 };
 
 #endif
@@ -20,12 +20,16 @@
 /*  Header Files  */
 #include "YPOD_node.h"
 #include "ads_module.h"  //P - last tested with "Adafruit ADS1X15@2.5.0" & "Adafruit BusIO@1.16.1"
+#include "i2c_bus.h"     //clock, stuck-bus recovery & the queue our own drivers use
 
 /*  Conditional Declarations  */
 // Calibration equations
 #if CALIBRATE
 #include "calibration.h"
 Cal cal;
+#if SD_ENABLED && CAL_FILE_ENABLED
+#include "cal_file.h"  //this pod's coefficients from CAL.CSV, read once in setup()
+#endif  //SD_ENABLED && CAL_FILE_ENABLED
 #endif
 //BME 180 - Temperature & Pressure - Bosch (DISCONTINUED)
 #if BME180
@@ -34,7 +38,8 @@ SFE_BMP180 BMP;
 #endif  //BME180
 //SHT 25 - Temperature & Pressure - Sensirion (DISCONTINUED)
 #if SHT25
-unsigned int temperature_board, humidity_board;
+#include "sht_module.h"
+SHT_Module sht_module;  //no-hold T & RH, CRC checked (see sht_module.h)
 #endif  //SHT25
 //Quadstat - Various Electrolytic Gas Sensors - Alphasense
 #if QUAD_ENABLED
@@ -49,7 +54,17 @@ quad_data qs_data;
 SoftwareSerial pmsSerial(2, 3);
 PMS pms(pmsSerial);
 PMS::DATA pms_data;
+uint32_t pms_time = 0;  //millis() when pms_data's frame arrived
+#if PMS_EXTENDED
+//PM extended mode - every frame between records into per-bin means & maxima (see pms_summary.h)
+#include "pms_summary.h"
+PmsSummary pms_summary;
+pms_summary_t pms_stats;  // the last record interval's
+#endif  //PMS_EXTENDED
 #endif  //PMS_ENABLED
+//ELT S300 - CO2, validated & retried without blocking (see s300_module.h)
+#include "s300_module.h"
+S300_Module s300_module;
 //ADS1115 Modules - Used for CO-B4 (CO), Fig2600 (VOC), Fig2602 (VOC) & MiSC 2611 (O3)
 ADS_Module ads_module;
 #if HEATERS_ENABLED
@@ -57,24 +72,480 @@ ads_heaters ads_data;
 #else
 ads_noheaters ads_data;
 #endif  //HEATERS_ENABLED
+#if ADS_OVERSAMPLE
+ads_summary_t ads_summary[ADS_USER_COUNT];  // mean, std & count per gas channel
+#endif  //ADS_OVERSAMPLE
+#if CALIBRATE
+calOutput cal_data;  // calibrated from ads_data (+ SHT25 & S300) once per record
+#endif  //CALIBRATE
 
 /*  RTC & File Formatting */
 //RTC DS3231 Module - to re-initialize time, use RTClib>examples>ds3231
 RTC_DS3231 RTC;
+#define RTC_ADDR 0x68  //DS3231 (RTClib keeps its own define private), for the #I2C counts
 #if SD_ENABLED
-  //SdFat (SD Card) & File file (file on SD)
-  #include <SdFat.h>   //P - last tested with "SdFat@2.2.3"
-  SdFat sd;
-  File file;
+  //SD card session (card, open file & RingBuf staging) - see sd_logger.h
+  #include "sd_logger.h"  //P - last tested with "SdFat@2.2.3"
+  SD_Logger logger;
   // Buffers
   // char ypodID[] = "YPODID";
-  char fileName[] = "YPODID_YYYY_MM_DD.CSV";
+  char fileName[LOG_NAME_SIZE] = "YPODID_YYYY_MM_DD.CSV";
+  uint32_t log_day;  //unixtime / 86400 of fileName's day - a record on another day rolls the file
 #endif //SD_ENABLED
 char firmwareFileName[32];
-char bufftime[] = "YYYY-MM-DDThh:mm:ss";
-int Y, M, D, h, m, s;
+//Software clock - DS3231 read once, then counted on by its 1 Hz SQW (see soft_clock.h)
+#include "soft_clock.h"
+SoftClock rtc_clock;
+#if SLEEP_ENABLED
+//Duty Cycle - powered down between samples, woken by DS3231 alarm 1 on the SQW/INT pin
+#if RTC_SQW_PIN < 0
+#error "SLEEP_ENABLED needs the DS3231 SQW/INT pin wired to RTC_SQW_PIN"
+#endif
+#include "duty_cycle.h"
+DutyCycle duty;
+#endif  //SLEEP_ENABLED
+
+/*  Sampling Scheduler  */
+#include "scheduler.h"
+Scheduler scheduler;
+/*  Loop Profiler - per-stage latency histograms (PROF_* compile out when disabled)  */
+#include "profiler.h"
+#if PROFILE_ENABLED
+Profiler profiler;
+// Report lines: one per stage, then one per I2C address, then the bus clears
+#define PROF_LINE_I2C   PROF_STAGES
+#define PROF_LINE_CLEAR (PROF_LINE_I2C + I2C_MAX_DEVICES)
+#define PROF_LINE_IDLE  0xFF  //no report in progress
+uint8_t prof_line = PROF_LINE_IDLE;  //next line writeProfile() looks at
+#endif  //PROFILE_ENABLED
+// Latest reading from each task (kept until that task collects again)
+bool pm_returned = false;
+bool sht_returned = false;  //a clean T & RH pair came in this cycle
+bool co2_returned = false;  //the S300 gave a valid reading this cycle
+bool quad_returned = false;  //all eight quadstat channels were read this cycle
+double T = -99;
+double P = -99;
+float temperature_SHT25 = 0;
+float humidity_SHT25 = 0;
+float CO2 = 0;
+
+/*  Record Builder - whole RETIGO line formatted once, then written to each sink  */
+#include "record.h"
+Record record;
+#if SERIAL_ENABLED
+uint16_t echo_left = 0;  //bytes at the end of record not yet handed to Serial
+#endif  //SERIAL_ENABLED
+
+/*  Column Schema - every RETIGO column once: name, unit, binary type, presence flag & variable (see schema.h)  */
+#include "schema.h"
+// Presence flags: a flagged column is blank in a record without its flag
+#define BIN_FLAG_PM   1  // a PM frame came in for this record
+#define BIN_FLAG_ADS  2  // + ads_sensor_id_e: that channel has oversampled stats
+#define BIN_FLAG_PMS_SUMMARY  (BIN_FLAG_ADS + ADS_USER_COUNT)  // PM extended: frames came in
+#define BIN_FLAG_SHT  (BIN_FLAG_PMS_SUMMARY + 1)  // the SHT25 read was clean
+#define BIN_FLAG_CO2  (BIN_FLAG_SHT + 1)  // the S300 reading was valid
+#define BIN_FLAG_QUAD (BIN_FLAG_CO2 + 1)  // every quadstat channel was read
+#define BIN_FLAG_CAL_CO2 (BIN_FLAG_QUAD + 1)  // calibrated CO2: both its S300 & SHT25 inputs were valid
+#if PMS_ENABLED && PMS_AGE_COLUMN
+uint32_t pms_age;  //ms between the PM frame's arrival and this record's timestamp
+#endif  //PMS_ENABLED && PMS_AGE_COLUMN
+
+// Mean, std & count of one oversampled ADS channel
+#define COL_ADS_STATS(name, id) \
+  COL(name "_mean", "raw", BIN_F32, BIN_FLAG_ADS + id, false, ads_summary[id].mean), \
+  COL(name "_std", "raw", BIN_F32, BIN_FLAG_ADS + id, false, ads_summary[id].std), \
+  COL(name "_n", "", BIN_U16, 0, false, ads_summary[id].count)
+// Mean & max of one PM extended bin
+#define COL_PMS_BIN(name, unit, bin) \
+  COL(name "_mean", unit, BIN_U16, BIN_FLAG_PMS_SUMMARY, false, pms_stats.mean[bin]), \
+  COL(name "_max", unit, BIN_U16, BIN_FLAG_PMS_SUMMARY, false, pms_stats.peak[bin])
+
+// RETIGO column order. A sensor that is not fitted keeps its columns, blank (the quadstat
+// has none then); summary columns are the aggregated channels
+constexpr column_t columns[] PROGMEM = {
+  COL_TIME("Timestamp", "UTC"),
+  COL_BLANK("EAST_LONGITUDE", "deg"),  //no GPS
+  COL_BLANK("NORTH_LATITUDE", "deg"),
+  COL_TEXT("ID", "-", BIN_POD_ID, ypodID),
+  COL_TEXT("firmware", "-", BIN_FIRMWARE, firmwareFileName),
+  // BME180
+  COL("T_BMP", "C", BME180 ? BIN_F32 : BIN_BLANK, 0, BME180, T),
+  COL("P_BMP", "hPa", BME180 ? BIN_F32 : BIN_BLANK, 0, BME180, P),
+  // SHT25 - calibrated in calibrate_sample()
+#if CALIBRATE
+  COL("T", "C", SHT25 ? BIN_F32 : BIN_BLANK, BIN_FLAG_SHT, SHT25, cal_data.T_),
+  COL("RH", "%", SHT25 ? BIN_F32 : BIN_BLANK, BIN_FLAG_SHT, SHT25, cal_data.RH_),
+#else
+  COL("T", "C", SHT25 ? BIN_F32 : BIN_BLANK, BIN_FLAG_SHT, SHT25, temperature_SHT25),
+  COL("RH", "%", SHT25 ? BIN_F32 : BIN_BLANK, BIN_FLAG_SHT, SHT25, humidity_SHT25),
+#endif  //CALIBRATE
+  // ADS1115 - Figaro VOCs (right slot 2600, left slot 2602), e2V ozone & CO
+#if CALIBRATE
+  COL("TVOC", "ppm", BIN_INT, BIN_FLAG_SHT, true, cal_data.TVOC_),  //T & RH compensated
+#else
+  COL_BLANK("TVOC", "ppm"),
+#endif  //CALIBRATE
+  COL("Fig1", "raw", BIN_U16, 0, true, ads_data.Fig1),
+  COL("Fig2", "raw", BIN_U16, 0, true, ads_data.Fig2),
+  COL("e2V", "raw", MISC2611 ? BIN_U16 : BIN_BLANK, 0, MISC2611, ads_data.e2V),
+#if CALIBRATE
+  COL("CO", "ppm", BIN_INT_F, BIN_FLAG_SHT, true, cal_data.CO_),  //RH compensated
+#else
+  COL_BLANK("CO", "ppm"),
+#endif  //CALIBRATE
+  COL("CO_ch1", "raw", BIN_U16, 0, true, ads_data.CO_ch1),
+  COL("CO_ch2", "raw", BIN_U16, 0, true, ads_data.CO_ch2),
+  // S300
+#if CALIBRATE
+  COL("CO2", "ppm", BIN_INT, BIN_FLAG_CAL_CO2, true, cal_data.CO2_),
+#else
+  COL("CO2", "ppm", BIN_F32, BIN_FLAG_CO2, true, CO2),
+#endif  //CALIBRATE
+  // PMS5003 - atmospheric PM
+#if PMS_ENABLED
+  COL("PM1", "ug/m3", BIN_U16, BIN_FLAG_PM, true, pms_data.pm10_env),
+  COL("PM2.5", "ug/m3", BIN_U16, BIN_FLAG_PM, true, pms_data.pm25_env),
+  COL("PM10", "ug/m3", BIN_U16, BIN_FLAG_PM, true, pms_data.pm100_env),
+#else
+  COL_BLANK("PM1", "ug/m3"),
+  COL_BLANK("PM2.5", "ug/m3"),
+  COL_BLANK("PM10", "ug/m3"),
+#endif  //PMS_ENABLED
+#if QUAD_ENABLED
+  // Quadstat - 16 bit conversions, so int16_t holds them
+  COL("a1C1", "raw", BIN_I16, BIN_FLAG_QUAD, true, qs_data.a1C1),
+  COL("a1C2", "raw", BIN_I16, BIN_FLAG_QUAD, true, qs_data.a1C2),
+  COL("a2C1", "raw", BIN_I16, BIN_FLAG_QUAD, true, qs_data.a2C1),
+  COL("a2C2", "raw", BIN_I16, BIN_FLAG_QUAD, true, qs_data.a2C2),
+  COL("a3C1", "raw", BIN_I16, BIN_FLAG_QUAD, true, qs_data.a3C1),
+  COL("a3C2", "raw", BIN_I16, BIN_FLAG_QUAD, true, qs_data.a3C2),
+  COL("a4C1", "raw", BIN_I16, BIN_FLAG_QUAD, true, qs_data.a4C1),
+  COL("a4C2", "raw", BIN_I16, BIN_FLAG_QUAD, true, qs_data.a4C2),
+#endif  //QUAD_ENABLED
+#if ADS_OVERSAMPLE
+  COL_ADS_STATS("Fig1", FIG1),
+  COL_ADS_STATS("Fig2", FIG2),
+  COL_ADS_STATS("e2V", E2V),
+  COL_ADS_STATS("CO_ch1", CO_CH1),
+  COL_ADS_STATS("CO_ch2", CO_CH2),
+#endif  //ADS_OVERSAMPLE
+#if PMS_ENABLED && PMS_EXTENDED
+  // PM bins in pms_summary.h order, then the frame count
+#if INCLUDE_STANDARD
+  COL_PMS_BIN("PM1_cf", "ug/m3", 0),
+  COL_PMS_BIN("PM2.5_cf", "ug/m3", 1),
+  COL_PMS_BIN("PM10_cf", "ug/m3", 2),
+#endif  //INCLUDE_STANDARD
+  COL_PMS_BIN("PM1", "ug/m3", 3 * INCLUDE_STANDARD),
+  COL_PMS_BIN("PM2.5", "ug/m3", 3 * INCLUDE_STANDARD + 1),
+  COL_PMS_BIN("PM10", "ug/m3", 3 * INCLUDE_STANDARD + 2),
+#if INCLUDE_PARTICLES
+  COL_PMS_BIN("N0.3", "/dL", 3 * INCLUDE_STANDARD + 3),
+  COL_PMS_BIN("N0.5", "/dL", 3 * INCLUDE_STANDARD + 4),
+  COL_PMS_BIN("N1.0", "/dL", 3 * INCLUDE_STANDARD + 5),
+  COL_PMS_BIN("N2.5", "/dL", 3 * INCLUDE_STANDARD + 6),
+  COL_PMS_BIN("N5.0", "/dL", 3 * INCLUDE_STANDARD + 7),
+  COL_PMS_BIN("N10", "/dL", 3 * INCLUDE_STANDARD + 8),
+#endif  //INCLUDE_PARTICLES
+  COL("PM_frames", "", BIN_U16, 0, false, pms_stats.frames),
+#endif  //PMS_ENABLED && PMS_EXTENDED
+#if PMS_ENABLED && PMS_AGE_COLUMN
+  COL("PM_age", "ms", BIN_U32, BIN_FLAG_PM, false, pms_age),
+#endif  //PMS_ENABLED && PMS_AGE_COLUMN
+};
+constexpr uint8_t SCHEMA_COLUMNS = sizeof(columns) / sizeof(columns[0]);
+constexpr uint16_t SCHEMA_HEADER_LENGTH = schema_header_length(columns, SCHEMA_COLUMNS);
+static_assert(SCHEMA_COLUMNS <= BIN_MAX_COLUMNS, "more columns than BIN_MAX_COLUMNS");
+static_assert(schema_record_size(columns, SCHEMA_COLUMNS) <= BIN_RECORD_SIZE, "binary record over BIN_RECORD_SIZE");
+Schema schema(columns, SCHEMA_COLUMNS);
+
+void buildRecord(uint16_t flags);
+
+#if SD_ENABLED && LOG_BINARY
+/*  Binary Records - the SD file gets fixed-layout records (binlog.h), tools/ypod_bin2csv gives back the CSV  */
+#include "binlog.h"
+BinRecord binrecord;
+uint32_t log_base_time;  // midnight of the file's day; record times are s after it
+#endif  //SD_ENABLED && LOG_BINARY
+
+#if SD_ENABLED && AGGREGATE_ENABLED
+/*  Rolling Aggregation - 1-min, 15-min & hourly summaries of every summary column, each tier in its own file  */
+#include "aggregate.h"
+constexpr uint8_t AGG_CHANNELS = schema_summaries(columns, SCHEMA_COLUMNS);  //in column order
+Aggregator aggregator;
+agg_stats_t agg_stats[AGG_TIERS * AGG_CHANNELS];
+uint8_t agg_tier;  // the tier printSummary() writes
+#endif  //SD_ENABLED && AGGREGATE_ENABLED
+
+/*  Sensor Drivers - each sensor's begin & task in one place (its columns are in the schema); Sensors below lists them (see sensor_registry.h)  */
+#include "sensor_registry.h"
+
+//BME 180 - T, then P, each a timed conversion
+template <bool Fitted> struct Bmp180Sensor : NoSensor {};
+#if BME180
+uint8_t bmp_phase;      //0 = temperature conversion, 1 = pressure conversion
+uint32_t bmp_ready_at;  //millis() when the current conversion is done
+
+template <> struct Bmp180Sensor<true> : SensorDriver {
+  static const uint32_t PERIOD_MS = BME180_PERIOD_MS;
+  static const uint32_t TIMEOUT_MS = TASK_TIMEOUT_MS;
+  static const char *name() {
+    return "BME180";
+  }
+
+  static void begin() {
+    BMP.begin();  //Initialize BME 180 (creates objects in .cpp)
+  }
 
-void printOutput(Print &output, bool pm_returned, double T, double P, float temperature_SHT25, float humidity_SHT25, float CO2);
+  static bool start() {
+    T = -99;
+    P = -99;
+    char status = BMP.startTemperature();
+    if (status == 0) {
+      //if bad temp; then can't compute temp or pressure
+      return false;
+    }
+    bmp_phase = 0;
+    bmp_ready_at = millis() + status;
+    return true;
+  }
+
+  static bool poll() {
+    if ((int32_t)(millis() - bmp_ready_at) < 0) {
+      return false;
+    }
+    if (bmp_phase == 0) {
+      BMP.getTemperature(T);
+      char status = BMP.startPressure(3);
+      if (status == 0) {
+        //if good temp; but can't compute P
+        return true;
+      }
+      bmp_phase = 1;
+      bmp_ready_at = millis() + status;
+      return false;
+    }
+    if (BMP.getPressure(P, T) == 0) {
+      P = -99;
+    }
+    return true;
+  }
+
+  static void collect() {
+  }
+};  //struct Bmp180Sensor<true>
+#endif  //BME180
+
+//SHT 25 - no-hold T & RH, CRC checked
+template <bool Fitted> struct Sht25Sensor : NoSensor {};
+#if SHT25
+template <> struct Sht25Sensor<true> : SensorDriver {
+  static const uint32_t PERIOD_MS = SHT25_PERIOD_MS;
+  static const uint32_t TIMEOUT_MS = TASK_TIMEOUT_MS;
+  static const char *name() {
+    return "SHT25";
+  }
+
+  static bool start() {
+    sht_returned = false;
+    return sht_module.start_read();  //no hold: the bus stays free while it converts
+  }
+
+  static bool poll() {
+    return sht_module.read_done();  //T, then RH; done early on a NACK, bad CRC or timeout
+  }
+
+  // Only a clean pair replaces the last one, so calibration never sees a bad read
+  static void collect() {
+    sht_returned = sht_module.status() == SHT_OK;
+    if (sht_returned) {
+      sht_data sht = sht_module.return_last();
+      temperature_SHT25 = sht.temperature;
+      humidity_SHT25 = sht.humidity;
+    }
+  }
+};  //struct Sht25Sensor<true>
+#endif  //SHT25
+
+//ADS1115 pair - Figaro VOCs, e2V ozone & CO (with their calibrated columns)
+struct AdsSensor : SensorDriver {
+  static const uint32_t PERIOD_MS = ADS_PERIOD_MS;
+#if ADS_OVERSAMPLE && !SLEEP_ENABLED
+  static const uint32_t TIMEOUT_MS = RECORD_PERIOD_MS + TASK_TIMEOUT_MS;  //paced over the record window
+#else
+  static const uint32_t TIMEOUT_MS = TASK_TIMEOUT_MS;
+#endif  //ADS_OVERSAMPLE && !SLEEP_ENABLED
+  static const char *name() {
+    return "ADS";
+  }
+
+  static void begin() {
+    ads_module.begin();  //Initialize ads_module (creates objects in .cpp)
+#if ADS_OVERSAMPLE
+    ads_module.oversample(ADS_SAMPLES, ADS_DATA_RATE);
+#endif  //ADS_OVERSAMPLE
+  }
+
+  static bool start() {
+#if ADS_OVERSAMPLE && !SLEEP_ENABLED
+    ads_module.pace(window());  //ADS_SAMPLES rounds spread over the record, not one burst
+#endif  //ADS_OVERSAMPLE && !SLEEP_ENABLED
+    return ads_module.start_read();  //0x48 & 0x49 convert in parallel
+  }
+
+  static bool poll() {
+    return ads_module.read_done();  //moves each chip's mux on as its conversion lands
+  }
+
+  static void collect() {
+    ads_data = ads_module.return_last();  //rounded means when oversampling
+#if ADS_OVERSAMPLE
+    for (uint8_t i = 0; i < ADS_USER_COUNT; i++) {
+      ads_summary[i] = ads_module.return_summary((ads_sensor_id_e)i);
+    }
+#endif  //ADS_OVERSAMPLE
+  }
+
+#if ADS_OVERSAMPLE && !SLEEP_ENABLED
+  // RECORD_PERIOD_MS, or the last cycle (at most half a task timeout) when records run back to back
+  static uint32_t window() {
+    uint32_t last = scheduler.cycle_time();
+    return RECORD_PERIOD_MS ? RECORD_PERIOD_MS : (last < TASK_TIMEOUT_MS / 2 ? last : TASK_TIMEOUT_MS / 2);
+  }
+#endif  //ADS_OVERSAMPLE && !SLEEP_ENABLED
+};  //struct AdsSensor
+
+//ELT S300 - CO2
+struct S300Sensor : SensorDriver {
+  static const uint32_t PERIOD_MS = S300_PERIOD_MS;
+  static const uint32_t TIMEOUT_MS = TASK_TIMEOUT_MS;
+  static const char *name() {
+    return "S300";
+  }
+
+  static void begin() {
+    s300_module.begin();  //stays at S300_CLOCK_HZ
+  }
+
+  static bool start() {
+    co2_returned = false;
+    return s300_module.start_read();  //'R'; the reply is read S300_RESPONSE_MS later
+  }
+
+  static bool poll() {
+    return s300_module.read_done();  //retries a bad reply within S300_BUDGET_MS
+  }
+
+  static void collect() {
+    co2_returned = s300_module.status() == S300_OK;
+    if (co2_returned) {
+      CO2 = s300_module.return_last();
+    }
+  }
+};  //struct S300Sensor
+
+//PMS5003 - PM1, PM2.5 & PM10 (env), on its own SoftwareSerial
+template <bool Fitted> struct PmsSensor : NoSensor {};
+#if PMS_ENABLED
+template <> struct PmsSensor<true> : SensorDriver {
+  static const uint32_t PERIOD_MS = PMS_PERIOD_MS;
+  static const uint32_t TIMEOUT_MS = PMS::SINGLE_RESPONSE_TIME;
+  static const char *name() {
+    return "PMS";
+  }
+
+  static void begin() {
+    pmsSerial.begin(9600);
+    delay(100);
+#if PMS_EXTENDED
+    pms.activeMode();  //streams a frame every 0.2-2.3 s; poll() folds each one in
+    pms.onFrame(accumulate);
+#else
+    pms.passiveMode();
+#endif  //PMS_EXTENDED
+    delay(100);
+    pms.clearInput();
+  }
+
+  static void tick() {
+    PROF_START(PROF_PMS);
+    pms.poll();  //drains the PMS serial buffer every tick, frames land in its mailbox
+    PROF_STOP(PROF_PMS);
+  }
+
+#if PMS_EXTENDED
+  // Active mode: frames arrive on their own and never hold the record up; the
+  // PM columns get the newest frame since the last record, if there was one
+  static bool start() {
+    pm_returned = false;
+    return true;
+  }
+
+  static bool poll() {
+    return true;
+  }
+
+  static void collect() {
+    pm_returned = pms.take(pms_data, pms_time);
+    pms_stats = pms_summary.take();
+  }
+
+  static void accumulate(const PMS::DATA &data) {
+    pms_summary.add(data);
+  }
+#else
+  static bool start() {
+    pm_returned = false;
+    pms.discardInput();  //older frames never answer this request
+    pms.requestRead();
+    return true;
+  }
+
+  static bool poll() {
+    return pms.hasFrame();  //loop() feeds the parser, true once a valid frame is in
+  }
+
+  static void collect() {
+    pm_returned = pms.take(pms_data, pms_time);
+  }
+#endif  //PMS_EXTENDED
+};  //struct PmsSensor<true>
+#endif  //PMS_ENABLED
+
+//Quadstat - 4 Alphasense boards, 2 channels each
+template <bool Fitted> struct QuadSensor : NoSensor {};
+#if QUAD_ENABLED
+template <> struct QuadSensor<true> : SensorDriver {
+  static const uint32_t PERIOD_MS = QUAD_PERIOD_MS;
+  static const uint32_t TIMEOUT_MS = TASK_TIMEOUT_MS;
+  static const char *name() {
+    return "QUAD";
+  }
+
+  static void begin() {
+    quad_module.begin();  //Addresses both MCP342x & general call reset
+  }
+
+  static bool start() {
+    quad_returned = false;
+    return quad_module.start_read();  //general call: 0x69 & 0x6E convert together
+  }
+
+  static bool poll() {
+    return quad_module.read_done();  //ready bits once converted; next channel starts when both land
+  }
+
+  static void collect() {
+    quad_returned = quad_module.read_ok();  //a channel that did not start blanks them all
+    qs_data = quad_module.return_last();
+  }
+};  //struct QuadSensor<true>
+#endif  //QUAD_ENABLED
+
+// Fitted sensors from YPOD_node.h, in the order their tasks start in
+typedef SensorList<Bmp180Sensor<BME180>, Sht25Sensor<SHT25>, AdsSensor, S300Sensor,
+                   PmsSensor<PMS_ENABLED>, QuadSensor<QUAD_ENABLED> >
+  Sensors;
 
 /***************************************************************************************/
 void setup() {
@@ -82,13 +553,6 @@ void setup() {
 #if SERIAL_ENABLED
   Serial.begin(9600);
 #endif  //SERIAL_ENABLED
-#if PMS_ENABLED
-  pmsSerial.begin(9600);
-  delay(100);
-  pms.passiveMode();
-  delay(100);
-  pms.clearInput();
-#endif  //PMS_ENABLED
   const char *sketchName = __FILE__;
   const char *slash = strrchr(__FILE__, '/');
   const char *backslash = strrchr(__FILE__, '\\');
@@ -107,334 +571,508 @@ void setup() {
   }
 
   //Central Firmware (comms protocols)
-  Wire.begin();
+  i2c_bus.begin();  //Wire, after freeing SDA if a sensor reset mid-byte
   SPI.begin();
   //Object Begins
-  RTC.begin();  //Initialize RTC
+  uint32_t rtc_started = micros();
+  bool rtc_found = RTC.begin();  //Initialize RTC
 #if RTC_UPDATE
   RTC.adjust(DateTime(F(__DATE__), F(__TIME__)));
 #endif                 //RTC_UPDATE
-  ads_module.begin();  //Initialize ads_module (creates objects in .cpp)
-#if BME180
-  BMP.begin();  //Initialize BME 180 (creates objects in .cpp)
-#endif          //BME180
+  RTC.writeSqwPinMode(DS3231_SquareWave1Hz);
+  i2c_bus.measured(RTC_ADDR, rtc_started, rtc_found);  //RTClib drives Wire itself: timed around its calls
+  rtc_clock.begin(rtcUnixtime, RTC_SQW_PIN);  //one RTC read; ~1 s wait for the first SQW edge
+#if SLEEP_ENABLED
+  duty.begin(&RTC, RTC_SQW_PIN, SLEEP_PERIOD_S);
+#endif  //SLEEP_ENABLED
+  Sensors::begin();  //every fitted sensor (PMS serial & mode, ADS, quadstat, BME180, S300)
+  i2c_bus.set_clock(I2C_CLOCK_HZ);  //after the libraries' begin()s, which reset it
   //Initialize Pins - Establish direction of pin comms
   pinMode(G_LED, OUTPUT);
 
 #if SD_ENABLED
-  pinMode(SD_CS, OUTPUT);
   /*  SD Card & File Setup  */
-  digitalWrite(SD_CS, LOW);  //Pull SD_CS pin LOW to initialize SPI comms
-  sd.begin(SD_CS);           //Initialize SD Card with relevant chip select pin
-  // Establish contact with SD card - if initialization fails, run until success
-  while (!sd.begin(SD_CS)) {
+  //File Naming (FORMATTING HAS TO BE CONSISTENT WITH GLOBAL DECLARATION!!)
+  DateTime now(rtc_clock.unixtime());  //pulls setup() time so we have one file name per run in a day
+  // sprintf(ypodID, "YPOD%02X", YPODID);                                  //char array for podID
+#if LOG_BINARY
+  schema.encode(binrecord, 0, 0);  //first record fixes the file header's column list
+#endif  //LOG_BINARY
+  nameLogFile(now);
+  // Establish contact with SD card once - if initialization fails, run until success
+  while (!logger.begin(SD_CS, fileName, printLogHeader)) {  //card init + file open (stays open), header if new
 #if SERIAL_ENABLED
     Serial.println("insert sd card to begin");
 #endif                        //SERIAL_ENABLED
-    sd.begin(SD_CS);          //attempt to initialize again
-  }                           //while(!sd.begin(SD_CS))
+  }                           //while(!logger.begin(SD_CS, fileName))
   digitalWrite(G_LED, HIGH);  //if we exit the while loop, blink green LED once to indicate success
-  //File Naming (FORMATTING HAS TO BE CONSISTENT WITH GLOBAL DECLARATION!!)
-  DateTime now = RTC.now();  //pulls setup() time so we have one file name per run in a day
-  Y = now.year();
-  M = now.month();
-  D = now.day();
-  // sprintf(ypodID, "YPOD%02X", YPODID);                                  //char array for podID
-  sprintf(fileName, "%s_%04u_%02u_%02u.CSV", ypodID, Y, M, D);  //char array for fileName
-  delay(100);
-  file.open(fileName, O_CREAT | O_APPEND | O_WRITE);  //open with create, append, write permissions
-  file.close();                                       //close file, we opened so loop() is faster
-  digitalWrite(SD_CS, HIGH);                          //release chip select on SD - allow other comm with SPI
-  #else 
-  DateTime now = RTC.now();
+#if CALIBRATE && CAL_FILE_ENABLED
+  loadCalibration();
+#endif  //CALIBRATE && CAL_FILE_ENABLED
+#if AGGREGATE_ENABLED
+  aggregator.begin(agg_stats, AGG_CHANNELS);
+#endif  //AGGREGATE_ENABLED
   #endif //SD_ENABLED
   digitalWrite(G_LED, LOW);                           //turn off green LED (file is closed)
+
+  /*  Sampling Tasks - each sensor converts on its own period  */
+  scheduler.set_record_period(RECORD_PERIOD_MS);
+  Sensors::add_tasks(scheduler);
 }  //void setup()
 
 void loop() {
-  digitalWrite(G_LED, LOW);
-  bool pm_returned = false;
-  double T = -99;
-  double P = -99;
-  float temperature_SHT25 = 0;
-  float humidity_SHT25 = 0;
-
-#if PMS_ENABLED
-  pms.clearInput();
-  pms.requestRead();
-  if (pms.readUntil(pms_data)) {
-    pm_returned = true;
-  } else {
-    pm_returned = false;
-  }  //if (pms.readUntil(pms_data))
-  delay(100);
-#endif
-
-#if QUAD_ENABLED
-  qs_data = quad_module.return_data();
-#endif
-
-#if SHT25
-  const byte temp_command = B11100011;
-  const byte hum_command = B11100101;
-  temperature_board = read_wire(temp_command);
-  humidity_board = read_wire(hum_command);
-  humidity_SHT25 = ((125 * (float)humidity_board) / (65536)) - 6.00;
-  temperature_SHT25 = ((175.72 * (float)temperature_board) / (65536)) - 46.85;
-  delay(100);
-#endif  //SHT25
+  PROF_START(PROF_LOOP);
+  rtc_clock.poll();  //counts SQW edges when the pin has no interrupt
+  Sensors::tick();  //the PMS drains its serial buffer every tick
+  scheduler.run();  //never blocks; starts, polls & collects each sensor task
+  i2c_bus.run();    //the transfers those tasks queued, back to back
 
-#if BME180
-  //Get BMP data
-  char status;
-  status = BMP.startTemperature();
-  if (status != 0) {
-    //Serial.println(status);
-    delay(status);
-    status = BMP.getTemperature(T);
-    status = BMP.startPressure(3);
-    if (status != 0) {
-      delay(status);
-      status = BMP.getPressure(P, T);
-    } else {
-      //if good temp; but can't compute P
-      P = -99;
-    }  //if (status != 0)
-  } else {
-    //if bad temp; then can't compute temp or pressure
-    T = -99;
-    P = -99;
-  }  //if (status != 0) outer loop?
-  delay(100);
-#endif  //BME180
+  bool recorded = scheduler.record_ready();
+  if (recorded) {
+    writeRecord();
+    scheduler.record_done();
+  }  //if (recorded)
+#if SERIAL_ENABLED
+  echoRecord();  //as much of the line as the TX buffer has room for
+#endif  //SERIAL_ENABLED
+#if SD_ENABLED
+  if (!recorded) {
+    runLogger();  //the rest of a midnight roll, a bounded step per pass that wrote no record
+  }
+#endif  //SD_ENABLED
+  PROF_STOP(PROF_LOOP);
 
-  float CO2 = getS300CO2();
-  delay(100);
+#if PROFILE_ENABLED
+  if ((prof_line != PROF_LINE_IDLE || profiler.due()) && serialIdle()) {
+    writeProfile();  //one line per pass, so the report never holds a record up; not timed itself
+  }
+#endif  //PROFILE_ENABLED
+#if SLEEP_ENABLED
+  if (recorded) {
+    sleepUntilNextSlot();  //the burst is done; power-down is not loop time
+  }
+#endif  //SLEEP_ENABLED
+}  //void loop()
 
-  ads_data = ads_module.return_updated();
+#if CALIBRATE
+/*  Runs every enabled calibration equation once for the acquisition about to be recorded  */
+// SHT25 T & RH and S300 CO2 are the last valid readings; a calibrated column whose input failed this cycle is blank (recordFlags())
+void calibrate_sample() {
+  cal_data = cal.calibrate(ads_data.CO_ch1, CO2, humidity_SHT25, temperature_SHT25, ads_data.Fig1, ads_data.Fig2);
+}
 
-  //open SPI SD
-  #if SD_ENABLED
-  digitalWrite(SD_CS, LOW);
+#if SD_ENABLED && CAL_FILE_ENABLED
+/*  This pod's line of CAL.CSV replaces its compiled coefficients; no file, no line or a bad line keeps them  */
+void loadCalibration() {
+  CalReader reader(calID_letter, calID_number);
+  if (logger.read_file(CAL_FILE_NAME, reader) && reader.end() && cal.set(reader.row())) {
+#if SERIAL_ENABLED
+    Serial.println("calibration from " CAL_FILE_NAME);
+#endif  //SERIAL_ENABLED
+  }
+}  //void loadCalibration()
+#endif  //SD_ENABLED && CAL_FILE_ENABLED
+#endif  //CALIBRATE
 
-  while (!sd.begin(SD_CS)) {
+void writeRecord() {
 #if SERIAL_ENABLED
-    Serial.println("error in loop");
+  finishEcho();  //record is about to be rebuilt
 #endif  //SERIAL_ENABLED
-    sd.begin(SD_CS);
+  PROF_START(PROF_RECORD);
+  rtc_clock.update();  //seconds counted from the SQW; text only changes where the digits do
+#if SD_ENABLED
+  uint32_t now = rtc_clock.unixtime();
+  if (now / 86400 != log_day) {
+    rollLogFile(DateTime(now));  //midnight: this record opens the new day's file
   }
-  #endif //SD_ENABLED
+#endif  //SD_ENABLED
+#if CALIBRATE
+  calibrate_sample();
+#endif  //CALIBRATE
+#if PMS_ENABLED && PMS_AGE_COLUMN
+  pms_age = millis() - pms_time;
+#endif  //PMS_ENABLED && PMS_AGE_COLUMN
+  uint16_t flags = recordFlags();
+#if !(SD_ENABLED && LOG_BINARY) || SERIAL_ENABLED
+  buildRecord(flags);
+#endif
+#if SD_ENABLED && LOG_BINARY
+  schema.encode(binrecord, flags, now - log_base_time);  //same columns as binary fields: no text formatting
+#endif  //SD_ENABLED && LOG_BINARY
+  PROF_STOP(PROF_RECORD);
 
-  DateTime now = RTC.now();
-  Y = now.year();
-  M = now.month();
-  D = now.day();
-  h = now.hour();
-  m = now.minute();
-  s = now.second();
-  delay(100);
-  sprintf(bufftime, "%04u-%02u-%02uT%02u:%02u:%02u", Y, M, D, h, m, s);
   #if SD_ENABLED
-  if (sd.begin(SD_CS)) {
-    // FILE FORMAT = RETIGO
-    // delay(100);
-    file.open(fileName, O_CREAT | O_APPEND | O_WRITE);
-    delay(100);
-    if (file.isOpen()) {
-      digitalWrite(G_LED, HIGH);
-      printOutput(file, pm_returned, T, P, temperature_SHT25, humidity_SHT25, CO2);
-      delay(100);
-      file.sync();
-      file.close();
-      // delay(100);
-    } else {
-      Serial.println("file not opening?");
-      file.close();
-    }
-  }  //if (sd.begin())
-
-  digitalWrite(SD_CS, HIGH);
+  // FILE FORMAT = RETIGO - assembled in SdFat's sector cache, card sees whole sectors & periodic syncs
+  PROF_START(PROF_SD);
+  digitalWrite(G_LED, HIGH);
+#if LOG_BINARY
+  if (!logger.append((const char *)binrecord.data(), binrecord.length())) {
+#else
+  if (!logger.append(record.c_str(), record.length())) {
+#endif  //LOG_BINARY
+#if SERIAL_ENABLED
+    Serial.println("error in loop");
+#endif  //SERIAL_ENABLED
+  }  //if (!logger.append(...))
+#if AGGREGATE_ENABLED
+  aggregateRecord(now, flags);  //a finished window costs one short append to its tier's file
+#endif  //AGGREGATE_ENABLED
   digitalWrite(G_LED, LOW);
+  PROF_STOP(PROF_SD);
   #endif //SD_ENABLED
 
-  //NOW ECHO TO SERIAL
-  now = RTC.now();
+  //NOW ECHO TO SERIAL - loop() hands the line over as the UART sends it
 #if SERIAL_ENABLED
-  printOutput(Serial, pm_returned, T, P, temperature_SHT25, humidity_SHT25, CO2);
-  Serial.flush();
+  echo_left = record.length();
+  echoRecord();
 #endif  //SERIAL_ENABLED
-}
+}  //void writeRecord()
 
-void printOutput(Print &output, bool pm_returned, double T, double P, float temperature_SHT25, float humidity_SHT25, float CO2) {
-  // RTC, GPS blanks, YPOD ID, and firmware version
-  output.print(bufftime);
-  delay(100);
-  output.print(",");
-  
-  output.print(",");  //GPS EAST_LONGITUDE
-  output.print(",");  //GPS NORTH_LATITUDE
-
-  output.print(ypodID);
-  output.print(",");
-  output.print(firmwareFileName);
-  output.print(",");
-  delay(100);
+#if SERIAL_ENABLED
+/*  Writes only what fits in Serial's TX buffer: at 9600 baud a whole line would block loop() for ~150 ms  */
+void echoRecord() {
+  if (!echo_left) {
+    return;
+  }
+  int room = Serial.availableForWrite();
+  if (room > 0) {
+    PROF_START(PROF_SERIAL);
+    uint16_t n = (uint16_t)room < echo_left ? (uint16_t)room : echo_left;
+    Serial.write(record.c_str() + record.length() - echo_left, n);
+    echo_left -= n;
+    PROF_STOP(PROF_SERIAL);
+  }
+}  //void echoRecord()
 
-#if BME180
-  output.print(T);
-  output.print(",");
-  output.print(P);
-  output.print(",");
-  delay(100);
-#else
-  output.print(",");
-  output.print(",");
-  delay(100);
-#endif  //BME180
+/*  Blocks until the rest of the line is in the TX buffer: before record is reused or Serial gets another line  */
+void finishEcho() {
+  Serial.write(record.c_str() + record.length() - echo_left, echo_left);
+  echo_left = 0;
+}  //void finishEcho()
+#endif  //SERIAL_ENABLED
 
-#if SHT25
-// Temperature
-#if CALIBRATE                                                                                                                 // Calls calibration eqn for temperature
-  float tempt = cal.calibrate(ads_data.CO_ch1, CO2, humidity_SHT25, temperature_SHT25, ads_data.Fig1, ads_data.Fig2).T_;  // Temp variable to store object
-  output.print(tempt);
-#else
-  output.print(temperature_SHT25);  // Default - no calibration
-#endif
-  delay(100);
-  output.print(",");
-// Relative humidity
-#if CALIBRATE                                                                                                                   // Calls calibration eqn for relative humidity
-  float temprh = cal.calibrate(ads_data.CO_ch1, CO2, humidity_SHT25, temperature_SHT25, ads_data.Fig1, ads_data.Fig2).RH_;  // Temp varibale to store object
-  output.print(temprh);
+/*  True once Serial has sent everything: a diagnostic line then goes into the TX buffer without waiting  */
+bool serialIdle() {
+#if SERIAL_ENABLED
+  return !echo_left && Serial.availableForWrite() >= SERIAL_TX_BUFFER_SIZE - 1;
 #else
-  output.print(humidity_SHT25);     // Default - no calibration
-#endif
-  delay(100);
-  output.print(",");
+  return true;
+#endif  //SERIAL_ENABLED
+}  //bool serialIdle()
+
+#if SD_ENABLED
+/*  fileName (and with LOG_BINARY the base time) for the day of `now`  */
+void nameLogFile(const DateTime &now) {
+  log_day = now.unixtime() / 86400;
+#if LOG_BINARY
+  snprintf(fileName, sizeof(fileName), "%s_%04u_%02u_%02u.BIN", ypodID, (unsigned int)now.year(), (unsigned int)now.month(), (unsigned int)now.day());
+  log_base_time = log_day * 86400;  //midnight - same base for every reboot that day
 #else
-  output.print(",");
-  output.print(",");
-  delay(100);
-#endif  //SHT25
+  snprintf(fileName, sizeof(fileName), "%s_%04u_%02u_%02u.CSV", ypodID, (unsigned int)now.year(), (unsigned int)now.month(), (unsigned int)now.day());
+#endif  //LOG_BINARY
+}
 
-// Figs
-#if CALIBRATE                                                                                                                 // calls calibration eqn for voc
-  int tvoc = cal.calibrate(ads_data.CO_ch1, CO2, humidity_SHT25, temperature_SHT25, ads_data.Fig1, ads_data.Fig2).TVOC_;  // Temp varibale to store object
-  output.print(tvoc);
-#endif
-  output.print(",");
-  output.print(ads_data.Fig1);  //Right slot - 2600
-  output.print(",");
-  output.print(ads_data.Fig2);  //Left slot - 2602
-  output.print(",");
-  delay(100);
-
-// Ozone
-#if MISC2611  // Conditional for ozone sensor
-  output.print(ads_data.e2V);
-#endif
-  output.print(",");
-  delay(100);
+/*  What a new daily file starts with: the CSV header row, after the binary file header with LOG_BINARY  */
+void printLogHeader(Print &out, bool new_file) {
+  (void)new_file;
+#if LOG_BINARY
+  uint8_t header[BIN_HEADER_MAX];
+  out.write(header, binrecord.header(header, log_base_time, ypodID, firmwareFileName, SCHEMA_HEADER_LENGTH));
+#endif  //LOG_BINARY
+  schema.print_header(out);
+}
 
-// CO
-#if CALIBRATE                                                                                                                   // Calls calibraiton eqn for CO
-  float tempco = cal.calibrate(ads_data.CO_ch1, CO2, humidity_SHT25, temperature_SHT25, ads_data.Fig1, ads_data.Fig2).CO_;  // Temp variable to store object
-  output.print(tempco);
-#endif
-  output.print(",");
-  output.print(ads_data.CO_ch1);
-  output.print(",");  // Default - no calibration
-  output.print(ads_data.CO_ch2);
-  delay(100);
-  output.print(",");
-
-// CO2
-#if CALIBRATE                                                                                                                   // Calls calibration eqn for CO2
-  int tempco2 = cal.calibrate(ads_data.CO_ch1, CO2, humidity_SHT25, temperature_SHT25, ads_data.Fig1, ads_data.Fig2).CO2_;  // Temp variable to store object
-  output.print(tempco2);
-#else
-  output.print(CO2);  // Default - no calibration
-#endif
-  delay(100);
-  output.print(",");
+/*  Finishes the day's file (truncated to its data); loop() opens & erases the next over its following passes  */
+void rollLogFile(const DateTime &now) {
+  nameLogFile(now);
+
+  PROF_START(PROF_SD);
+  logger.roll(fileName, printLogHeader);
+  PROF_STOP(PROF_SD);
+}  //void rollLogFile(const DateTime &now)
+
+/*  One step of a midnight roll per pass: open & preallocate, then erase LOG_ERASE_SECTORS at a time  */
+void runLogger() {
+  if (!logger.busy()) {
+    return;
+  }
+  PROF_START(PROF_SD);
+  if (!logger.run()) {
+#if SERIAL_ENABLED
+    Serial.println("error opening new day file");
+#endif  //SERIAL_ENABLED
+  }  //if (!logger.run())
+  PROF_STOP(PROF_SD);
+}  //void runLogger()
+#endif  //SD_ENABLED
+
+#if SD_ENABLED && AGGREGATE_ENABLED
+/*  Writes a row for each window `now` has left (shortest tier first: closing one can end the next), then adds this record  */
+void aggregateRecord(uint32_t now, uint16_t flags) {
+  for (uint8_t t = 0; t < AGG_TIERS; t++) {
+    if (aggregator.ended(t, now)) {
+      writeSummary(t);
+      aggregator.close(t, now);
+    }
+  }
+
+  aggregator.record(now);
+  column_t c;
+  uint8_t channel = 0;
+  for (uint8_t i = 0; i < schema.count(); i++) {
+    schema.column(i, c);
+    if (!c.summary) {
+      continue;
+    }
+    if (Schema::present(c, flags)) {  //blank columns (e.g. no PM frame) are left out of the means
+      aggregator.add(channel, Schema::real(c));
+    }
+    channel++;
+  }
+}  //void aggregateRecord(uint32_t now, uint16_t flags)
+
+/*  Appends tier t's finished window to "YPODID_YYYY_MM_DD_<tier>.CSV", named for the day the window started  */
+void writeSummary(uint8_t t) {
+  static const char *const tier_names[AGG_TIERS] = { "1M", "15M", "1H" };
+  DateTime start(aggregator.window(t));
+  char name[LOG_NAME_SIZE];
+  snprintf(name, sizeof(name), "%s_%04u_%02u_%02u_%s.CSV", ypodID, start.year(), start.month(), start.day(), tier_names[t]);
+
+  agg_tier = t;
+  if (!logger.write_file(name, printSummary)) {
+#if SERIAL_ENABLED
+    Serial.println("error writing summary");
+#endif  //SERIAL_ENABLED
+  }  //if (!logger.write_file(...))
+}  //void writeSummary(uint8_t t)
+
+/*  One summary row: window start, YPOD ID, firmware, records, then mean, min, max & count per channel (blank if none)  */
+void printSummary(Print &out, bool new_file) {
+  if (new_file) {
+    out.print(F("window_start,ypod,firmware,records"));
+    column_t c;
+    for (uint8_t i = 0; i < schema.count(); i++) {
+      schema.column(i, c);
+      if (!c.summary) {
+        continue;
+      }
+      out.print(',');
+      out.print(c.name);
+      out.print(F("_mean,"));
+      out.print(c.name);
+      out.print(F("_min,"));
+      out.print(c.name);
+      out.print(F("_max,"));
+      out.print(c.name);
+      out.print(F("_n"));
+    }
+    out.print('\n');
+  }
+
+  SoftClock start;  //formats the window start like the record timestamps
+  start.set(aggregator.window(agg_tier));
+  out.print(start.text());
+  out.print(',');
+  out.print(ypodID);
+  out.print(',');
+  out.print(firmwareFileName);
+  out.print(',');
+  out.print(aggregator.records(agg_tier));
+
+  const agg_stats_t *stats = aggregator.stats(agg_tier);
+  for (uint8_t c = 0; c < AGG_CHANNELS; c++) {
+    out.print(',');
+    if (stats[c].count) {
+      out.print(stats[c].mean);
+      out.print(',');
+      out.print(stats[c].lo);
+      out.print(',');
+      out.print(stats[c].hi);
+      out.print(',');
+    } else {
+      out.print(F(",,,"));
+    }
+    out.print(stats[c].count);
+  }
+  out.print('\n');
+}  //void printSummary(Print &out, bool new_file)
+#endif  //SD_ENABLED && AGGREGATE_ENABLED
+
+#if SLEEP_ENABLED
+/*  Settles the SD file, Serial & PMS, then powers down until the next slot; the next loop() starts its burst  */
+void sleepUntilNextSlot() {
+  rtc_clock.update();
+  uint32_t slot = duty.next_slot(rtc_clock.unixtime());
+#if SD_ENABLED
+  logger.flush();  //nothing staged in RAM over the sleep: a power cut loses no records
+#endif  //SD_ENABLED
+#if SERIAL_ENABLED
+  finishEcho();
+  Serial.flush();  //the UART stops with the clock
+#endif  //SERIAL_ENABLED
 
 #if PMS_ENABLED
-  if (pm_returned) {
-    output.print(pms_data.pm10_env);
-    output.print(F(","));
-    output.print(pms_data.pm25_env);
-    output.print(F(","));
-    output.print(pms_data.pm100_env);
-    output.print(F(","));
-  } else {
-    output.print(F(",,,"));
-  }  //if(pm_returned)
+  if (SLEEP_PMS_WARMUP_S < SLEEP_PERIOD_S) {
+    pms.sleep();  //fan & laser off
+    pmsSerial.stopListening();  //no RX interrupts from the PMS line while asleep
+    if (duty.sleep_until(slot - SLEEP_PMS_WARMUP_S)) {
+      rtc_clock.restart(slot - SLEEP_PMS_WARMUP_S);
+    }
+    pms.wakeUp();  //fan spins up for SLEEP_PMS_WARMUP_S before the sample
+    pmsSerial.listen();
+  }
+#endif  //PMS_ENABLED
+  if (duty.sleep_until(slot)) {
+    rtc_clock.restart(slot);  //woken by the alarm: the slot's second has just begun
+  }
+#if PMS_ENABLED
+#if PMS_EXTENDED
+  pms.activeMode();  //keeps streaming frames into the summary
 #else
-  output.print(F(",,,"));
+  pms.passiveMode();  //the sensor may wake up in active mode
+#endif  //PMS_EXTENDED
 #endif  //PMS_ENABLED
-#if QUAD_ENABLED
-  output.print(qs_data.a1C1);
-  output.print(",");
-  output.print(qs_data.a1C2);
-  output.print(",");
-  output.print(qs_data.a2C1);
-  output.print(",");
-  output.print(qs_data.a2C2);
-  output.print(",");
-  output.print(qs_data.a3C1);
-  output.print(",");
-  output.print(qs_data.a3C2);
-  output.print(",");
-  output.print(qs_data.a4C1);
-  output.print(",");
-  output.print(qs_data.a4C2);
-  output.print(",");
-#endif
-  output.print("\n");
-}
+}  //void sleepUntilNextSlot()
+#endif  //SLEEP_ENABLED
 
-float getS300CO2() {
-  int i = 1;
-  long reading;
-  //float CO2val;
-  wire_setup(0x31, 0x52, 7);
-
-  while (Wire.available()) {
-    byte val = Wire.read();
-    if (i == 2) {
-      reading = val;
-      reading = reading << 8;
-    }
-    if (i == 3) {
-      reading = reading | val;
+#if PROFILE_ENABLED
+/*  The next "#PROF,time,stage,count,total,p50,p95,max" line (us) of a stage with samples, then "#I2C" lines; the last starts a new window  */
+void writeProfile() {
+  static const char *const stage_names[PROF_TASK] = { "LOOP", "PMS_DRAIN", "RECORD", "SD", "SERIAL" };
+  static const char hex[] = "0123456789ABCDEF";
+#if SERIAL_ENABLED
+  finishEcho();  //the report reuses record
+#endif  //SERIAL_ENABLED
+  if (prof_line == PROF_LINE_IDLE) {
+    prof_line = 0;
+  }
+
+  for (; prof_line < PROF_LINE_I2C; prof_line++) {
+    uint8_t i = prof_line;
+    if (profiler.samples(i) == 0) {
+      continue;
     }
-    i = i + 1;
+    record.clear();
+    record.add("#PROF,");
+    record.add(rtc_clock.text());
+    record.sep();
+    record.add(i < PROF_TASK ? stage_names[i] : scheduler.task(i - PROF_TASK)->name);
+    record.sep();
+    record.add_uint(profiler.samples(i));
+    record.sep();
+    record.add_uint(profiler.total_us(i));
+    record.sep();
+    record.add_uint(profiler.percentile(i, 50));
+    record.sep();
+    record.add_uint(profiler.percentile(i, 95));
+    record.sep();
+    record.add_uint(profiler.max_us(i));
+    record.end();
+    prof_line++;
+    writeDiagnostic();
+    return;
   }
 
-  //Shift Calculation to Atheros
-  //    CO2val = reading / 4095.0 * 5000.0;
-  //    CO2val = reading;
-  return reading;
-}
+  //then "#I2C,time,address,count,total,nacks,timeouts,max" (us) per address i2c_bus counted
+  for (; prof_line < PROF_LINE_CLEAR; prof_line++) {
+    uint8_t i = prof_line - PROF_LINE_I2C;
+    const i2c_stats_t *s = i < i2c_bus.device_count() ? i2c_bus.device(i) : NULL;
+    if (!s || s->count == 0) {
+      continue;
+    }
+    record.clear();
+    record.add("#I2C,");
+    record.add(rtc_clock.text());
+    record.add(",0x");
+    record.add(hex[s->addr >> 4]);
+    record.add(hex[s->addr & 0x0F]);
+    record.sep();
+    record.add_uint(s->count);
+    record.sep();
+    record.add_uint(s->total_us);
+    record.sep();
+    record.add_uint(s->nacks);
+    record.sep();
+    record.add_uint(s->timeouts);
+    record.sep();
+    record.add_uint(s->max_us);
+    record.end();
+    prof_line++;
+    writeDiagnostic();
+    return;
+  }
 
-void wire_setup(int address, byte cmd, int from) {
-  Wire.beginTransmission(address);
-  Wire.write(cmd);
-  Wire.endTransmission();
-  Wire.requestFrom(address, from);
-}
+  //and "#I2C,time,CLEAR,n" if the bus had to be freed (a library's transfer included)
+  if (prof_line == PROF_LINE_CLEAR && i2c_bus.recoveries()) {
+    record.clear();
+    record.add("#I2C,");
+    record.add(rtc_clock.text());
+    record.add(",CLEAR,");
+    record.add_uint(i2c_bus.recoveries());
+    record.end();
+    prof_line++;
+    writeDiagnostic();
+    return;
+  }
+  profiler.reset();
+  i2c_bus.reset_stats();
+  prof_line = PROF_LINE_IDLE;
+}  //void writeProfile()
 
-unsigned int read_wire(byte cmd) {
-  const int SHT2x_address = 64;
-  const byte mask = B11111100;
-  byte byte1, byte2, byte3;
+/*  The diagnostic line in record to the PROFILE_* outputs  */
+void writeDiagnostic() {
+#if SD_ENABLED && PROFILE_SD && !LOG_BINARY
+  logger.append(record.c_str(), record.length());
+#endif  //SD_ENABLED && PROFILE_SD && !LOG_BINARY
+#if SERIAL_ENABLED && PROFILE_SERIAL
+  echo_left = record.length();
+  echoRecord();
+#endif  //SERIAL_ENABLED && PROFILE_SERIAL
+}  //void writeDiagnostic()
+#endif  //PROFILE_ENABLED
 
-  wire_setup(SHT2x_address, cmd, 3);
+/*  Presence flags of this record's columns: which sensors had something this cycle  */
+uint16_t recordFlags() {
+  uint16_t flags = 0;
+  if (pm_returned) {
+    flags |= COL_FLAG(BIN_FLAG_PM);
+  }
+  if (sht_returned) {
+    flags |= COL_FLAG(BIN_FLAG_SHT);
+  }
+  if (co2_returned) {
+    flags |= COL_FLAG(BIN_FLAG_CO2);
+  }
+  if (quad_returned) {
+    flags |= COL_FLAG(BIN_FLAG_QUAD);
+  }
+  if (co2_returned && sht_returned) {
+    flags |= COL_FLAG(BIN_FLAG_CAL_CO2);
+  }
+#if ADS_OVERSAMPLE
+  for (uint8_t i = 0; i < ADS_USER_COUNT; i++) {
+    if (ads_summary[i].count) {
+      flags |= COL_FLAG(BIN_FLAG_ADS + i);
+    }
+  }
+#endif  //ADS_OVERSAMPLE
+#if PMS_ENABLED && PMS_EXTENDED
+  if (pms_stats.frames) {
+    flags |= COL_FLAG(BIN_FLAG_PMS_SUMMARY);
+  }
+#endif  //PMS_ENABLED && PMS_EXTENDED
+  return flags;
+}
 
-  byte1 = Wire.read();
-  byte2 = Wire.read();
-  byte3 = Wire.read();
+void buildRecord(uint16_t flags) {
+  record.clear();
+  schema.format(record, flags, rtc_clock.text());  //every column in the schema, blank where flags say so
+  record.end();
+}
 
-  //HUM_byte1 shifted left by 1 byte, (|) bitwise inclusize OR operator
-  return ((byte1 << 8) | (byte2)&mask);
+uint32_t rtcUnixtime() {
+  uint32_t started = micros();
+  uint32_t unixtime = RTC.now().unixtime();
+  i2c_bus.measured(RTC_ADDR, started, true);  //RTClib does not report a NACK here
+  return unixtime;
 }
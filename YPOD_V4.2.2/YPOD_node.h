@@ -15,30 +15,132 @@
 
 #include <Arduino.h>
 
+// Feature switches may be overridden with -D (e.g. the host simulation in test/sim)
+#ifndef CALIBRATE
 #define CALIBRATE    0 // Embedded calibration
+#endif
+#ifndef CAL_FIXED_POINT
+#define CAL_FIXED_POINT 0 // 1 = CO, CO2 & VOC in integer fixed point (cal_fixed.h) instead of float
+#endif
 
+#ifndef SERIAL_ENABLED
 #define SERIAL_ENABLED        1
+#endif
+#ifndef PMS_ENABLED
 #define PMS_ENABLED           1
+#endif
+#ifndef QUAD_ENABLED
 #define QUAD_ENABLED          0 
+#endif
+#ifndef SD_ENABLED
 #define SD_ENABLED            0
+#endif
 
 #define RTC_UPDATE            0 // IF you have to update RTC, please upload after with a 0
+// Software clock (soft_clock.h) - DS3231 read at boot, then counted on by its 1 Hz SQW output
+#define RTC_SQW_PIN           5     // DS3231 SQW/INT (pulled up); -1 (or no edges at boot) = RTC read every record
+#define RTC_RESYNC_MS         60000 // read the DS3231 back this often to catch missed edges
+
+// Duty-cycled sleep (duty_cycle.h) - one burst of sensor work per slot, MCU powered down in
+// between and woken by DS3231 alarm 1 on RTC_SQW_PIN. Slots replace RECORD_PERIOD_MS
+// (sensor periods then count awake time only)
+#ifndef SLEEP_ENABLED
+#define SLEEP_ENABLED         0
+#endif
+#define SLEEP_PERIOD_S        60    // slot spacing; divide 86400 to keep slots on the same clock times
+#define SLEEP_PMS_WARMUP_S    30    // PMS fan restarts this long before a slot (30 s to stable data);
+                                    // >= SLEEP_PERIOD_S keeps it running
 
 #define HEATERS_ENABLED       0
+#ifndef INCLUDE_STANDARD
 #define INCLUDE_STANDARD      0
+#endif
+#ifndef INCLUDE_PARTICLES
 #define INCLUDE_PARTICLES     0
+#endif
 
 #define BME180      0
 #define SHT25       1
 // #define BME680      0 //NOT WRITTEN
 #define MISC2611    1 // Ozone sensor
 
+// ADS1115 oversampling - N conversions per gas channel per record, logged as mean, std & count
+#ifndef ADS_OVERSAMPLE
+#define ADS_OVERSAMPLE        0
+#endif
+#define ADS_SAMPLES           16                   // per channel, in rounds paced over the record (~4 ms each on 0x49)
+#define ADS_DATA_RATE         RATE_ADS1115_860SPS  // Adafruit_ADS1X15.h
+
+// PMS5003 - append the logged frame's age (ms before the record timestamp) as the last column;
+// off by default, since it changes the RETIGO column layout
+#ifndef PMS_AGE_COLUMN
+#define PMS_AGE_COLUMN        0
+#endif
+// PM extended mode (pms_summary.h) - the PMS streams (active mode) and every frame between two
+// records is folded into per-bin means & maxima, logged as mean,max per bin then the frame
+// count (before the age column). Atmospheric PM always; + CF=1 PM with INCLUDE_STANDARD,
+// + the six particle counts with INCLUDE_PARTICLES
+#ifndef PMS_EXTENDED
+#define PMS_EXTENDED          0
+#endif
+#define PMS_SUMMARY_BINS      (3 * INCLUDE_STANDARD + 3 + 6 * INCLUDE_PARTICLES)
+
+// Loop profiling - micros() histograms per loop() stage & sensor task (~1 KB RAM),
+// reported as "#PROF" lines (count, total, p50, p95 & max in us) every PROFILE_PERIOD_MS
+#ifndef PROFILE_ENABLED
+#define PROFILE_ENABLED       0
+#endif
+#define PROFILE_PERIOD_MS     60000
+#define PROFILE_SERIAL        1     // report on Serial
+#define PROFILE_SD            0     // ...and/or in the daily log file, between records
+
 const int PM_RX = 2;
 const int PM_TX = 3;
 #define G_LED     10
 
 // SD Card Settings
 const int SD_CS = 4;
+#define LOG_RING_BUF_SIZE     32    // RAM staging for SD appends beyond one record (sd_logger.h)
+#define LOG_FLUSH_RECORDS     20    // sync the log file after this many records
+#define LOG_FLUSH_MS          60000 // ...or after this long, whichever is first
+#define LOG_PREALLOCATE       1     // reserve a contiguous full-day extent per daily file
+#define LOG_ERASE_SECTORS     1024  // ...erased this much per loop() pass after a midnight roll (512 KB, power of 2)
+#define LOG_EXPECTED_PERIOD_MS 1000 // record spacing used to size that extent when RECORD_PERIOD_MS = 0
+// Binary records (binlog.h) in "YPODID_YYYY_MM_DD.BIN" instead of CSV text; Serial still
+// gets the CSV line. tools/ypod_bin2csv converts a .BIN file back to the RETIGO CSV
+#ifndef LOG_BINARY
+#define LOG_BINARY            0
+#endif
+// Rolling aggregation (aggregate.h) - every record also feeds mean, min, max & count summaries
+// of each logged channel over 1-minute, 15-minute & hourly clock windows; one CSV row per window
+// in YPODID_YYYY_MM_DD_1M.CSV, _15M.CSV & _1H.CSV (needs SD_ENABLED; 14 B RAM per channel & tier)
+#ifndef AGGREGATE_ENABLED
+#define AGGREGATE_ENABLED     0
+#endif
+
+// I2C bus (i2c_bus.h) - 400 kHz is the AVR TWI's fastest; the S300 stays at S300_CLOCK_HZ
+#ifndef I2C_CLOCK_HZ
+#define I2C_CLOCK_HZ          400000
+#endif
+
+// Sampling Scheduler (ms) - a period of 0 samples that sensor every record
+#ifndef RECORD_PERIOD_MS
+#define RECORD_PERIOD_MS      0 // 0 = as fast as the slowest sensor allows
+#endif
+#define PMS_PERIOD_MS         0
+#define QUAD_PERIOD_MS        0
+#define SHT25_PERIOD_MS       0
+#define BME180_PERIOD_MS      0
+#define S300_PERIOD_MS        0
+#define ADS_PERIOD_MS         0
+#define TASK_TIMEOUT_MS       1000 // a started sensor task is dropped after this
+
+// Calibration coefficients from CAL_FILE_NAME on the SD card at boot (cal_file.h): this pod's
+// line replaces its cal_table.h row, which stays the fallback (needs CALIBRATE & SD_ENABLED;
+// ~150 B RAM for the row)
+#ifndef CAL_FILE_ENABLED
+#define CAL_FILE_ENABLED      0
+#endif
 
 const char ypodID[] = "YPODE8";
   const char calID_letter = ypodID[4]; // Letter for calID
@@ -11,6 +11,7 @@
 /**************************************************************************/
 
 #include "ads_module.h"
+#include "i2c_bus.h"
 
 ADS_Module::ADS_Module()
 {
@@ -39,7 +40,33 @@ ADS_Module::ADS_Module()
   ads_module[E2V].channel = 3;
 
   for (int i = 0; i < ADS_SENSOR_COUNT; i++)
+  {
     ads_module[i].status = false;
+    reading[i] = -999;
+  }
+
+  // Group the return_updated() sensors by chip so both chips convert at once
+  for (uint8_t c = 0; c < ADS_CHIP_COUNT; c++)
+  {
+    ads_chip[c].sensor = NULL;
+    ads_chip[c].count = 0;
+    ads_chip[c].next = 0;
+    ads_chip[c].round = 0;
+    ads_chip[c].busy = false;
+    ads_chip[c].waiting = false;
+  }
+  for (uint8_t i = 0; i < ADS_USER_COUNT; i++)
+  {
+    ads_chip_t *chip = &ads_chip[ads_module[i].addr == 0x48 ? 0 : 1];
+    if (chip->sensor == NULL)
+      chip->sensor = &ads_module[i];
+    chip->queue[chip->count++] = (ads_sensor_id_e)i;
+  }
+
+  samples = 1;
+  spacing = 0;
+  started = 0;
+  memset(stats, 0, sizeof(stats));
 } //ADS_Module()
 
 /**************************************************************************/
@@ -53,8 +80,21 @@ bool ADS_Module::begin()
 {
   for (int i = 0; i < ADS_SENSOR_COUNT; i++)
   {
+    uint32_t started = micros();
     if (ads_module[i].module.begin(ads_module[i].addr))
       ads_module[i].status = true;
+    i2c_bus.measured(ads_module[i].addr, started, ads_module[i].status);
+  }
+
+  // ALERT/RDY as a ready pin, as the library's startADCReading() sets it
+  for (uint8_t c = 0; c < ADS_CHIP_COUNT; c++)
+  {
+    ads_module_t *sensor = ads_chip[c].sensor;
+    if (sensor != NULL && sensor->status)
+    {
+      write_register(sensor->addr, ADS1X15_REG_POINTER_HITHRESH, 0x8000);
+      write_register(sensor->addr, ADS1X15_REG_POINTER_LOWTHRESH, 0x0000);
+    }
   }
 
   for (int i = 0; i < ADS_SENSOR_COUNT; i++)
@@ -80,7 +120,10 @@ uint16_t ADS_Module::read_raw(ads_sensor_id_e ads_sensor_id)
   if (!sensor->status)
     return -999;
 
-  return sensor->module.readADC_SingleEnded(sensor->channel);
+  uint32_t started = micros();
+  uint16_t value = sensor->module.readADC_SingleEnded(sensor->channel);
+  i2c_bus.measured(sensor->addr, started, true);  // the library reports no NACKs here
+  return value;
 } //uint16_t ADS_Module::read_raw(ads_sensor_id_e ads_sensor_id)
 
 /**************************************************************************/
@@ -91,17 +134,242 @@ uint16_t ADS_Module::read_raw(ads_sensor_id_e ads_sensor_id)
 /**************************************************************************/
 ads_noheaters ADS_Module::return_updated()
 {
-  ads_user.Fig1 = read_raw(FIG1);
-  delay(100);
-  ads_user.Fig2 = read_raw(FIG2);
-  delay(100);
-  ads_user.e2V = read_raw(E2V);
-  delay(100);
-  ads_user.CO_ch1 = read_raw(CO_CH1);
-  delay(100);
-  ads_user.CO_ch2 = read_raw(CO_CH2);
-  delay(100);
+  // Blocking wrapper around the pipelined read below
+  if (start_read())
+  {
+    while (!read_done())
+      ;
+  }
 
-  return ads_user;
+  return return_last();
 } //ads_noheaters ADS_Module::return_updated()
 
+/**************************************************************************/
+ /*!
+ *    @brief  Oversampling: each sensor is converted `samples` times per
+ *            cycle (round robin over the chip's channels) at `data_rate`
+ *        @param  samples   conversions per sensor per cycle (1 = off)
+ *        @param  data_rate RATE_ADS1115_xxSPS
+ */
+/**************************************************************************/
+void ADS_Module::oversample(uint8_t samples, uint16_t data_rate)
+{
+  this->samples = samples ? samples : 1;
+
+  for (int i = 0; i < ADS_SENSOR_COUNT; i++)
+    ads_module[i].module.setDataRate(data_rate);
+} //void ADS_Module::oversample(uint8_t samples, uint16_t data_rate)
+
+/**************************************************************************/
+ /*!
+ *    @brief  Spreads the next cycle's rounds evenly over `window` ms: round
+ *            r starts r * window / samples after start_read(), so the last
+ *            one lands one spacing before the window ends. 0 runs them back
+ *            to back
+ *        @param  window  ms the cycle may take (the record period)
+ */
+/**************************************************************************/
+void ADS_Module::pace(uint32_t window)
+{
+  spacing = window / samples;
+} //void ADS_Module::pace(uint32_t window)
+
+/**************************************************************************/
+ /*!
+ *    @brief  Starts the first single-shot conversion on each chip; both
+ *            chips then convert in parallel. Never blocks
+ *    @return False if neither chip answered begin()
+ */
+/**************************************************************************/
+bool ADS_Module::start_read()
+{
+  bool any = false;
+
+  started = millis();
+  for (uint8_t c = 0; c < ADS_CHIP_COUNT; c++)
+  {
+    ads_chip_t *chip = &ads_chip[c];
+    chip->next = 0;
+    chip->round = 0;
+    chip->waiting = false;
+    chip->busy = chip->sensor != NULL && chip->sensor->status;
+
+    if (chip->busy)
+    {
+      start_next(chip);
+      any = true;
+    }
+    else
+    {
+      for (uint8_t i = 0; i < chip->count; i++)
+        reading[chip->queue[i]] = -999;
+    }
+  }
+
+  memset(stats, 0, sizeof(stats));
+  return any;
+} //bool ADS_Module::start_read()
+
+/**************************************************************************/
+ /*!
+ *    @brief  Checks each chip's conversion; a finished one is stored and
+ *            the chip's mux moves straight on to its next channel. A chip
+ *            that finished a round waits for that round's pace() slot
+ *    @return True once every chip has finished its queue
+ */
+/**************************************************************************/
+bool ADS_Module::read_done()
+{
+  bool done = true;
+  uint16_t config;
+
+  for (uint8_t c = 0; c < ADS_CHIP_COUNT; c++)
+  {
+    ads_chip_t *chip = &ads_chip[c];
+    if (!chip->busy)
+      continue;
+
+    if (chip->waiting)
+    {
+      if (millis() - started >= chip->round * spacing)
+      {
+        chip->waiting = false;
+        start_next(chip);
+      }
+    }
+    else if (read_register(chip->sensor->addr, ADS1X15_REG_POINTER_CONFIG, config) &&
+             (config & ADS1X15_REG_CONFIG_OS_NOTBUSY))
+    {
+      uint16_t value;
+      if (read_register(chip->sensor->addr, ADS1X15_REG_POINTER_CONVERT, value))
+        add_sample(chip->queue[chip->next], (int16_t)value);
+      if (++chip->next == chip->count)
+      {
+        chip->next = 0;
+        chip->round++;
+        chip->waiting = millis() - started < chip->round * spacing;
+      }
+
+      if (chip->round >= samples)
+        chip->busy = false;
+      else if (!chip->waiting)
+        start_next(chip);
+    }
+
+    done = done && !chip->busy;
+  }
+
+  return done;
+} //bool ADS_Module::read_done()
+
+/**************************************************************************/
+ /*!
+ *    @brief  Results of the last start_read()/read_done() cycle; with
+ *            oversampling each value is the rounded mean
+ *    @return ads_noheaters structured dataset (w/o heaters)
+ */
+/**************************************************************************/
+ads_noheaters ADS_Module::return_last()
+{
+  for (uint8_t i = 0; i < ADS_USER_COUNT; i++)
+  {
+    if (stats[i].count == 0)
+      continue;
+
+    ads_summary_t summary = return_summary((ads_sensor_id_e)i);
+    reading[i] = (int16_t)(summary.mean + (summary.mean < 0 ? -0.5 : 0.5));
+  }
+
+  ads_user.Fig1 = reading[FIG1];
+  ads_user.Fig2 = reading[FIG2];
+  ads_user.e2V = reading[E2V];
+  ads_user.CO_ch1 = reading[CO_CH1];
+  ads_user.CO_ch2 = reading[CO_CH2];
+
+  return ads_user;
+} //ads_noheaters ADS_Module::return_last()
+
+/**************************************************************************/
+ /*!
+ *    @brief  Mean, sample standard deviation & count of the last cycle
+ *        @param  ads_sensor_id FIG1..CO_CH2
+ */
+/**************************************************************************/
+ads_summary_t ADS_Module::return_summary(ads_sensor_id_e ads_sensor_id)
+{
+  ads_summary_t summary = { 0, 0, 0 };
+  if (ads_sensor_id >= ADS_USER_COUNT || stats[ads_sensor_id].count == 0)
+    return summary;
+
+  ads_stats_t *s = &stats[ads_sensor_id];
+  float mean = (float)s->sum / s->count;
+
+  summary.count = s->count;
+  summary.mean = s->shift + mean;
+  if (s->count > 1)
+  {
+    // sum((x - shift)^2) - n * mean^2, all relative to the shift
+    float var = ((float)s->sumsq - mean * s->sum) / (s->count - 1);
+    summary.std = var > 0 ? sqrt(var) : 0;
+  }
+
+  return summary;
+} //ads_summary_t ADS_Module::return_summary(ads_sensor_id_e ads_sensor_id)
+
+/**************************************************************************/
+ /*!
+ *    @brief  Adds one conversion to its sensor's running sums
+ */
+/**************************************************************************/
+void ADS_Module::add_sample(ads_sensor_id_e ads_sensor_id, int16_t value)
+{
+  ads_stats_t *s = &stats[ads_sensor_id];
+
+  if (s->count == 0)
+    s->shift = value;
+
+  int32_t d = (int32_t)value - s->shift;
+  uint32_t a = d < 0 ? -d : d;   // |d| <= 65535, so a * a fits 32 bits
+
+  s->count++;
+  s->sum += d;
+  s->sumsq += (uint32_t)(a * a);
+} //void ADS_Module::add_sample(ads_sensor_id_e ads_sensor_id, int16_t value)
+
+/**************************************************************************/
+ /*!
+ *    @brief  Starts the chip's next single-shot conversion: the config word
+ *            the library's startADCReading() writes, without rewriting the
+ *            thresholds each time (begin() set them)
+ */
+/**************************************************************************/
+void ADS_Module::start_next(ads_chip_t *chip)
+{
+  ads_module_t *sensor = &ads_module[chip->queue[chip->next]];
+  uint16_t config = ADS1X15_REG_CONFIG_CQUE_1CONV | ADS1X15_REG_CONFIG_CLAT_NONLAT |
+                    ADS1X15_REG_CONFIG_CPOL_ACTVLOW | ADS1X15_REG_CONFIG_CMODE_TRAD |
+                    ADS1X15_REG_CONFIG_MODE_SINGLE | ADS1X15_REG_CONFIG_OS_SINGLE |
+                    chip->sensor->module.getGain() | chip->sensor->module.getDataRate() |
+                    MUX_BY_CHANNEL[sensor->channel];
+  write_register(chip->sensor->addr, ADS1X15_REG_POINTER_CONFIG, config);
+} //void ADS_Module::start_next(ads_chip_t *chip)
+
+/*! One 16-bit register write through i2c_bus (counted per address) */
+bool ADS_Module::write_register(uint8_t addr, uint8_t reg, uint16_t value)
+{
+  uint8_t tx[3] = { reg, (uint8_t)(value >> 8), (uint8_t)(value & 0xFF) };
+  i2c_txn_t txn = { addr, tx, 3, NULL, 0, 0, I2C_OK };
+  return i2c_bus.transfer(txn) == I2C_OK;
+} //bool ADS_Module::write_register(uint8_t addr, uint8_t reg, uint16_t value)
+
+/*! One 16-bit register read (pointer write, then 2 bytes) through i2c_bus */
+bool ADS_Module::read_register(uint8_t addr, uint8_t reg, uint16_t &value)
+{
+  uint8_t rx[2];
+  i2c_txn_t txn = { addr, &reg, 1, rx, 2, 0, I2C_OK };
+  if (i2c_bus.transfer(txn) != I2C_OK || txn.rx_got != 2)
+    return false;
+  value = ((uint16_t)rx[0] << 8) | rx[1];
+  return true;
+} //bool ADS_Module::read_register(uint8_t addr, uint8_t reg, uint16_t &value)
+
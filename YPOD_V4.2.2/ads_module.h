@@ -40,6 +40,39 @@ struct ads_module_t
     Adafruit_ADS1115 module;
 }; //struct ads_module_t
 
+#define ADS_CHIP_COUNT  2   // 0x48 (Figaros) & 0x49 (CO-B4, MiCS-2611)
+#define ADS_USER_COUNT  5   // FIG1..CO_CH2, the sensors in ads_noheaters
+
+/*! (per ADS1115 chip) channels read each cycle & position in that queue */
+struct ads_chip_t
+{
+    ads_module_t *sensor;           // ads_module[] entry owning this chip's addr
+    ads_sensor_id_e queue[4];       // sensors converted this cycle, in order
+    uint8_t count;
+    uint8_t next;                   // queue index of the conversion in flight
+    uint8_t round;                  // passes over the queue done this cycle
+    bool busy;
+    bool waiting;                   // between rounds, until its pace() slot
+};  //struct ads_chip_t
+
+/*! (per sensor) integer running sums over one cycle, shifted by the first
+ *  sample so the squares stay small; reduced to mean & std in return_last() */
+struct ads_stats_t
+{
+    int16_t shift;
+    uint16_t count;
+    int32_t sum;                    // sum of (x - shift)
+    uint64_t sumsq;                 // sum of (x - shift)^2
+};  //struct ads_stats_t
+
+/*! (per sensor) one cycle's oversampled result */
+struct ads_summary_t
+{
+    float mean;
+    float std;
+    uint16_t count;
+};  //struct ads_summary_t
+
 /*! ADS data structure (ALL DATA) as uint16_t */
 struct ads_heaters
 {
@@ -72,8 +105,26 @@ class ADS_Module {
     uint16_t read_raw(ads_sensor_id_e ads_sensor_id);
     ads_noheaters return_updated();
 
+    void oversample(uint8_t samples, uint16_t data_rate);
+    void pace(uint32_t window);
+    bool start_read();
+    bool read_done();
+    ads_noheaters return_last();
+    ads_summary_t return_summary(ads_sensor_id_e ads_sensor_id);
+
   private:
+    void start_next(ads_chip_t *chip);
+    void add_sample(ads_sensor_id_e ads_sensor_id, int16_t value);
+    bool write_register(uint8_t addr, uint8_t reg, uint16_t value);
+    bool read_register(uint8_t addr, uint8_t reg, uint16_t &value);
+
     ads_module_t ads_module[ADS_SENSOR_COUNT];
+    ads_chip_t ads_chip[ADS_CHIP_COUNT];
+    ads_stats_t stats[ADS_USER_COUNT];
+    uint8_t samples;                // conversions per sensor per cycle
+    uint32_t spacing;               // ms from one round's start to the next
+    uint32_t started;               // millis() at start_read()
+    uint16_t reading[ADS_SENSOR_COUNT];
     ads_heaters ads_alldata;
     ads_noheaters ads_user;
 };  //class ADS_Module
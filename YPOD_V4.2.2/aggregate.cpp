@@ -0,0 +1,156 @@
+/*******************************************************************************
+ * @file    aggregate.cpp
+ * @brief   Rolling 1-min / 15-min / hourly summaries (see aggregate.h)
+ *
+ * @author  Percy Smith, percy.smith@colorado.edu
+ * @date    October 17, 2026
+ * @log     Running means per tier; longer tiers merge shorter ones
+******************************************************************************/
+#include "aggregate.h"
+
+static const uint16_t tier_seconds[AGG_TIERS] = { 60, 900, 3600 };
+
+Aggregator::Aggregator()
+{
+  table = NULL;
+  channels = 0;
+  for (uint8_t t = 0; t < AGG_TIERS; t++)
+  {
+    start[t] = 0;
+    counts[t] = 0;
+  }
+} //Aggregator()
+
+/**************************************************************************/
+ /*!
+ *    @brief  Hands over the accumulators: stats[tier * channels + channel]
+ */
+/**************************************************************************/
+void Aggregator::begin(agg_stats_t *stats, uint8_t channels)
+{
+  table = stats;
+  this->channels = channels;
+  for (uint16_t i = 0; i < (uint16_t)AGG_TIERS * channels; i++)
+    table[i].count = 0;
+} //void Aggregator::begin(agg_stats_t *stats, uint8_t channels)
+
+/**************************************************************************/
+ /*!
+ *    @brief  True if the tier holds records from a window `now` is not in.
+ *            Check (and close) the tiers in order: closing one can fill the
+ *            next
+ */
+/**************************************************************************/
+bool Aggregator::ended(uint8_t tier, uint32_t now)
+{
+  return counts[tier] && now - now % tier_seconds[tier] != start[tier];
+} //bool Aggregator::ended(uint8_t tier, uint32_t now)
+
+/**************************************************************************/
+ /*!
+ *    @brief  Folds the tier's window into the next tier up and starts over
+ *            empty; call once its row has been written
+ */
+/**************************************************************************/
+void Aggregator::close(uint8_t tier, uint32_t now)
+{
+  agg_stats_t *from = table + (uint16_t)tier * channels;
+
+  if (tier + 1 < AGG_TIERS)
+  {
+    agg_stats_t *into = from + channels;
+    if (!counts[tier + 1])
+      start[tier + 1] = start[tier] - start[tier] % tier_seconds[tier + 1];
+    for (uint8_t c = 0; c < channels; c++)
+      merge(into[c], from[c]);
+    counts[tier + 1] += counts[tier];
+  }
+
+  for (uint8_t c = 0; c < channels; c++)
+    from[c].count = 0;
+  counts[tier] = 0;
+  start[tier] = now - now % tier_seconds[tier];
+} //void Aggregator::close(uint8_t tier, uint32_t now)
+
+/**************************************************************************/
+ /*!
+ *    @brief  Starts a record at `now` (after the ended tiers are closed);
+ *            its channels follow with add()
+ */
+/**************************************************************************/
+void Aggregator::record(uint32_t now)
+{
+  if (!counts[AGG_1MIN])
+    start[AGG_1MIN] = now - now % tier_seconds[AGG_1MIN];
+  counts[AGG_1MIN]++;
+} //void Aggregator::record(uint32_t now)
+
+/**************************************************************************/
+ /*!
+ *    @brief  One value into the shortest tier: Welford's running mean, so
+ *            no sum grows with the window
+ */
+/**************************************************************************/
+void Aggregator::add(uint8_t channel, float value)
+{
+  agg_stats_t &s = table[channel];
+
+  if (s.count == 0)
+  {
+    s.mean = s.lo = s.hi = value;
+    s.count = 1;
+    return;
+  }
+
+  s.count++;
+  s.mean += (value - s.mean) / s.count;
+  if (value < s.lo)
+    s.lo = value;
+  if (value > s.hi)
+    s.hi = value;
+} //void Aggregator::add(uint8_t channel, float value)
+
+uint32_t Aggregator::period(uint8_t tier)
+{
+  return tier_seconds[tier];
+} //uint32_t Aggregator::period(uint8_t tier)
+
+uint32_t Aggregator::window(uint8_t tier)
+{
+  return start[tier];
+} //uint32_t Aggregator::window(uint8_t tier)
+
+uint16_t Aggregator::records(uint8_t tier)
+{
+  return counts[tier];
+} //uint16_t Aggregator::records(uint8_t tier)
+
+const agg_stats_t *Aggregator::stats(uint8_t tier)
+{
+  return table + (uint16_t)tier * channels;
+} //const agg_stats_t *Aggregator::stats(uint8_t tier)
+
+/**************************************************************************/
+ /*!
+ *    @brief  Combines two windows' summaries (Chan et al.): the mean is the
+ *            count-weighted one, min & max the extremes of both
+ */
+/**************************************************************************/
+void Aggregator::merge(agg_stats_t &into, const agg_stats_t &from)
+{
+  if (from.count == 0)
+    return;
+  if (into.count == 0)
+  {
+    into = from;
+    return;
+  }
+
+  uint16_t n = into.count + from.count;
+  into.mean += (from.mean - into.mean) * from.count / n;
+  if (from.lo < into.lo)
+    into.lo = from.lo;
+  if (from.hi > into.hi)
+    into.hi = from.hi;
+  into.count = n;
+} //void Aggregator::merge(agg_stats_t &into, const agg_stats_t &from)
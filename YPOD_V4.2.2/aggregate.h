@@ -0,0 +1,65 @@
+/*******************************************************************************
+ * @file    aggregate.h
+ * @brief   Rolling aggregation (AGGREGATE_ENABLED): each record feeds
+ *          streaming mean, min, max & count accumulators per logged channel
+ *          for 1-minute, 15-minute and hourly windows on the clock. A window
+ *          ends at the first record past it; the sketch writes its row, then
+ *          close() merges it into the next tier up, so a record costs one
+ *          update however many tiers there are
+ *
+ * @cite    B. P. Welford, "Note on a Method for Calculating Corrected Sums of
+ *          Squares and Products", Technometrics 4(3), 1962 (running mean)
+ * @cite    Chan, Golub & LeVeque, "Updating Formulae and a Pairwise Algorithm
+ *          for Computing Sample Variances", 1979 (merging two summaries)
+ *
+ * @author  Percy Smith, percy.smith@colorado.edu
+ * @date    October 17, 2026
+ * @log     Rolling 1-min / 15-min / hourly summaries
+******************************************************************************/
+#ifndef _AGGREGATE_H
+#define _AGGREGATE_H
+
+#include <Arduino.h>
+
+/*! Index: summary tiers, shortest first; each period divides the next & a day */
+enum agg_tier_e
+{
+  AGG_1MIN = 0,
+  AGG_15MIN,
+  AGG_HOUR,
+  AGG_TIERS
+};  //enum agg_tier_e
+
+/*! (per channel & tier) one window's running summary */
+struct agg_stats_t
+{
+    float mean;
+    float lo;
+    float hi;
+    uint16_t count;                 // values added; mean, lo & hi unset if 0
+};  //struct agg_stats_t
+
+class Aggregator {
+  public:
+    Aggregator();
+    void begin(agg_stats_t *stats, uint8_t channels);
+    bool ended(uint8_t tier, uint32_t now);
+    void close(uint8_t tier, uint32_t now);
+    void record(uint32_t now);
+    void add(uint8_t channel, float value);
+
+    uint32_t period(uint8_t tier);
+    uint32_t window(uint8_t tier);
+    uint16_t records(uint8_t tier);
+    const agg_stats_t *stats(uint8_t tier);
+
+  private:
+    static void merge(agg_stats_t &into, const agg_stats_t &from);
+
+    agg_stats_t *table;             // AGG_TIERS rows of `channels`, sketch-owned
+    uint8_t channels;
+    uint32_t start[AGG_TIERS];      // window start (unixtime)
+    uint16_t counts[AGG_TIERS];     // records in the window
+};  //class Aggregator
+
+#endif  //_AGGREGATE_H
@@ -0,0 +1,210 @@
+/*******************************************************************************
+ * @file    binlog.cpp
+ * @brief   Binary record builder & file header (see binlog.h)
+ *
+ * @author  Percy Smith, percy.smith@colorado.edu
+ * @date    October 17, 2026
+ * @log     Record packing & the version 3 file header
+******************************************************************************/
+#include "binlog.h"
+
+BinRecord::BinRecord()
+{
+  columns = 0;
+  frozen = false;
+  clear();
+} //BinRecord()
+
+/**************************************************************************/
+ /*!
+ *    @brief  Starts a record: sync byte, then the (empty) flags
+ */
+/**************************************************************************/
+void BinRecord::clear()
+{
+  buf[0] = BIN_SYNC;
+  buf[1] = 0;
+  buf[2] = 0;
+  len = 3;
+  truncated = false;
+} //void BinRecord::clear()
+
+/**************************************************************************/
+ /*!
+ *    @brief  Marks the columns added with this flag (1..BIN_FLAGS) as present
+ */
+/**************************************************************************/
+void BinRecord::set_flag(uint8_t flag)
+{
+  if (flag > 0 && flag <= BIN_FLAGS)
+    buf[1 + (flag - 1) / 8] |= 1 << ((flag - 1) % 8);
+} //void BinRecord::set_flag(uint8_t flag)
+
+void BinRecord::blank()
+{
+  column(BIN_BLANK, 0, NULL, 0);
+} //void BinRecord::blank()
+
+/**************************************************************************/
+ /*!
+ *    @brief  Column printed from the header (BIN_POD_ID, BIN_FIRMWARE)
+ */
+/**************************************************************************/
+void BinRecord::add_text(uint8_t type)
+{
+  column(type, 0, NULL, 0);
+} //void BinRecord::add_text(uint8_t type)
+
+/**************************************************************************/
+ /*!
+ *    @brief  Timestamp as seconds after the header's base_time
+ */
+/**************************************************************************/
+void BinRecord::add_time(uint32_t offset)
+{
+  column(BIN_TIME, 0, &offset, sizeof(offset));
+} //void BinRecord::add_time(uint32_t offset)
+
+void BinRecord::add_u16(uint16_t value, uint8_t flag)
+{
+  column(BIN_U16, flag, &value, sizeof(value));
+} //void BinRecord::add_u16(uint16_t value, uint8_t flag)
+
+void BinRecord::add_i16(int16_t value, uint8_t flag)
+{
+  column(BIN_I16, flag, &value, sizeof(value));
+} //void BinRecord::add_i16(int16_t value, uint8_t flag)
+
+void BinRecord::add_u32(uint32_t value, uint8_t flag)
+{
+  column(BIN_U32, flag, &value, sizeof(value));
+} //void BinRecord::add_u32(uint32_t value, uint8_t flag)
+
+void BinRecord::add_i32(int32_t value, uint8_t flag)
+{
+  column(BIN_I32, flag, &value, sizeof(value));
+} //void BinRecord::add_i32(int32_t value, uint8_t flag)
+
+/**************************************************************************/
+ /*!
+ *    @brief  Float stored as is; the decoder does the text formatting
+ */
+/**************************************************************************/
+void BinRecord::add_f32(float value, uint8_t flag)
+{
+  column(BIN_F32, flag, &value, sizeof(value));
+} //void BinRecord::add_f32(float value, uint8_t flag)
+
+/**************************************************************************/
+ /*!
+ *    @brief  Integer the CSV prints with add_float() (e.g. calibrated CO)
+ */
+/**************************************************************************/
+void BinRecord::add_i16_f(int16_t value, uint8_t flag)
+{
+  column(BIN_I16_F, flag, &value, sizeof(value));
+} //void BinRecord::add_i16_f(int16_t value, uint8_t flag)
+
+void BinRecord::add_i32_f(int32_t value, uint8_t flag)
+{
+  column(BIN_I32_F, flag, &value, sizeof(value));
+} //void BinRecord::add_i32_f(int32_t value, uint8_t flag)
+
+/**************************************************************************/
+ /*!
+ *    @brief  `int` at its own width (16 bit on AVR), so the column holds
+ *            exactly what the sketch computed, overflow included
+ */
+/**************************************************************************/
+void BinRecord::add_int(int value, uint8_t flag)
+{
+  if (sizeof(value) == sizeof(int16_t))
+    add_i16(value, flag);
+  else
+    add_i32(value, flag);
+} //void BinRecord::add_int(int value, uint8_t flag)
+
+void BinRecord::add_int_f(int value, uint8_t flag)
+{
+  if (sizeof(value) == sizeof(int16_t))
+    add_i16_f(value, flag);
+  else
+    add_i32_f(value, flag);
+} //void BinRecord::add_int_f(int value, uint8_t flag)
+
+/**************************************************************************/
+ /*!
+ *    @brief  Finishes a record; the first one completes the schema
+ */
+/**************************************************************************/
+void BinRecord::end()
+{
+  frozen = true;
+} //void BinRecord::end()
+
+const uint8_t *BinRecord::data()
+{
+  return buf;
+} //const uint8_t *BinRecord::data()
+
+uint16_t BinRecord::length()
+{
+  return len;
+} //uint16_t BinRecord::length()
+
+bool BinRecord::overflow()
+{
+  return truncated;
+} //bool BinRecord::overflow()
+
+size_t BinRecord::write_to(Print &output)
+{
+  return output.write(buf, len);
+} //size_t BinRecord::write_to(Print &output)
+
+/**************************************************************************/
+ /*!
+ *    @brief  File header for this schema; build one record first
+ *        @param  out         BIN_HEADER_MAX bytes
+ *        @param  row_length  bytes of the CSV header row the caller writes
+ *                            right after this header (Schema::print_header())
+ *    @return Bytes put in out; the row is not included
+ */
+/**************************************************************************/
+uint16_t BinRecord::header(uint8_t *out, uint32_t base_time, const char *pod_id, const char *firmware,
+                           uint16_t row_length)
+{
+  binlog_header_t h;
+
+  memset(&h, 0, sizeof(h));
+  memcpy(h.magic, BIN_MAGIC, sizeof(h.magic));
+  h.version = BIN_VERSION;
+  h.columns = columns;
+  h.header_size = sizeof(h) + 2 * columns + row_length;
+  h.record_size = len;
+  h.base_time = base_time;
+  strncpy(h.pod_id, pod_id, sizeof(h.pod_id));
+  strncpy(h.firmware, firmware, sizeof(h.firmware));
+
+  memcpy(out, &h, sizeof(h));
+  memcpy(out + sizeof(h), schema, 2 * columns);
+  return sizeof(h) + 2 * columns;
+} //uint16_t BinRecord::header(...)
+
+void BinRecord::column(uint8_t type, uint8_t flag, const void *value, uint8_t size)
+{
+  if (!frozen && columns < BIN_MAX_COLUMNS)
+  {
+    schema[columns][0] = type;
+    schema[columns][1] = flag;
+    columns++;
+  }
+
+  if (len + size > sizeof(buf))
+  {
+    truncated = true;
+    return;
+  }
+  memcpy(buf + len, value, size);
+  len += size;
+} //void BinRecord::column(...)
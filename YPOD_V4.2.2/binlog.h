@@ -0,0 +1,118 @@
+/*******************************************************************************
+ * @file    binlog.h
+ * @brief   Compact binary log format (LOG_BINARY): a file header with pod ID,
+ *          firmware name, base timestamp and column schema, then one
+ *          fixed-size record per sample. tools/ypod_bin2csv turns a file
+ *          back into the RETIGO CSV the text mode writes
+ *
+ *          File (little-endian, packed):
+ *            binlog_header_t, columns x { uint8_t type, uint8_t flag },
+ *            the CSV header row text ("name(unit)," per column, '\n')
+ *            records: BIN_SYNC, uint16_t flags, then each column's value in
+ *            schema order (blank & header-text columns take no bytes)
+ *
+ *          A column with flag n > 0 is written but printed blank unless bit
+ *          n-1 of the record's flags is set (e.g. no PM frame this cycle).
+ *          Version 2 files had no header row, version 1 files also a
+ *          single flags byte
+ *
+ * @author  Percy Smith, percy.smith@colorado.edu
+ * @date    October 17, 2026
+ * @log     Binary record mode; version 3 carries the CSV header row
+******************************************************************************/
+#ifndef _BINLOG_H
+#define _BINLOG_H
+
+#include <Arduino.h>
+
+#include "YPOD_node.h"
+
+#define BIN_MAGIC             "YPDB"
+#define BIN_VERSION           3     // 2: no header row; 1: + one flags byte per record
+#define BIN_SYNC              0xA5  // first byte of every record; never reads as erased
+#define BIN_FLAGS             16    // per-record presence flags (uint16_t)
+#if PMS_ENABLED && PMS_EXTENDED
+// + mean & max per PM bin (u16 each) and the frame count
+#define BIN_MAX_COLUMNS       (48 + 2 * PMS_SUMMARY_BINS + 1)
+#define BIN_RECORD_SIZE       (128 + 4 * PMS_SUMMARY_BINS + 2)
+#else
+#define BIN_MAX_COLUMNS       48
+#define BIN_RECORD_SIZE       128   // every sensor on (BME180, quad, oversampling) is ~120
+#endif  //PMS_ENABLED && PMS_EXTENDED
+#define BIN_POD_ID_SIZE       8
+#define BIN_FIRMWARE_SIZE     32
+
+/*! Index: column types; each prints as its RETIGO CSV field */
+enum bin_col_e
+{
+  BIN_BLANK = 0,      // empty field, no bytes
+  BIN_TIME,           // uint32_t s after base_time -> YYYY-MM-DDThh:mm:ss
+  BIN_POD_ID,         // header pod_id, no bytes
+  BIN_FIRMWARE,       // header firmware, no bytes
+  BIN_U16,            // uint16_t
+  BIN_I16,            // int16_t
+  BIN_U32,            // uint32_t
+  BIN_I32,            // int32_t
+  BIN_F32,            // float, 2 decimals like Print::print()
+  BIN_I16_F,          // int16_t printed as a float with 2 decimals
+  BIN_I32_F,          // int32_t printed as a float with 2 decimals
+  BIN_TYPES
+};  //enum bin_col_e
+
+/*! File header; the column schema and the CSV header row follow it */
+struct binlog_header_t
+{
+  char magic[4];                    // BIN_MAGIC, no '\0'
+  uint8_t version;
+  uint8_t columns;
+  uint16_t header_size;             // this struct + the schema + the header row
+  uint16_t record_size;
+  uint32_t base_time;               // unixtime BIN_TIME offsets count from
+  char pod_id[BIN_POD_ID_SIZE];     // '\0' padded
+  char firmware[BIN_FIRMWARE_SIZE]; // '\0' padded
+} __attribute__((packed));  //struct binlog_header_t
+
+#define BIN_HEADER_MAX        (sizeof(binlog_header_t) + 2 * BIN_MAX_COLUMNS)   // without the row
+
+/*! One binary record; the first record built also fixes the schema, so
+ *  every record must add the same columns in the same order */
+class BinRecord {
+  public:
+    BinRecord();
+    void clear();
+
+    void set_flag(uint8_t flag);
+    void blank();
+    void add_text(uint8_t type);
+    void add_time(uint32_t offset);
+    void add_u16(uint16_t value, uint8_t flag = 0);
+    void add_i16(int16_t value, uint8_t flag = 0);
+    void add_u32(uint32_t value, uint8_t flag = 0);
+    void add_i32(int32_t value, uint8_t flag = 0);
+    void add_f32(float value, uint8_t flag = 0);
+    void add_i16_f(int16_t value, uint8_t flag = 0);
+    void add_i32_f(int32_t value, uint8_t flag = 0);
+    void add_int(int value, uint8_t flag = 0);
+    void add_int_f(int value, uint8_t flag = 0);
+    void end();
+
+    const uint8_t *data();
+    uint16_t length();
+    bool overflow();
+    size_t write_to(Print &output);
+
+    uint16_t header(uint8_t *out, uint32_t base_time, const char *pod_id, const char *firmware,
+                    uint16_t row_length = 0);
+
+  private:
+    void column(uint8_t type, uint8_t flag, const void *value, uint8_t size);
+
+    uint8_t buf[BIN_RECORD_SIZE];
+    uint16_t len;
+    uint8_t schema[BIN_MAX_COLUMNS][2];
+    uint8_t columns;
+    bool frozen;          // schema complete (first end())
+    bool truncated;
+};  //class BinRecord
+
+#endif  //_BINLOG_H
@@ -0,0 +1,113 @@
+/*******************************************************************************
+ * @file    cal_file.cpp
+ * @brief   CAL.CSV parser: one pass, one field buffered (see cal_file.h)
+ *
+ * @author  Percy Smith, percy.smith@colorado.edu
+ * @date    October 17, 2026
+ * @log     Single-pass CAL.CSV parser, one field buffered
+******************************************************************************/
+#include <stdlib.h>
+
+#include "cal_file.h"
+
+/*! Where each number of a line goes, in cal_table.h's order */
+static const uint8_t CAL_SLOTS[CAL_FIELDS] PROGMEM = {
+  offsetof(cal_pod_t, co.gain), offsetof(cal_pod_t, co.rh), offsetof(cal_pod_t, co.offset),
+  offsetof(cal_pod_t, co2.gain), offsetof(cal_pod_t, co2.root), offsetof(cal_pod_t, co2.rh),
+  offsetof(cal_pod_t, co2.t), offsetof(cal_pod_t, co2.offset),
+  offsetof(cal_pod_t, t.gain), offsetof(cal_pod_t, t.offset),
+  offsetof(cal_pod_t, rh.gain), offsetof(cal_pod_t, rh.offset),
+  offsetof(cal_pod_t, voc.fig2600), offsetof(cal_pod_t, voc.square), offsetof(cal_pod_t, voc.fig2602),
+  offsetof(cal_pod_t, voc.t), offsetof(cal_pod_t, voc.rh), offsetof(cal_pod_t, voc.offset),
+};
+
+/**************************************************************************/
+ /*!
+ *    @param  letter, number  this pod's cal ID (calID_letter, calID_number)
+ */
+/**************************************************************************/
+CalReader::CalReader(char letter, char number)
+{
+  line = CAL_POD_NONE;
+  line.letter = letter;
+  line.number = number;
+  found = line;
+  length = 0;
+  index = 0;
+  skip = false;
+  ok = false;
+} //CalReader()
+
+/*! One byte of the file */
+size_t CalReader::write(uint8_t c)
+{
+  if (c == '\n')
+    end_line();
+  else if (skip || c == '\r' || c == ' ' || c == '\t')
+    ;
+  else if (c == ',')
+    end_field();
+  else if (length < CAL_FIELD_SIZE - 1)
+    field[length++] = c;
+  else
+    skip = true;  // too long for a number
+  return 1;
+} //size_t CalReader::write(uint8_t c)
+
+/**************************************************************************/
+ /*!
+ *    @brief  Field 0 must be this pod's ID; each of the CAL_FIELDS after
+ *            it must hold one number and nothing else (strtod() takes the
+ *            whole field)
+ */
+/**************************************************************************/
+void CalReader::end_field()
+{
+  field[length] = '\0';
+  if (index == 0)
+    skip = length != 2 || field[0] != line.letter || field[1] != line.number;
+  else if (index > CAL_FIELDS)
+    skip = true;
+  else
+  {
+    char *end;
+    double value = strtod(field, &end);
+    if (length == 0 || *end != '\0')
+      skip = true;
+    else
+      *(double *)((uint8_t *)&line + pgm_read_byte(&CAL_SLOTS[index - 1])) = value;
+  }
+  index++;
+  length = 0;
+} //void CalReader::end_field()
+
+void CalReader::end_line()
+{
+  if (!skip && (index > 0 || length > 0))
+  {
+    // "...,offset," (a trailing comma, as the pod's own CSV rows have) leaves
+    // an empty field after the last number: not a field of its own
+    if (length > 0 || index != CAL_FIELDS + 1)
+      end_field();
+    if (!skip && index == CAL_FIELDS + 1)
+    {
+      found = line;
+      ok = true;
+    }
+  }
+  length = 0;
+  index = 0;
+  skip = false;
+} //void CalReader::end_line()
+
+/*! Ends a last line with no '\n'; true if this pod's line was found */
+bool CalReader::end()
+{
+  end_line();
+  return ok;
+} //bool CalReader::end()
+
+const cal_pod_t &CalReader::row()
+{
+  return found;
+} //const cal_pod_t &CalReader::row()
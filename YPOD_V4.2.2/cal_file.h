@@ -0,0 +1,55 @@
+/*******************************************************************************
+ * @file    cal_file.h
+ * @brief   Reads this pod's coefficients from CAL.CSV (CAL_FILE_ENABLED).
+ *          One pod per line, the cal ID then cal_table.h's 18 numbers in
+ *          its order:
+ *
+ *            E8,co gain,rh,offset,co2 gain,root,rh,t,offset,t gain,offset,
+ *               rh gain,offset,voc fig2600,square,fig2602,t,rh,offset
+ *
+ *          CalReader is a Print: SD_Logger::read_file() streams the file
+ *          into it and it parses as the bytes come, one field at a time in
+ *          a CAL_FIELD_SIZE buffer. Other pods' lines, headers & '#'
+ *          comments are skipped; a line with a bad or missing number is
+ *          ignored. A trailing comma is allowed. The last good line for
+ *          this pod wins
+ *
+ * @author  Percy Smith, percy.smith@colorado.edu
+ * @date    October 17, 2026
+ * @log     Coefficients from the SD card, compiled table as the fallback
+******************************************************************************/
+#ifndef _CAL_FILE_H
+#define _CAL_FILE_H
+
+#include <Arduino.h>
+
+#include "cal_table.h"
+
+#define CAL_FILE_NAME         "CAL.CSV"
+#define CAL_FIELD_SIZE        16        // longest field + 1 ("-0.000233333" is 12)
+#define CAL_FIELDS            18        // numbers per line, after the ID
+
+/*! Parses CAL.CSV bytes; row() is this pod's line once end() says found */
+class CalReader : public Print {
+  public:
+    CalReader(char letter, char number);
+
+    size_t write(uint8_t c);
+    using Print::write;
+    bool end();
+    const cal_pod_t &row();
+
+  private:
+    void end_field();
+    void end_line();
+
+    cal_pod_t line;         // the line being read
+    cal_pod_t found;        // this pod's last good line
+    char field[CAL_FIELD_SIZE];
+    uint8_t length;         // chars in field
+    uint8_t index;          // field number in the line, 0 = ID
+    bool skip;              // rest of the line is not ours (or is bad)
+    bool ok;                // found holds a line
+};  //class CalReader
+
+#endif  //_CAL_FILE_H
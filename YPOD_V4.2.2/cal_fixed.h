@@ -0,0 +1,264 @@
+/*******************************************************************************
+ * @file    cal_fixed.h
+ * @brief   Fixed-point CO, CO2 & TVOC/methane equations (CAL_FIXED_POINT).
+ *          cal_fixed() turns a pod's cal_table.h row into integer
+ *          coefficients at compile time; each term is then integer
+ *          multiplies and a shift, so a record needs no soft-float
+ *          arithmetic beyond putting T & RH into CAL_Q once
+ *
+ *          A term c * x is (k * x) >> 16 >> shift with k = round(c * 2^S),
+ *          S the largest scale that keeps k * (largest x) under 2^46. k has
+ *          31 bits and only the top of the 48 bit product is kept, from two
+ *          16 x 16 multiplies, so a gain near 1 on 65535 counts is still
+ *          good to 0.01; results are in CAL_Q (1/256). The methane square
+ *          term needs a 64 bit product: fig2600^2 alone is 32 bits
+ *
+ *          Inputs: ADC counts & CO2 ppm as uint16_t, T & RH as int16_t in
+ *          CAL_Q (to 1/256 C & %, finer than the SHT25 reads them).
+ *          test/cal_fixed.test reports each pod's largest error against
+ *          the float equations in cal_table.h
+ *
+ * @cite    cal_table.h equations (calibration.cpp by Chiara Pesce)
+ *
+ * @author  Percy Smith, percy.smith@colorado.edu
+ * @date    October 17, 2026
+ * @log     Optional fixed-point calibration (CAL_FIXED_POINT)
+******************************************************************************/
+#ifndef _CAL_FIXED_H
+#define _CAL_FIXED_H
+
+#include <stdint.h>
+
+#include "cal_table.h"
+
+#define CAL_Q                 8         // fractional bits of T, RH, sqrt(CO2) & the results
+#define CAL_TERM_BITS         46        // |k * x| bound: >> 16, a few terms add up inside int32
+#define CAL_SQUARE_BITS       62        // same for the 64 bit square term (no >> 16)
+
+// Largest inputs the coefficients are scaled for
+#define CAL_ADC_MAX           65535.0   // co, fig2600, fig2602 (uint16_t counts)
+#define CAL_CO2_MAX           65535.0   // ppm, as a uint16_t
+#define CAL_ENV_MAX           32767     // |T| & |RH| in CAL_Q: 127.99 (SHT25 range -40..125 C)
+
+/*! One term: c * x == (k * x) >> 16 >> shift, in CAL_Q (square: no >> 16) */
+struct cal_term_t
+{
+  int32_t k;
+  uint8_t shift;
+};  //struct cal_term_t
+
+struct cal_co_q_t
+{
+  cal_term_t gain;
+  cal_term_t rh;
+  int32_t offset;           // CAL_Q
+};  //struct cal_co_q_t
+
+struct cal_co2_q_t
+{
+  cal_term_t gain;
+  cal_term_t root;          // x = sqrt(co2) in CAL_Q
+  cal_term_t rh;
+  cal_term_t t;
+  int32_t offset;
+};  //struct cal_co2_q_t
+
+struct cal_voc_q_t
+{
+  cal_term_t fig2600;
+  cal_term_t square;        // x = fig2600^2, 64 bit product
+  cal_term_t fig2602;
+  cal_term_t t;
+  cal_term_t rh;
+  int32_t offset;
+};  //struct cal_voc_q_t
+
+/*! The fixed-point equations of one pod (T & RH stay float: float in & out) */
+struct cal_pod_q_t
+{
+  cal_co_q_t co;
+  cal_co2_q_t co2;
+  cal_voc_q_t voc;
+};  //struct cal_pod_q_t
+
+/*
+ * Compile time: coefficient scaling
+ */
+constexpr double cal_sq(double x)
+{
+  return x * x;
+}
+
+/*! 2^n, by halving n: Cal::set() also scales at run time, on a small stack */
+constexpr double cal_pow2(int n)
+{
+  return n < 0 ? 1.0 / cal_pow2(-n) : n == 0 ? 1.0 : (n & 1 ? 2.0 : 1.0) * cal_sq(cal_pow2(n / 2));
+}
+
+constexpr int32_t cal_round(double x)
+{
+  return (int32_t)(x < 0 ? x - 0.5 : x + 0.5);
+}
+
+/*! Largest S (up to cap) with |c| * 2^S * xmax under 2^bits */
+constexpr int cal_scale(double c, double xmax, int bits, int cap, int s = 0)
+{
+  return s < cap && (c < 0 ? -c : c) * cal_pow2(s + 1) * xmax < cal_pow2(bits)
+       ? cal_scale(c, xmax, bits, cap, s + 1) : s;
+}
+
+constexpr cal_term_t cal_term_at(double c, int scale, int shift)
+{
+  return c == 0 ? cal_term_t{ 0, 0 } : cal_term_t{ cal_round(c * cal_pow2(scale)), (uint8_t)shift };
+}
+
+/*! Term for c * x, x a 16 bit integer with fx fractional bits; the shift
+ *  stays under 32 */
+constexpr cal_term_t cal_term(double c, double xmax, int fx)
+{
+  return cal_term_at(c, cal_scale(c, xmax, CAL_TERM_BITS, 47 + CAL_Q - fx),
+                     cal_scale(c, xmax, CAL_TERM_BITS, 47 + CAL_Q - fx) + fx - CAL_Q - 16);
+}
+
+/*! Term for c * x, x a uint32_t (cal_mul64) */
+constexpr cal_term_t cal_term64(double c, double xmax)
+{
+  return cal_term_at(c, cal_scale(c, xmax, CAL_SQUARE_BITS, 31 + CAL_Q),
+                     cal_scale(c, xmax, CAL_SQUARE_BITS, 31 + CAL_Q) - CAL_Q);
+}
+
+constexpr cal_co_q_t cal_fixed(const cal_co_t &c)
+{
+  return { cal_term(c.gain, CAL_ADC_MAX, 0),
+           cal_term(c.rh, CAL_ENV_MAX, CAL_Q),
+           cal_round(c.offset * cal_pow2(CAL_Q)) };
+}
+
+constexpr cal_co2_q_t cal_fixed(const cal_co2_t &c)
+{
+  return { cal_term(c.gain, CAL_CO2_MAX, 0),
+           cal_term(c.root, 256.0 * cal_pow2(CAL_Q), CAL_Q),  // sqrt(65535) < 256
+           cal_term(c.rh, CAL_ENV_MAX, CAL_Q),
+           cal_term(c.t, CAL_ENV_MAX, CAL_Q),
+           cal_round(c.offset * cal_pow2(CAL_Q)) };
+}
+
+constexpr cal_voc_q_t cal_fixed(const cal_voc_t &c)
+{
+  return { cal_term(c.fig2600, CAL_ADC_MAX, 0),
+           cal_term64(c.square, CAL_ADC_MAX * CAL_ADC_MAX),
+           cal_term(c.fig2602, CAL_ADC_MAX, 0),
+           cal_term(c.t, CAL_ENV_MAX, CAL_Q),
+           cal_term(c.rh, CAL_ENV_MAX, CAL_Q),
+           cal_round(c.offset * cal_pow2(CAL_Q)) };
+}
+
+constexpr cal_pod_q_t cal_fixed(const cal_pod_t &p)
+{
+  return { cal_fixed(p.co), cal_fixed(p.co2), cal_fixed(p.voc) };
+}
+
+/*! False if a term's coefficient was too large to scale (shift wrapped);
+ *  only a row read at run time can be (Cal::set()) */
+constexpr bool cal_fits(const cal_term_t &t, int bits)
+{
+  return t.shift < bits;
+}
+
+constexpr bool cal_fits(const cal_pod_q_t &q)
+{
+  return cal_fits(q.co.gain, 32) && cal_fits(q.co.rh, 32) && cal_fits(q.co2.gain, 32) &&
+         cal_fits(q.co2.root, 32) && cal_fits(q.co2.rh, 32) && cal_fits(q.co2.t, 32) &&
+         cal_fits(q.voc.fig2600, 32) && cal_fits(q.voc.square, 64) && cal_fits(q.voc.fig2602, 32) &&
+         cal_fits(q.voc.t, 32) && cal_fits(q.voc.rh, 32);
+}
+
+/*
+ * Run time
+ */
+/*! T or RH in CAL_Q, rounded; saturates at +-127.99 */
+static inline int16_t cal_q(float x)
+{
+  float q = x * (1 << CAL_Q);
+  if (q >= CAL_ENV_MAX)
+    return CAL_ENV_MAX;
+  if (q <= -CAL_ENV_MAX)
+    return -CAL_ENV_MAX;
+  return (int16_t)(q + (q < 0 ? -0.5f : 0.5f));
+} //static inline int16_t cal_q(float x)
+
+/**************************************************************************/
+ /*!
+ *    @brief  (k * x) >> 16 >> shift without a 48 bit product: k's top and
+ *            bottom halves times x, two 16 x 16 -> 32 multiplies
+ */
+/**************************************************************************/
+static inline int32_t cal_mul(const cal_term_t &c, uint16_t x)
+{
+  int32_t hi = (int32_t)(int16_t)(c.k >> 16) * (int32_t)x;
+  int32_t lo = ((uint32_t)(uint16_t)c.k * (uint32_t)x) >> 16;
+  return (hi + lo) >> c.shift;
+} //static inline int32_t cal_mul(const cal_term_t &c, uint16_t x)
+
+/*! Same for a signed x (T, RH); the bottom half's >> 16 floors */
+static inline int32_t cal_mul(const cal_term_t &c, int16_t x)
+{
+  int32_t hi = (int32_t)(int16_t)(c.k >> 16) * (int32_t)x;
+  int32_t lo = ((int32_t)(uint16_t)c.k * (int32_t)x) >> 16;
+  return (hi + lo) >> c.shift;
+} //static inline int32_t cal_mul(const cal_term_t &c, int16_t x)
+
+static inline int32_t cal_mul64(const cal_term_t &c, uint32_t x)
+{
+  return ((int64_t)c.k * x) >> c.shift;
+} //static inline int32_t cal_mul64(const cal_term_t &c, uint32_t x)
+
+/**************************************************************************/
+ /*!
+ *    @brief  sqrt(x) in CAL_Q, rounded to nearest (bit by bit, no division)
+ */
+/**************************************************************************/
+static inline uint16_t cal_sqrt_q(uint16_t x)
+{
+  uint32_t n = (uint32_t)x << (2 * CAL_Q);
+  uint32_t root = 0;
+  for (uint32_t bit = 1UL << 30; bit; bit >>= 2)
+  {
+    if (n >= root + bit)
+    {
+      n -= root + bit;
+      root = (root >> 1) + bit;
+    }
+    else
+      root >>= 1;
+  }
+  return n > root ? root + 1 : root;
+} //static inline uint16_t cal_sqrt_q(uint16_t x)
+
+/*
+ * Equations in CAL_Q, before the clamp; same terms as cal_table.h
+ */
+static inline int32_t eval_co_q(const cal_co_q_t &c, uint16_t co, int16_t rh)
+{
+  return cal_mul(c.gain, co) + cal_mul(c.rh, rh) + c.offset;
+} //static inline int32_t eval_co_q(...)
+
+static inline int32_t eval_co2_q(const cal_co2_q_t &c, uint16_t co2, int16_t rh, int16_t t)
+{
+  return cal_mul(c.gain, co2) + (c.root.k ? cal_mul(c.root, cal_sqrt_q(co2)) : 0)
+       + cal_mul(c.rh, rh) + cal_mul(c.t, t) + c.offset;
+} //static inline int32_t eval_co2_q(...)
+
+static inline int32_t eval_voc_q(const cal_voc_q_t &c, uint16_t fig2600, uint16_t fig2602, int16_t rh, int16_t t)
+{
+  return cal_mul(c.fig2600, fig2600) + (c.square.k ? cal_mul64(c.square, (uint32_t)fig2600 * fig2600) : 0)
+       + cal_mul(c.fig2602, fig2602) + cal_mul(c.t, t) + cal_mul(c.rh, rh) + c.offset;
+} //static inline int32_t eval_voc_q(...)
+
+/*! A CAL_Q result as the int column: negative clamps to 0, fraction dropped */
+static inline int cal_int(int32_t q)
+{
+  return q < 0 ? 0 : q >> CAL_Q;
+} //static inline int cal_int(int32_t q)
+
+#endif  //_CAL_FIXED_H
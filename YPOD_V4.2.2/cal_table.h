@@ -0,0 +1,165 @@
+/*******************************************************************************
+ * @file    cal_table.h
+ * @brief   Per-pod calibration coefficients for CO, CO2, temperature, RH and
+ *          TVOC/methane. The pod's row is looked up by the compiler from
+ *          ypodID, so only that pod's numbers end up in the firmware and each
+ *          equation is straight-line code
+ *
+ * @cite    calibration.cpp >> calID switches by Chiara Pesce,
+ *          chiara.pesce@colorado.edu
+ *
+ * @author  Percy Smith, percy.smith@colorado.edu
+ * @date    October 17, 2026
+ * @log     Replaces the calID_letter/calID_number switches in calibration.cpp
+******************************************************************************/
+#ifndef _CAL_TABLE_H
+#define _CAL_TABLE_H
+
+#include <stdint.h>
+#include <math.h>
+
+/*! Linear: y = gain * x + offset (temperature, RH) */
+struct cal_linear_t
+{
+  double gain;
+  double offset;
+};  //struct cal_linear_t
+
+/*! RH-compensated CO: y = gain * co + rh * RH + offset */
+struct cal_co_t
+{
+  double gain;
+  double rh;
+  double offset;
+};  //struct cal_co_t
+
+/*! RH/T-compensated CO2, or quadratic in sqrt(co2) when root != 0:
+ *  y = gain * co2 + root * sqrt(co2) + rh * RH + t * T + offset */
+struct cal_co2_t
+{
+  double gain;
+  double root;
+  double rh;
+  double t;
+  double offset;
+};  //struct cal_co2_t
+
+/*! RH/T-compensated TVOC from both Figaros, or quadratic in fig2600 (methane)
+ *  when square != 0:
+ *  y = fig2600 * F1 + square * F1^2 + fig2602 * F2 + t * T + rh * RH + offset */
+struct cal_voc_t
+{
+  double fig2600;
+  double square;
+  double fig2602;
+  double t;
+  double rh;
+  double offset;
+};  //struct cal_voc_t
+
+/*! One pod: ypodID[4], ypodID[5] and an equation per calibrated variable */
+struct cal_pod_t
+{
+  char letter;
+  char number;
+  cal_co_t co;
+  cal_co2_t co2;
+  cal_linear_t t;
+  cal_linear_t rh;
+  cal_voc_t voc;
+};  //struct cal_pod_t
+
+// No equation: CO, CO2, T & RH pass the raw signal through, TVOC reads 1
+constexpr cal_co_t CAL_CO_NONE = { 1, 0, 0 };
+constexpr cal_co2_t CAL_CO2_NONE = { 1, 0, 0, 0, 0 };
+constexpr cal_linear_t CAL_LINEAR_NONE = { 1, 0 };
+constexpr cal_voc_t CAL_VOC_NONE = { 0, 0, 0, 0, 0, 1 };
+constexpr cal_pod_t CAL_POD_NONE = { 0, 0, CAL_CO_NONE, CAL_CO2_NONE, CAL_LINEAR_NONE, CAL_LINEAR_NONE, CAL_VOC_NONE };
+
+/*! CO {gain, rh, offset}, CO2 {gain, root, rh, t, offset}, T {gain, offset},
+ *  RH {gain, offset}, VOC {fig2600, square, fig2602, t, rh, offset} */
+constexpr cal_pod_t CAL_PODS[] = {
+  { 'U', '1', { 0.00107, -0.12473, 4.53371 }, { 0.58073, 0, 0.19558, -2.26283, 131.85519 },   { 1.07405, -4.30518 }, { 1.16004, -5.86517 },  { 0.32267, 0, 0.01340, -8.07775, -3.84592, -108.73772 } },
+  { 'U', '2', { 0.00117, -0.12668, 5.09077 }, { 1.26202, 0, 0.32735, -0.82488, 87.94083 },    { 1.06117, -3.69364 }, { 1.18720, -11.41265 }, { 0.19793, 0, 0.08935, -6.93728, 1.29320, -237.47212 } },
+  { 'U', '3', { 0.00093, -0.07671, 2.07106 }, { 0.78940, 0, 0.02548, 1.48442, -81.97484 },    { 0.96286, 2.42155 },  { 0.86923, -1.05297 },  { 0.34530, 0, -0.02789, -7.89486, -2.10618, -123.04054 } },
+  { 'U', '4', { 0.00109, -0.12464, 4.71174 }, { 1.16717, 0, 0.20373, 0.01642, -82.95474 },    { 1.11116, -5.52967 }, { 1.18899, -7.94909 },  { 0.24943, 0, -0.04176, -2.14601, 2.08575, -58.61145 } },
+  { 'U', '5', { 0.00680, -0.07564, 2.55893 }, { 1.09692, 0, 0.03911, 0.06376, -46.68639 },    { 0.92305, 3.22576 },  { 0.84466, 1.02186 },   { 0.23609, 0, -0.01862, -3.15310, -2.22867, 64.46123 } },
+  { 'U', '6', CAL_CO_NONE,                    { 1.04357, 0, -1.31559, -0.68401, -72.63513 },  { 1.05834, -2.55614 }, { 1.04647, -1.98453 },  { 0.08350, 0, 0.09610, -7.00497, -1.13425, -26.52803 } },
+  { 'U', '7', { 0.00113, -0.11509, 4.27234 }, { 1.17296, 0, -0.01352, 0.98768, -132.54824 },  { 1.04182, -2.74393 }, { 1.08633, -4.56042 },  { -0.02459, 0, 0.34355, -4.8841, 0.93670, -2.81665 } },
+  { 'U', '8', { 0.00110, -0.12029, 4.04736 }, { 1.16663, 0, -0.64001, -0.58624, -31.31421 },  { 1.05981, -4.09106 }, { 1.15852, -2.94663 },  { 0.00007, 0, 0.27187, -5.80255, 1.10081, -47.22491 } },
+  { 'V', '1', { 0.00111, -0.11678, 4.11220 }, { 1.18498, 0, -0.09612, 1.94091, -267.48365 },  { 1.03286, -1.94146 }, { 1.05049, -2.28806 },  { -0.01203, 0, 0.30088, -5.68046, -0.50848, -65.52601 } },
+  { 'V', '2', { 0.00111, -0.11678, 4.11220 }, { 0.50596, 0, 0.35266, 1.00766, -25.15380 },    { 0.91601, 3.16763 },  { 0.84372, 2.94169 },   { -0.00280, 0, 0.30710, -1.94186, 0.02974, -140.82678 } },
+  { 'V', '3', { 0.00111, -0.11678, 4.11220 }, { 1.09692, 0, 0.03911, 0.06376, -46.68639 },    { 1.03915, -2.26521 }, { 1.09012, -4.97333 },  { 0.25902, 0, 0.10550, -8.69664, -3.37784, -33.94685 } },
+  { 'V', '4', { 0.00111, -0.11678, 4.11220 }, { 1.09692, 0, 0.03911, 0.06376, -46.68639 },    { 1.02993, 1.05383 },  { 0.90586, -0.12867 },  { 0.25902, 0, 0.10550, -8.69664, -3.37784, -33.94685 } },
+  { 'V', '6', { 0.00109, -0.07102, 1.42407 }, { 0.94356, 0, 0.53461, 1.72155, -90.12135 },    { 0.98436, 2.32866 },  { 0.86409, 1.26824 },   { 0.05183, 0, 0.32653, -9.03121, -2.86512, 31.39674 } },
+  { 'M', '6', { 0.00111, -0.11678, 4.11220 }, { 1.09692, 0, 0.03911, 0.06376, -46.68639 },    { 1.02993, 1.05383 },  { 0.90586, -0.12867 },  { 0.25902, 0, 0.10550, -8.69664, -3.37784, -33.94685 } },
+  { 'H', '1', { 0.00111, -0.11678, 4.11220 }, { 1.09692, 0, 0.03911, 0.06376, -46.68639 },    { 1.02993, 1.05383 },  { 0.90586, -0.12867 },  { 0.25902, 0, 0.10550, -8.69664, -3.37784, -33.94685 } },
+  { 'X', '0', { 0.00108, -0.12966, 4.89108 }, { 1.03612, 0, 1.17989, 0.85961, -186.12921 },   { 1.09128, -5.91627 }, { 1.29066, -12.22035 }, { 0.10555, 0, 0.52609, -10.08610, -8.4633, -140.17887 } },
+  { 'X', '1', { 0.00112, -0.07675, 1.25783 }, { 0.37740, 0, -0.10422, -2.27307, 223.94961 },  { 0.93920, 1.15479 },  { 0.96548, 0.32820 },   { 1.10572, 0, 0.04663, -10.25925, -7.99611, 94.73553 } },
+  { 'X', '9', { 0.00111, -0.11678, 4.11220 }, { 1.09692, 0, 0.03911, 0.06376, -46.68639 },    { 1.03915, -2.26521 }, { 1.09012, -4.97333 },  { 0.25902, 0, 0.10550, -8.69664, -3.37784, -33.94685 } },
+  { 'F', '2', { 0.00107, -0.14491, 5.75429 }, { 1.22328, 0, 0.16343, -1.40132, -15.57537 },   { 1.10493, -5.64845 }, { 1.33239, -17.35959 }, { 0.08573, 0, 0.29712, -6.74396, -3.74510, -79.30350 } },
+  { 'F', '4', { 0.00117, -0.13572, 5.46203 }, { 1.09864, 0, 0.57402, 0.46539, -89.00339 },    { 1.07020, -4.39655 }, { 1.24322, -12.37479 }, { 0.14993, 0, 0.76761, -12.50848, -10.55894, -60.76884 } },
+  { 'D', '2', { 0.0158519, 0, 45.0054 },      { 0.190925, 25.9412, 0, 0, -53.1515 },          CAL_LINEAR_NONE,       CAL_LINEAR_NONE,        { -0.84023, 0.0003215, 0, 0, 0, 2592.58 } },
+  { 'D', '4', { 0.00102, -0.16957, 5.30658 }, { 1.09476, 0, -1.89513, -5.76502, -4.97449 },   { 1.01657, -3.23499 }, { 1.13629, -3.32180 },  { 0.28396, 0, 0.12025, -28.22628, -19.14735, 558.10205 } },
+  { 'Z', '2', { 0.00123, -0.13601, 4.78696 }, { 1.03796, 0, -0.77552, -0.36187, -134.25129 }, { 1.09779, -5.73499 }, { 1.25800, -5.96184 },  { 0.11951, 0, 0.11722, -10.51041, -3.26410, -6.68153 } },
+  { 'Z', '3', { 0.00114, -0.12002, 4.42928 }, { 1.22535, 0, -0.05251, 1.22153, -64.50792 },   { 1.08138, -4.36113 }, { 1.18946, -8.40903 },  { 0.06341, 0, 0.12616, -4.16462, 0.45900, -166.55003 } },
+  { 'A', '1', { 0.00104, -0.12167, 4.43994 }, { 1.12864, 0, 0.02037, -0.78409, -110.70007 },  { 1.05173, -2.83754 }, { 1.15608, -5.57459 },  { 0.13273, 0, 0.23343, -10.41855, -6.77488, -168.42069 } },
+  { 'T', '1', { 0.00111, -0.11678, 4.11220 }, { 0.71347, 0, 0.68218, 0.98741, 37.41322 },     { 1.10157, 2.37415 },  { 0.99291, -5.81132 },  { 0.24462, 0, 0.02381, -8.01323, -5.18922, 98.25879 } },
+  { 'T', '2', { 0.00111, -0.11678, 4.11220 }, { 1.36979, 0, -1.73881, 4.56957, -390.66394 },  { 1.00995, -2.13822 }, { 1.06249, -3.53605 },  { 0.16532, 0, 0.29906, -22.90767, -14.56504, -333.32130 } },
+  { 'T', '3', { 0.00111, -0.11678, 4.11220 }, { 1.09692, 0, 0.03911, 0.06376, -46.68639 },    { 1.03947, -2.37966 }, { 1.09647, -5.14926 },  { 0.25902, 0, 0.10550, -8.69664, -3.37784, -33.94685 } },
+  { 'T', '4', { 0.00105, -0.14761, 4.78947 }, { 1.20414, 0, -0.54367, -1.09033, -71.13862 },  { 1.05173, -2.83754 }, { 1.06968, -2.61488 },  { 0.31646, 0, -0.01155, -9.47855, -1.69741, -52.00493 } },
+  { 'T', '5', { 0.00111, -0.11678, 4.11220 }, { 1.09692, 0, 0.03911, 0.06376, -46.68639 },    { 1.03947, -2.37966 }, { 1.09647, -5.14926 },  { 0.25902, 0, 0.10550, -8.69664, -3.37784, -33.94685 } },
+  { 'T', '6', { 0.00112, -0.07675, 1.95190 }, { 0.77203, 0, 0.68218, 0.98741, -41.27804 },    { 0.95264, 2.58850 },  { 0.92664, -5.81132 },  { 0.34719, 0, 0.02180, -7.0645, -1.04831, -34.33277 } },
+  { 'O', '1', { 0.00107, -0.11883, 4.46679 }, { 1.16921, 0, 0.60567, 1.10530, -191.66687 },   { 1.08049, -4.03947 }, { 1.14766, -6.53990 },  { 0.21135, 0, 0.01461, -6.22240, -1.91248, -49.68230 } },
+  { 'K', '2', { 0.00104, -0.03188, 2.48679 }, { 0.35536, 0, 0.79715, 0.53309, 87.70961 },     { 0.91166, 2.37415 },  { 0.96193, -3.51642 },  { 0.12465, 0, 0.25099, -11.69244, -8.85123, -271.92746 } },
+  { 'K', '3', { 0.00111, -0.11678, 4.11220 }, { 1.09907, 0, -0.14214, -1.74229, 98.61317 },   { 1.10950, -5.75163 }, { 1.20688, -6.58213 },  { 0.10336, 0, 0.16505, -6.43139, -1.57642, -63.34526 } },
+  { 'K', '4', { 0.00111, -0.11678, 4.11220 }, { 1.09692, 0, 0.03911, 0.06376, -46.68639 },    { 1.03915, -2.26521 }, { 1.09012, -4.97333 },  { 0.25902, 0, 0.10550, -8.69664, -3.37784, -33.94685 } },
+  { 'L', '1', { 0.00107, -0.11803, 3.62155 }, { 0.26675, 0, 0.40967, -0.44070, 128.64243 },   { 1.09721, -5.19718 }, { 1.20574, -4.02710 },  { 0.06399, 0, 0.24491, -11.73609, -8.63813, 210.54627 } },
+  { 'B', '8', { 0.00112, -0.12563, 4.56465 }, { 1.29633, 0, -1.04402, -3.17786, 266.75475 },  { 1.05199, -4.55966 }, { 1.22586, -8.15827 },  { 0.06657, 0, 0.11868, -7.54970, -1.89487, 7.06147 } },
+  { 'G', '2', { 0.00115, -0.11353, 3.00400 }, { 1.11746, 0, 0.14695, 0.74198, -272.54046 },   { 1.10837, -5.12265 }, { 1.13665, -5.63727 },  { 0.15554, 0, 0.01399, -11.80565, -5.22316, 20.15178 } },
+  { 'E', '8', { 0.0174481, 0, 50.6432 },      { -0.14443, 34.7383, 0, 0, -228.426 },          CAL_LINEAR_NONE,       CAL_LINEAR_NONE,        { -0.913449, 0.000233333, 0, 0, 0, 2938.14 } },
+};
+constexpr unsigned CAL_POD_COUNT = sizeof(CAL_PODS) / sizeof(CAL_PODS[0]);
+
+/**************************************************************************/
+ /*!
+ *    @brief  Finds a pod's row; CAL_POD_NONE if it has no calibration.
+ *            Meant for constant expressions (see CAL_POD in calibration.cpp)
+ */
+/**************************************************************************/
+constexpr cal_pod_t cal_lookup(char letter, char number, unsigned i = 0)
+{
+  return i >= CAL_POD_COUNT ? CAL_POD_NONE
+       : (CAL_PODS[i].letter == letter && CAL_PODS[i].number == number) ? CAL_PODS[i]
+       : cal_lookup(letter, number, i + 1);
+} //constexpr cal_pod_t cal_lookup(char letter, char number, unsigned i)
+
+/*
+ * Equations - terms are summed in the order the old switch cases wrote them,
+ * so results are bit-for-bit the same. Negative CO, CO2 & TVOC clamp to 0
+ */
+static inline int eval_co(const cal_co_t &c, uint16_t co, float rh)
+{
+  int co_cal = (c.gain * co) + (c.rh * rh) + c.offset;
+  return co_cal < 0 ? 0 : co_cal;
+} //static inline int eval_co(...)
+
+static inline int eval_co2(const cal_co2_t &c, float co2, float rh, float t)
+{
+  int co2_cal = (c.gain * co2) + (c.root ? c.root * sqrt(co2) : 0) + (c.rh * rh) + (c.t * t) + c.offset;
+  return co2_cal < 0 ? 0 : co2_cal;
+} //static inline int eval_co2(...)
+
+static inline float eval_linear(const cal_linear_t &c, float x)
+{
+  return (c.gain * x) + c.offset;
+} //static inline float eval_linear(...)
+
+static inline int eval_voc(const cal_voc_t &c, uint16_t fig2600, uint16_t fig2602, float rh, float t)
+{
+  int voc_cal = (c.fig2600 * fig2600) + (c.square ? c.square * ((double)fig2600 * fig2600) : 0)
+              + (c.fig2602 * fig2602) + (c.t * t) + (c.rh * rh) + c.offset;
+  return voc_cal < 0 ? 0 : voc_cal;
+} //static inline int eval_voc(...)
+
+#endif  //_CAL_TABLE_H
@@ -17,6 +17,10 @@
 #define CALIBRATE_VOC   1 // Calibrates VOC sensors 
 
 #include "YPOD_node.h" // include statement 
+#if CAL_FILE_ENABLED
+#include "cal_table.h"
+#include "cal_fixed.h"
+#endif
 
 struct calOutput { // sruct for which var to calibrate
   int CO_;
@@ -28,14 +32,30 @@ struct calOutput { // sruct for which var to calibrate
 
 class Cal {
   public: // public variables
+  #if CAL_FILE_ENABLED
+    Cal();
+    bool set (const cal_pod_t &row); // coefficients from CAL.CSV instead of the compiled row
+  #endif
     calOutput calibrate (uint16_t co, float co2, float rh, float t, uint16_t fig2600, uint16_t fig2602);
     
   private: // private variables
+  #if CAL_FIXED_POINT // rh, t in CAL_Q, co2 in whole ppm
+    int calibrate_co (uint16_t co, int16_t rh);
+    int calibrate_co2 (uint16_t co2, int16_t rh, int16_t t);
+    int calibrate_voc (uint16_t fig2600, uint16_t fig2602, int16_t rh, int16_t t);
+  #else
     int calibrate_co (uint16_t co, float rh); 
     int calibrate_co2 (float co2, float rh, float t);
+    int calibrate_voc (uint16_t fig2600, uint16_t fig2602, float rh, float t);
+  #endif
     float calibrate_t (float t);
     float calibrate_rh (float rh);
-    int calibrate_voc (uint16_t fig2600, uint16_t fig2602, float rh, float t);
+  #if CAL_FILE_ENABLED // this pod's coefficients in RAM
+    cal_pod_t pod;
+  #if CAL_FIXED_POINT
+    cal_pod_q_t pod_q;
+  #endif
+  #endif
 };
 
 #endif // _CALIBRATION_H
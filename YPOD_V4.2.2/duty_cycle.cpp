@@ -0,0 +1,138 @@
+/*******************************************************************************
+ * @file    duty_cycle.cpp
+ * @brief   Low-power duty cycle on DS3231 alarm 1 (see duty_cycle.h)
+ *
+ * @author  Percy Smith, percy.smith@colorado.edu
+ * @date    October 17, 2026
+ * @log     Alarm 1 wake, power-down & the PMS warm-up slot
+******************************************************************************/
+#include <avr/sleep.h>
+
+#include "duty_cycle.h"
+
+#if defined(__AVR__) && !PMS_ENABLED
+#include <avr/interrupt.h>
+// No SoftwareSerial to own the pin-change vectors: an unhandled one resets
+#ifdef PCINT0_vect
+EMPTY_INTERRUPT(PCINT0_vect)
+#endif
+#ifdef PCINT1_vect
+EMPTY_INTERRUPT(PCINT1_vect)
+#endif
+#ifdef PCINT2_vect
+EMPTY_INTERRUPT(PCINT2_vect)
+#endif
+#endif  //__AVR__ && !PMS_ENABLED
+
+DutyCycle::DutyCycle()
+{
+  rtc = NULL;
+  pin = 0;
+  period = 60;
+  sleeps = 0;
+  skips = 0;
+} //DutyCycle()
+
+/**************************************************************************/
+ /*!
+ *    @brief  Sets the wake source up; RTC.begin() must have run
+ *        @param  rtc       the DS3231
+ *        @param  int_pin   pin its SQW/INT output is wired to (pulled up)
+ *        @param  period_s  slot spacing; slots fall on multiples of it
+ */
+/**************************************************************************/
+void DutyCycle::begin(RTC_DS3231 *rtc, uint8_t int_pin, uint32_t period_s)
+{
+  this->rtc = rtc;
+  pin = int_pin;
+  period = period_s ? period_s : 1;
+  pinMode(pin, INPUT_PULLUP);  // INT is open drain
+  rtc->disableAlarm(2);
+  rtc->clearAlarm(2);
+} //void DutyCycle::begin(RTC_DS3231 *rtc, uint8_t int_pin, uint32_t period_s)
+
+/**************************************************************************/
+ /*!
+ *    @brief  First slot after `now` (unixtime): with a period that divides
+ *            a day, slots sit at the same clock times every day
+ */
+/**************************************************************************/
+uint32_t DutyCycle::next_slot(uint32_t now)
+{
+  return (now / period + 1) * period;
+} //uint32_t DutyCycle::next_slot(uint32_t now)
+
+/**************************************************************************/
+ /*!
+ *    @brief  Powers down until the RTC reaches `wake`, then gives the pin
+ *            back to the 1 Hz square wave. Everything else (SD, sensors,
+ *            Serial) must be settled beforehand
+ *    @return False (without sleeping) if `wake` is under DUTY_MIN_SLEEP_S
+ *            away. True once the alarm has fired: `wake` has just begun
+ */
+/**************************************************************************/
+bool DutyCycle::sleep_until(uint32_t wake)
+{
+  if (wake < rtc->now().unixtime() + DUTY_MIN_SLEEP_S)
+  {
+    skips++;
+    return false;
+  }
+
+  rtc->writeSqwPinMode(DS3231_OFF);  // INTCN: the pin follows the alarm flags
+  rtc->clearAlarm(1);
+  rtc->setAlarm1(DateTime(wake), DS3231_A1_Date);
+
+  power_down();
+
+  rtc->disableAlarm(1);
+  rtc->clearAlarm(1);  // releases INT
+  rtc->writeSqwPinMode(DS3231_SquareWave1Hz);
+  sleeps++;
+  return true;
+} //bool DutyCycle::sleep_until(uint32_t wake)
+
+uint16_t DutyCycle::sleep_count()
+{
+  return sleeps;
+} //uint16_t DutyCycle::sleep_count()
+
+uint16_t DutyCycle::skip_count()
+{
+  return skips;
+} //uint16_t DutyCycle::skip_count()
+
+/**************************************************************************/
+ /*!
+ *    @brief  Power-down sleep until INT goes low. Any other interrupt that
+ *            wakes the MCU (a PMS byte, ...) just sends it back to sleep
+ */
+/**************************************************************************/
+void DutyCycle::power_down()
+{
+  uint8_t adcsra = ADCSRA;
+  uint8_t pcicr = *digitalPinToPCICR(pin);
+
+  ADCSRA &= ~_BV(ADEN);  // the ADC keeps drawing in power-down unless off
+  *digitalPinToPCMSK(pin) |= _BV(digitalPinToPCMSKbit(pin));
+  *digitalPinToPCICR(pin) |= _BV(digitalPinToPCICRbit(pin));
+  set_sleep_mode(SLEEP_MODE_PWR_DOWN);
+
+  noInterrupts();
+  while (digitalRead(pin) == HIGH)  // INT stays low until the flag is cleared
+  {
+    sleep_enable();
+#ifdef sleep_bod_disable
+    sleep_bod_disable();
+#endif
+    interrupts();
+    sleep_cpu();  // sei() holds interrupts for one instruction: an edge since the check still wakes it
+    sleep_disable();
+    noInterrupts();
+  }
+  interrupts();
+
+  *digitalPinToPCMSK(pin) &= ~_BV(digitalPinToPCMSKbit(pin));
+  *digitalPinToPCICR(pin) = pcicr;
+  ADCSRA = adcsra;
+} //void DutyCycle::power_down()
@@ -0,0 +1,50 @@
+/*******************************************************************************
+ * @file    duty_cycle.h
+ * @brief   Low-power duty cycle: DS3231 alarm 1 wakes the MCU from power-down
+ *          on a wall-clock sample slot. The alarm comes out on the same
+ *          SQW/INT pin the software clock counts, so the pin is switched to
+ *          the interrupt output (INTCN) for the sleep and back to the 1 Hz
+ *          square wave after it
+ *
+ *          The wake is a pin-change interrupt on that pin: with the PMS on,
+ *          SoftwareSerial owns every PCINT vector and its handler ignores
+ *          other pins; without it duty_cycle.cpp supplies empty ones
+ *
+ * @cite    Maxim DS3231 datasheet >> Alarms, Control Register (INTCN, A1IE)
+ * @cite    ATmega328P datasheet >> Power Management and Sleep Modes
+ *
+ * @author  Percy Smith, percy.smith@colorado.edu
+ * @date    October 17, 2026
+ * @log     Duty-cycled sleep between samples
+******************************************************************************/
+#ifndef _DUTY_CYCLE_H
+#define _DUTY_CYCLE_H
+
+#include <Arduino.h>
+#include <RTClib.h>   //P - last tested with "RTClib@2.1.4"
+
+#include "YPOD_node.h"
+
+#define DUTY_MIN_SLEEP_S      2   // a slot closer than this is sampled without sleeping
+
+class DutyCycle {
+  public:
+    DutyCycle();
+    void begin(RTC_DS3231 *rtc, uint8_t int_pin, uint32_t period_s);
+    uint32_t next_slot(uint32_t now);
+    bool sleep_until(uint32_t wake);
+
+    uint16_t sleep_count();
+    uint16_t skip_count();
+
+  private:
+    void power_down();
+
+    RTC_DS3231 *rtc;
+    uint8_t pin;
+    uint32_t period;
+    uint16_t sleeps;            // alarms slept to
+    uint16_t skips;             // slots too close (or passed) to sleep to
+};  //class DutyCycle
+
+#endif  //_DUTY_CYCLE_H
@@ -0,0 +1,275 @@
+/*******************************************************************************
+ * @file    i2c_bus.cpp
+ * @brief   Shared I2C bus manager (see i2c_bus.h)
+ *
+ * @author  Percy Smith, percy.smith@colorado.edu
+ * @date    October 17, 2026
+ * @log     Queue, bus clear & per-address counts (library calls
+ *          measured too)
+******************************************************************************/
+#include "i2c_bus.h"
+
+I2C_Bus i2c_bus;
+
+I2C_Bus::I2C_Bus()
+{
+  queued = 0;
+  count = 0;
+  clock = 100000;  // Wire's default
+  cleared = 0;
+}
+
+/**************************************************************************/
+ /*!
+ *    @brief  Frees a stuck bus, then starts Wire with a transfer timeout
+ *    @return False if SDA or SCL is still held low
+ */
+/**************************************************************************/
+bool I2C_Bus::begin()
+{
+  pinMode(SDA, INPUT_PULLUP);
+  pinMode(SCL, INPUT_PULLUP);
+  if (digitalRead(SDA) == LOW || digitalRead(SCL) == LOW)
+    return recover();
+
+  Wire.begin();
+#if defined(WIRE_HAS_TIMEOUT)
+  Wire.setWireTimeout(I2C_TIMEOUT_US, true);
+#endif  //WIRE_HAS_TIMEOUT
+  Wire.setClock(clock);
+  return true;
+} //bool I2C_Bus::begin()
+
+/**************************************************************************/
+ /*!
+ *    @brief  Bus clock (AVR TWI: up to 400 kHz). Wire.begin() goes back to
+ *            100 kHz, so call this after the libraries' begin()s
+ */
+/**************************************************************************/
+void I2C_Bus::set_clock(uint32_t hz)
+{
+  clock = hz;
+  Wire.setClock(clock);
+} //void I2C_Bus::set_clock(uint32_t hz)
+
+/**************************************************************************/
+ /*!
+ *    @brief  Runs this address's queued transactions at no more than hz
+ */
+/**************************************************************************/
+void I2C_Bus::limit_clock(uint8_t addr, uint32_t hz)
+{
+  i2c_stats_t *s = stats(addr);
+  if (s)
+    s->clock = hz;
+} //void I2C_Bus::limit_clock(uint8_t addr, uint32_t hz)
+
+/**************************************************************************/
+ /*!
+ *    @brief  Queues a transaction for the next run(); `txn` must stay put
+ *            until its result is no longer I2C_PENDING
+ *    @return False if the queue is full (txn untouched)
+ */
+/**************************************************************************/
+bool I2C_Bus::submit(i2c_txn_t &txn)
+{
+  if (queued >= I2C_QUEUE_SIZE)
+    return false;
+  for (uint8_t i = 0; i < queued; i++)
+    if (queue[i] == &txn)
+      return false;
+  txn.result = I2C_PENDING;
+  txn.rx_got = 0;
+  queue[queued++] = &txn;
+  return true;
+} //bool I2C_Bus::submit(i2c_txn_t &txn)
+
+/**************************************************************************/
+ /*!
+ *    @brief  Everything queued, back to back, in submission order
+ */
+/**************************************************************************/
+void I2C_Bus::run()
+{
+  if (timed_out())  // a library transfer got stuck since the last pass
+    recover();
+
+  for (uint8_t i = 0; i < queued; i++)
+    transfer(*queue[i]);
+  queued = 0;
+} //void I2C_Bus::run()
+
+/**************************************************************************/
+ /*!
+ *    @brief  One transaction now (setup code, run()); timed & counted
+ */
+/**************************************************************************/
+i2c_result_e I2C_Bus::transfer(i2c_txn_t &txn)
+{
+  i2c_stats_t *s = stats(txn.addr);
+  bool slow = s && s->clock && s->clock < clock;
+  uint32_t started = micros();
+
+  if (slow)
+    Wire.setClock(s->clock);
+
+  txn.result = I2C_OK;
+  txn.rx_got = 0;
+  if (txn.tx_len)
+  {
+    Wire.beginTransmission(txn.addr);
+    Wire.write(txn.tx, txn.tx_len);
+    if (Wire.endTransmission() != 0)
+      txn.result = I2C_NACK;
+  }
+  if (txn.result == I2C_OK && txn.rx_len)
+  {
+    txn.rx_got = Wire.requestFrom(txn.addr, txn.rx_len);
+    for (uint8_t i = 0; i < txn.rx_got; i++)
+      txn.rx[i] = Wire.read();
+    if (txn.rx_got == 0)
+      txn.result = I2C_NACK;
+  }
+  if (slow)
+    Wire.setClock(clock);
+
+  txn.result = tally(s, started, txn.result);
+  return txn.result;
+} //i2c_result_e I2C_Bus::transfer(i2c_txn_t &txn)
+
+/**************************************************************************/
+ /*!
+ *    @brief  Counts a library's own transfer(s) to `addr` like a queued one
+ *        @param  started micros() just before the library call
+ *        @param  ok      the library's own result (false counts a NACK)
+ */
+/**************************************************************************/
+i2c_result_e I2C_Bus::measured(uint8_t addr, uint32_t started, bool ok)
+{
+  return tally(stats(addr), started, ok ? I2C_OK : I2C_NACK);
+} //i2c_result_e I2C_Bus::measured(uint8_t addr, uint32_t started, bool ok)
+
+/**************************************************************************/
+ /*!
+ *    @brief  Bus clear: with Wire off, clocks SCL (open drain) until the
+ *            device holding SDA lets go, sends a STOP, then restarts Wire
+ *    @return False if a line is still held low
+ */
+/**************************************************************************/
+bool I2C_Bus::recover()
+{
+  cleared++;
+  Wire.end();
+  pinMode(SDA, INPUT_PULLUP);
+  pinMode(SCL, INPUT_PULLUP);
+  delayMicroseconds(5);
+
+  for (uint8_t i = 0; i < I2C_CLEAR_PULSES && digitalRead(SDA) == LOW; i++)
+  {
+    digitalWrite(SCL, LOW);
+    pinMode(SCL, OUTPUT);
+    delayMicroseconds(5);
+    pinMode(SCL, INPUT_PULLUP);
+    delayMicroseconds(5);
+  }
+
+  // STOP: SDA rises while SCL is high
+  digitalWrite(SDA, LOW);
+  pinMode(SDA, OUTPUT);
+  delayMicroseconds(5);
+  pinMode(SDA, INPUT_PULLUP);
+  delayMicroseconds(5);
+  bool free = digitalRead(SDA) == HIGH && digitalRead(SCL) == HIGH;
+
+  Wire.begin();
+#if defined(WIRE_HAS_TIMEOUT)
+  Wire.setWireTimeout(I2C_TIMEOUT_US, true);
+#endif  //WIRE_HAS_TIMEOUT
+  Wire.setClock(clock);
+  return free;
+} //bool I2C_Bus::recover()
+
+uint8_t I2C_Bus::device_count()
+{
+  return count;
+}
+
+const i2c_stats_t *I2C_Bus::device(uint8_t index)
+{
+  return index < count ? &devices[index] : NULL;
+}
+
+uint16_t I2C_Bus::recoveries()
+{
+  return cleared;
+}
+
+/**************************************************************************/
+ /*!
+ *    @brief  Zeroes the counters (a new reporting window); addresses &
+ *            their clock limits stay
+ */
+/**************************************************************************/
+void I2C_Bus::reset_stats()
+{
+  for (uint8_t i = 0; i < count; i++)
+  {
+    devices[i].count = 0;
+    devices[i].nacks = 0;
+    devices[i].timeouts = 0;
+    devices[i].total_us = 0;
+    devices[i].max_us = 0;
+  }
+  cleared = 0;
+} //void I2C_Bus::reset_stats()
+
+/*! The address's counters, added on first use (NULL once the table is full) */
+i2c_stats_t *I2C_Bus::stats(uint8_t addr)
+{
+  for (uint8_t i = 0; i < count; i++)
+    if (devices[i].addr == addr)
+      return &devices[i];
+  if (count >= I2C_MAX_DEVICES)
+    return NULL;
+
+  i2c_stats_t *s = &devices[count++];
+  memset(s, 0, sizeof(*s));
+  s->addr = addr;
+  return s;
+} //i2c_stats_t *I2C_Bus::stats(uint8_t addr)
+
+/*! True (once) if Wire abandoned a transfer since the last check */
+bool I2C_Bus::timed_out()
+{
+#if defined(WIRE_HAS_TIMEOUT)
+  if (Wire.getWireTimeoutFlag())
+  {
+    Wire.clearWireTimeoutFlag();
+    return true;
+  }
+#endif  //WIRE_HAS_TIMEOUT
+  return false;
+} //bool I2C_Bus::timed_out()
+
+/*! Adds one transfer to the address's counters; a timeout frees the bus */
+i2c_result_e I2C_Bus::tally(i2c_stats_t *s, uint32_t started, i2c_result_e result)
+{
+  if (timed_out())
+    result = I2C_TIMEOUT;
+
+  if (s)
+  {
+    uint32_t took = micros() - started;
+    s->count++;
+    s->total_us += took;
+    if (took > s->max_us)
+      s->max_us = took;
+    if (result == I2C_NACK)
+      s->nacks++;
+    if (result == I2C_TIMEOUT)
+      s->timeouts++;
+  }
+  if (result == I2C_TIMEOUT)
+    recover();
+  return result;
+} //i2c_result_e I2C_Bus::tally(i2c_stats_t *s, uint32_t started, i2c_result_e result)
@@ -0,0 +1,104 @@
+/*******************************************************************************
+ * @file    i2c_bus.h
+ * @brief   Owns the I2C bus (Wire): clock, stuck-bus recovery, timeouts and
+ *          a transaction queue. Drivers submit() a transaction and poll its
+ *          result; run() (once per loop() pass) does everything queued back
+ *          to back and keeps latency, NACK & timeout counts per address.
+ *
+ *          A device holding SDA low (reset mid-byte) is freed by clocking
+ *          SCL until it lets go, then a STOP. That happens in begin() and
+ *          after any transfer that times out, the libraries' included (AVR
+ *          Wire with setWireTimeout())
+ *
+ *          Devices still driven by a library (MCP342x, DS3231, ADS1115
+ *          setup) are counted too: the caller takes micros() before the
+ *          library call and hands it to measured() with whether the call
+ *          worked
+ *
+ * @cite    NXP UM10204, "I2C-bus specification and user manual", rev. 7,
+ *          3.1.16 Bus clear
+ *
+ * @author  Percy Smith, percy.smith@colorado.edu
+ * @date    October 17, 2026
+ * @log     Shared I2C bus manager
+******************************************************************************/
+#ifndef _I2C_BUS_H
+#define _I2C_BUS_H
+
+#include <Arduino.h>
+#include <Wire.h>
+
+#define I2C_QUEUE_SIZE        4     // transactions waiting for run()
+#define I2C_MAX_DEVICES       8     // addresses with their own counters (a full pod has 8, general call included)
+#define I2C_TIMEOUT_US        25000 // a transfer stuck this long is abandoned
+#define I2C_CLEAR_PULSES      9     // SCL clocks to free a stuck SDA
+
+/*! Index: I2C_OK, I2C_PENDING (queued), I2C_NACK (address or data not
+ *  ACKed), I2C_TIMEOUT (bus stuck, recovered) */
+enum i2c_result_e
+{
+  I2C_OK = 0,
+  I2C_PENDING,
+  I2C_NACK,
+  I2C_TIMEOUT
+};  //enum i2c_result_e
+
+/*! One transaction: write tx (if any), then read rx_len bytes (if any) */
+struct i2c_txn_t
+{
+  uint8_t addr;
+  const uint8_t *tx;
+  uint8_t tx_len;
+  uint8_t *rx;
+  uint8_t rx_len;
+  uint8_t rx_got;           // bytes the read returned
+  i2c_result_e result;
+};  //struct i2c_txn_t
+
+/*! (per address) transactions through the bus & their cost */
+struct i2c_stats_t
+{
+  uint8_t addr;
+  uint32_t clock;           // Hz this device is run at (0 = bus clock)
+  uint16_t count;
+  uint16_t nacks;
+  uint16_t timeouts;
+  uint32_t total_us;
+  uint32_t max_us;
+};  //struct i2c_stats_t
+
+class I2C_Bus
+{
+  public:
+    I2C_Bus();
+    bool begin();
+    void set_clock(uint32_t hz);
+    void limit_clock(uint8_t addr, uint32_t hz);
+
+    bool submit(i2c_txn_t &txn);
+    i2c_result_e transfer(i2c_txn_t &txn);
+    i2c_result_e measured(uint8_t addr, uint32_t started, bool ok);
+    void run();
+    bool recover();
+
+    uint8_t device_count();
+    const i2c_stats_t *device(uint8_t index);
+    uint16_t recoveries();
+    void reset_stats();
+
+  private:
+    i2c_stats_t *stats(uint8_t addr);
+    bool timed_out();
+    i2c_result_e tally(i2c_stats_t *s, uint32_t started, i2c_result_e result);
+
+    i2c_txn_t *queue[I2C_QUEUE_SIZE];
+    uint8_t queued;
+    i2c_stats_t devices[I2C_MAX_DEVICES];
+    uint8_t count;
+    uint32_t clock;
+    uint16_t cleared;         // recover() calls
+};  //class I2C_Bus
+
+extern I2C_Bus i2c_bus;
+
+#endif  //_I2C_BUS_H
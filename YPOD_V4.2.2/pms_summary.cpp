@@ -0,0 +1,77 @@
+/*******************************************************************************
+ * @file    pms_summary.cpp
+ * @brief   PM extended mode: per-bin means & maxima over a record interval
+ *          (see pms_summary.h)
+ *
+ * @author  Percy Smith, percy.smith@colorado.edu
+ * @date    October 17, 2026
+ * @log     Per-bin mean, max & frame count over one record
+******************************************************************************/
+#include "pms_summary.h"
+
+PmsSummary::PmsSummary()
+{
+  frames = 0;
+  take();  // zeroes the sums & maxima
+} //PmsSummary()
+
+/**************************************************************************/
+ /*!
+ *    @brief  Folds one frame in (a PMS::onFrame() handler). With
+ *            INCLUDE_PARTICLES, frames without the counts (PMS1003/3003
+ *            layout) are left out so every bin shares the frame count
+ */
+/**************************************************************************/
+void PmsSummary::add(const PMS::DATA &data)
+{
+#if INCLUDE_PARTICLES
+  if (!data.hasParticles)
+    return;
+#endif  //INCLUDE_PARTICLES
+  if (frames == 0xFFFF)  // ~3.6 h of 200 ms frames: the sums stay exact
+    return;
+
+  const uint16_t values[PMS_SUMMARY_BINS] = {
+#if INCLUDE_STANDARD
+    data.pm10_standard, data.pm25_standard, data.pm100_standard,
+#endif  //INCLUDE_STANDARD
+    data.pm10_env, data.pm25_env, data.pm100_env,
+#if INCLUDE_PARTICLES
+    data.particles_03um, data.particles_05um, data.particles_10um,
+    data.particles_25um, data.particles_50um, data.particles_100um,
+#endif  //INCLUDE_PARTICLES
+  };
+
+  for (uint8_t i = 0; i < PMS_SUMMARY_BINS; i++)
+  {
+    sum[i] += values[i];
+    if (values[i] > peak[i])
+      peak[i] = values[i];
+  }
+  frames++;
+} //void PmsSummary::add(const PMS::DATA &data)
+
+/**************************************************************************/
+ /*!
+ *    @brief  The interval's summary; the next one starts empty
+ */
+/**************************************************************************/
+pms_summary_t PmsSummary::take()
+{
+  pms_summary_t summary;
+  summary.frames = frames;
+  for (uint8_t i = 0; i < PMS_SUMMARY_BINS; i++)
+  {
+    summary.mean[i] = frames ? (sum[i] + frames / 2) / frames : 0;
+    summary.peak[i] = peak[i];
+    sum[i] = 0;
+    peak[i] = 0;
+  }
+  frames = 0;
+  return summary;
+} //pms_summary_t PmsSummary::take()
+
+uint16_t PmsSummary::frame_count()
+{
+  return frames;
+} //uint16_t PmsSummary::frame_count()
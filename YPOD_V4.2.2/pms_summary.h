@@ -0,0 +1,48 @@
+/*******************************************************************************
+ * @file    pms_summary.h
+ * @brief   PM extended mode (PMS_EXTENDED): every PMS frame that arrives
+ *          between two records is folded into per-bin running sums and
+ *          maxima, so a record carries the whole interval (mean, max and
+ *          frame count per bin) instead of the one frame it happened to take
+ *
+ *          Bins, in frame order: CF=1 PM1/2.5/10 (INCLUDE_STANDARD),
+ *          atmospheric PM1/2.5/10, then the 0.3..10 um particle counts
+ *          (INCLUDE_PARTICLES). Sums are integer, so the means are exact
+ *          before rounding; the record width only grows with the bins chosen
+ *
+ * @cite    Plantower PMS5003 datasheet >> Appendix I (active mode, frame)
+ *
+ * @author  Percy Smith, percy.smith@colorado.edu
+ * @date    October 17, 2026
+ * @log     PM extended mode
+******************************************************************************/
+#ifndef _PMS_SUMMARY_H
+#define _PMS_SUMMARY_H
+
+#include <Arduino.h>
+
+#include "YPOD_node.h"
+#include "PMS.h"
+
+/*! One record interval's summary; mean & peak are blank-worthy if frames is 0 */
+struct pms_summary_t
+{
+    uint16_t frames;
+    uint16_t mean[PMS_SUMMARY_BINS];    // rounded
+    uint16_t peak[PMS_SUMMARY_BINS];
+};  //struct pms_summary_t
+
+class PmsSummary {
+  public:
+    PmsSummary();
+    void add(const PMS::DATA &data);
+    pms_summary_t take();
+    uint16_t frame_count();
+
+  private:
+    uint32_t sum[PMS_SUMMARY_BINS];
+    uint16_t peak[PMS_SUMMARY_BINS];
+    uint16_t frames;
+};  //class PmsSummary
+
+#endif  //_PMS_SUMMARY_H
@@ -0,0 +1,161 @@
+/*******************************************************************************
+ * @file    profiler.cpp
+ * @brief   Fixed-bucket latency histograms for loop() stages
+ *
+ * @author  Percy Smith, percy.smith@colorado.edu
+ * @date    October 17, 2026
+ * @log     Half-octave buckets, p50/p95 & the window halving
+******************************************************************************/
+#include "profiler.h"
+
+Profiler::Profiler()
+{
+  reset();
+} //Profiler()
+
+/**************************************************************************/
+ /*!
+ *    @brief  Clears every histogram and opens a new reporting window
+ */
+/**************************************************************************/
+void Profiler::reset()
+{
+  memset(hist, 0, sizeof(hist));
+  window_start = millis();
+} //void Profiler::reset()
+
+void Profiler::start(uint8_t stage)
+{
+  hist[stage].started = micros();
+} //void Profiler::start(uint8_t stage)
+
+void Profiler::stop(uint8_t stage)
+{
+  add_sample(stage, micros() - hist[stage].started);
+} //void Profiler::stop(uint8_t stage)
+
+/**************************************************************************/
+ /*!
+ *    @brief  Adds one duration; a full bucket halves the whole histogram
+ *            so the percentiles keep their shape over long windows
+ */
+/**************************************************************************/
+void Profiler::add_sample(uint8_t stage, uint32_t us)
+{
+  prof_hist_t *h = &hist[stage];
+  uint8_t b = bucket_of(us);
+
+  if (h->bucket[b] == 0xFFFF)
+  {
+    for (uint8_t i = 0; i < PROF_BUCKETS; i++)
+      h->bucket[i] >>= 1;
+  }
+
+  h->bucket[b]++;
+  h->count++;
+  h->total += us;
+  if (us > h->max)
+    h->max = us;
+} //void Profiler::add_sample(uint8_t stage, uint32_t us)
+
+/**************************************************************************/
+ /*!
+ *    @brief  True once PROFILE_PERIOD_MS has passed since the last reset
+ */
+/**************************************************************************/
+bool Profiler::due()
+{
+  return millis() - window_start >= PROFILE_PERIOD_MS;
+} //bool Profiler::due()
+
+uint32_t Profiler::samples(uint8_t stage)
+{
+  return hist[stage].count;
+} //uint32_t Profiler::samples(uint8_t stage)
+
+uint32_t Profiler::total_us(uint8_t stage)
+{
+  return hist[stage].total;
+} //uint32_t Profiler::total_us(uint8_t stage)
+
+uint32_t Profiler::max_us(uint8_t stage)
+{
+  return hist[stage].max;
+} //uint32_t Profiler::max_us(uint8_t stage)
+
+/**************************************************************************/
+ /*!
+ *    @brief  Upper edge of the bucket holding the pct-th percentile,
+ *            capped at the largest sample (so never an overestimate of max)
+ *    @return us, or 0 with no samples
+ */
+/**************************************************************************/
+uint32_t Profiler::percentile(uint8_t stage, uint8_t pct)
+{
+  prof_hist_t *h = &hist[stage];
+  uint32_t n = 0;
+  uint32_t seen = 0;
+
+  for (uint8_t i = 0; i < PROF_BUCKETS; i++)
+    n += h->bucket[i];
+  if (n == 0)
+    return 0;
+
+  // rank of the percentile sample, rounded up (1-based)
+  uint32_t rank = (n * pct + 99) / 100;
+  if (rank == 0)
+    rank = 1;
+
+  for (uint8_t i = 0; i < PROF_BUCKETS; i++)
+  {
+    seen += h->bucket[i];
+    if (seen >= rank)
+    {
+      uint32_t top = bucket_top(i);
+      return top < h->max ? top : h->max;
+    }
+  }
+
+  return h->max;
+} //uint32_t Profiler::percentile(uint8_t stage, uint8_t pct)
+
+/**************************************************************************/
+ /*!
+ *    @brief  Bucket for a duration: 0 below PROF_MIN_US, then [lo, 1.5 lo)
+ *            and [1.5 lo, 2 lo) for each octave lo = 16, 32, 64 ... us
+ */
+/**************************************************************************/
+uint8_t Profiler::bucket_of(uint32_t us)
+{
+  uint8_t b = 1;
+
+  if (us < PROF_MIN_US)
+    return 0;
+
+  while (us >= 2 * PROF_MIN_US)
+  {
+    us >>= 1;
+    b += 2;
+  }
+  if (us >= PROF_MIN_US + PROF_MIN_US / 2)
+    b++;
+
+  return b < PROF_BUCKETS ? b : PROF_BUCKETS - 1;
+} //uint8_t Profiler::bucket_of(uint32_t us)
+
+/**************************************************************************/
+ /*!
+ *    @brief  Exclusive upper edge of a bucket in us (the last bucket has
+ *            none; percentile() caps it at the stage max)
+ */
+/**************************************************************************/
+uint32_t Profiler::bucket_top(uint8_t bucket)
+{
+  if (bucket == 0)
+    return PROF_MIN_US;
+  if (bucket >= PROF_BUCKETS - 1)
+    return 0xFFFFFFFF;
+
+  uint32_t octave = (uint32_t)PROF_MIN_US << ((bucket - 1) / 2);
+  return (bucket & 1) ? octave + octave / 2 : 2 * octave;
+} //uint32_t Profiler::bucket_top(uint8_t bucket)
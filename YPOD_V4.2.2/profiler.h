@@ -0,0 +1,79 @@
+/*******************************************************************************
+ * @file    profiler.h
+ * @brief   Per-stage latency histograms for loop(): each stage is timed with
+ *          micros() into fixed half-octave buckets, reported as count, total,
+ *          p50, p95 and max once per PROFILE_PERIOD_MS
+ *
+ *          PROF_START()/PROF_STOP() compile to nothing unless PROFILE_ENABLED
+ *
+ * @author  Percy Smith, percy.smith@colorado.edu
+ * @date    October 17, 2026
+ * @log     Loop latency instrumentation
+******************************************************************************/
+#ifndef _PROFILER_H
+#define _PROFILER_H
+
+#include <Arduino.h>
+
+#include "YPOD_node.h"
+#include "scheduler.h"
+
+// Bucket 0 is < 16 us, then two buckets per octave; the last one is open-ended (>= ~524 ms)
+#define PROF_BUCKETS          32
+#define PROF_MIN_US           16
+
+/*! Index: fixed loop() stages, then one stage per scheduler task */
+enum prof_stage_e
+{
+  PROF_LOOP = 0,      // whole loop() pass
+  PROF_PMS,           // PMS serial drain
+  PROF_RECORD,        // RTC read, calibration & record formatting
+  PROF_SD,            // logger.append() incl. syncs & re-inits
+  PROF_SERIAL,        // record echo into the TX buffer (no waiting on the UART)
+  PROF_TASK,          // + scheduler task id: its start/poll/collect calls
+  PROF_STAGES = PROF_TASK + SCHED_MAX_TASKS
+};  //enum prof_stage_e
+
+/*! Samples of one stage since the last reset */
+struct prof_hist_t
+{
+  uint16_t bucket[PROF_BUCKETS];  // halved together when one would overflow
+  uint32_t count;
+  uint32_t total;                 // us
+  uint32_t max;                   // us
+  uint32_t started;               // micros() at PROF_START
+};  //struct prof_hist_t
+
+class Profiler {
+  public:
+    Profiler();
+    void reset();
+
+    void start(uint8_t stage);
+    void stop(uint8_t stage);
+    void add_sample(uint8_t stage, uint32_t us);
+
+    bool due();
+    uint32_t samples(uint8_t stage);
+    uint32_t total_us(uint8_t stage);
+    uint32_t max_us(uint8_t stage);   // not max(): a macro on AVR
+    uint32_t percentile(uint8_t stage, uint8_t pct);
+
+    static uint8_t bucket_of(uint32_t us);
+    static uint32_t bucket_top(uint8_t bucket);
+
+  private:
+    prof_hist_t hist[PROF_STAGES];
+    uint32_t window_start;        // millis() at the last reset
+};  //class Profiler
+
+#if PROFILE_ENABLED
+extern Profiler profiler;
+#define PROF_START(stage)     profiler.start(stage)
+#define PROF_STOP(stage)      profiler.stop(stage)
+#else
+#define PROF_START(stage)
+#define PROF_STOP(stage)
+#endif  //PROFILE_ENABLED
+
+#endif  //_PROFILER_H
@@ -10,6 +10,7 @@
  * @TBD     Add an option to disable (not default) unused channels
 ******************************************************************************/
 #include "quad_module.h"
+#include "i2c_bus.h"
 
 /**************************************************************************/
  /*!
@@ -19,6 +20,10 @@
 QUAD_Module::QUAD_Module()
 {
   status = true;
+  channel = QUAD_CHANNELS;
+  ready[0] = ready[1] = false;
+  started = 0;
+  failed = false;
 }
 
 bool QUAD_Module::begin()
@@ -26,49 +31,148 @@ bool QUAD_Module::begin()
   alpha_one = MCP342x(ALPHA_ONE_ADDR);
   alpha_two = MCP342x(ALPHA_TWO_ADDR);
 
-  MCP342x::generalCallReset();
+  uint32_t t = micros();
+  i2c_bus.measured(QUAD_GENERAL_CALL, t, MCP342x::generalCallReset() == 0);
   delay(1);
 
   return status;
 }
 
+/*! Record field for [chip][channel index] */
+static long quad_data::* const QUAD_FIELD[2][QUAD_CHANNELS] = {
+  { &quad_data::a1C1, &quad_data::a1C2, &quad_data::a2C1, &quad_data::a2C2 },
+  { &quad_data::a3C1, &quad_data::a3C2, &quad_data::a4C1, &quad_data::a4C2 }
+};
+
+/*! Pointers, not copies: the library's channel constants live in another
+ *  translation unit and may not be initialised yet when this table is */
+static const MCP342x::Channel *const QUAD_CHANNEL[QUAD_CHANNELS] = {
+  &MCP342x::channel1, &MCP342x::channel2, &MCP342x::channel3, &MCP342x::channel4
+};
+
+/**************************************************************************/
+ /*!
+ *    @brief  Blocking read of all eight channels (both chips in parallel)
+ */
+/**************************************************************************/
 quad_data QUAD_Module::return_data()
 {
-  MCP342x::Config status;
-  long value = 0;
+  if (start_read())
+  {
+    unsigned long started = millis();
+    while (!read_done() && millis() - started < 1000)
+      ;
+  }
+
+  return data;
+}
+
+/**************************************************************************/
+ /*!
+ *    @brief  Starts channel 1 on both chips at once; never blocks
+ *    @return False if either chip did not take its configuration
+ */
+/**************************************************************************/
+bool QUAD_Module::start_read()
+{
+  channel = 0;
+  failed = !start_channel();
+  return !failed;
+}
+
+/**************************************************************************/
+ /*!
+ *    @brief  Polls both chips' ready bits once QUAD_CONVERSION_MS has
+ *            passed; once both have a result the next channel is started
+ *            on both
+ *    @return True after the 4th channel pair has been read, or when a
+ *            channel did not start (read_ok() is then false)
+ */
+/**************************************************************************/
+bool QUAD_Module::read_done()
+{
+  MCP342x *chip[2] = { &alpha_one, &alpha_two };
+  MCP342x::Config config;
+  long value;
 
-  // Initiate a conversion; convertAndRead() will wait until it can be read
-  alpha_one.convertAndRead(MCP342x::channel1, MCP342x::oneShot, MCP342x::resolution16, 
-                          MCP342x::gain1, 1000000, value, status);
-  data.a1C1 = value;
+  if (channel >= QUAD_CHANNELS)
+    return true;
 
-   alpha_one.convertAndRead(MCP342x::channel2, MCP342x::oneShot, MCP342x::resolution16, 
-                          MCP342x::gain1, 1000000, value, status);
-  data.a1C2 = value;
+  // no I2C traffic before the conversion can have finished
+  if (millis() - started < QUAD_CONVERSION_MS)
+    return false;
 
-  alpha_one.convertAndRead(MCP342x::channel3, MCP342x::oneShot, MCP342x::resolution16, 
-                          MCP342x::gain1, 1000000, value, status);
-  data.a2C1 = value;
+  for (uint8_t c = 0; c < 2; c++)
+  {
+    if (ready[c])
+      continue;
 
-  alpha_one.convertAndRead(MCP342x::channel4, MCP342x::oneShot, MCP342x::resolution16, 
-                          MCP342x::gain1, 1000000, value, status);
-  data.a2C2 = value;
+    // 4 byte read: result + config byte, whose RDY bit clears on new data
+    uint32_t t = micros();
+    bool ok = chip[c]->read(value, config) == MCP342x::errorNone;
+    i2c_bus.measured(chip[c]->getAddress(), t, ok);
+    if (ok && config.isReady())
+    {
+      data.*QUAD_FIELD[c][channel] = value;
+      ready[c] = true;
+    }
+  }
 
-  alpha_two.convertAndRead(MCP342x::channel1, MCP342x::oneShot, MCP342x::resolution16, 
-                          MCP342x::gain1, 1000000, value, status);
-  data.a3C1 = value;
+  if (!ready[0] || !ready[1])
+    return false;
 
-  alpha_two.convertAndRead(MCP342x::channel2, MCP342x::oneShot, MCP342x::resolution16, 
-                          MCP342x::gain1, 1000000, value, status);
-  data.a3C2 = value;
+  if (++channel < QUAD_CHANNELS)
+  {
+    if (start_channel())
+      return false;
+    failed = true;
+  }
 
-  alpha_two.convertAndRead(MCP342x::channel3, MCP342x::oneShot, MCP342x::resolution16, 
-                          MCP342x::gain1, 1000000, value, status);
-  data.a4C1 = value;
+  channel = QUAD_CHANNELS;
+  return true;
+}
 
-  alpha_two.convertAndRead(MCP342x::channel4, MCP342x::oneShot, MCP342x::resolution16, 
-                          MCP342x::gain1, 1000000, value, status);
-  data.a4C2 = value;
+/**************************************************************************/
+ /*!
+ *    @brief  True if the last read got all eight channels; false if a
+ *            channel did not start, so some still hold the previous read
+ */
+/**************************************************************************/
+bool QUAD_Module::read_ok()
+{
+  return !failed;
+}
 
+quad_data QUAD_Module::return_last()
+{
   return data;
-}
\ No newline at end of file
+}
+
+/**************************************************************************/
+ /*!
+ *    @brief  Writes the channel's one-shot 16 bit config to both chips, then
+ *            one general call conversion starts them together
+ */
+/**************************************************************************/
+bool QUAD_Module::start_channel()
+{
+  MCP342x::Config config(*QUAD_CHANNEL[channel], MCP342x::oneShot,
+                         MCP342x::resolution16, MCP342x::gain1);
+
+  ready[0] = ready[1] = false;
+
+  if (!configure(alpha_one, config) || !configure(alpha_two, config))
+    return false;
+
+  started = millis();
+  uint32_t t = micros();
+  return i2c_bus.measured(QUAD_GENERAL_CALL, t, MCP342x::generalCallConversion() == 0) == I2C_OK;
+}
+
+/*! One chip's configure(), counted on the I2C bus stats */
+bool QUAD_Module::configure(const MCP342x &chip, const MCP342x::Config &config)
+{
+  uint32_t t = micros();
+  bool ok = chip.configure(config) == MCP342x::errorNone;
+  return i2c_bus.measured(chip.getAddress(), t, ok) == I2C_OK;
+}
@@ -17,6 +17,9 @@
 
 #define ALPHA_ONE_ADDR        (0x69)
 #define ALPHA_TWO_ADDR        (0x6E)
+#define QUAD_GENERAL_CALL     (0x00)  // reset & conversion start, both chips at once
+#define QUAD_CHANNELS         4   // MCP3424 channels per chip
+#define QUAD_CONVERSION_MS    68  // one-shot 16 bit conversion (15 SPS), +1 for millis() steps
 
 struct quad_data 
 {
@@ -29,11 +32,23 @@ class QUAD_Module
     QUAD_Module();
     bool begin();
     quad_data return_data();
+
+    bool start_read();
+    bool read_done();
+    bool read_ok();
+    quad_data return_last();
   private:
+    bool start_channel();
+    bool configure(const MCP342x &chip, const MCP342x::Config &config);
+
     MCP342x alpha_one;
     MCP342x alpha_two;
     quad_data data;
     bool status;
+    uint8_t channel;      // index of the channel both chips are converting
+    bool ready[2];        // alpha_one / alpha_two result read for that channel
+    uint32_t started;     // millis() when that channel's conversion began
+    bool failed;          // a channel did not start; the ones after it are stale
 };
 
 #endif  //_QUAD_Module_H
\ No newline at end of file
@@ -0,0 +1,136 @@
+/*******************************************************************************
+ * @file    record.cpp
+ * @brief   Single-pass RETIGO CSV line builder
+ *
+ * @cite    SdFat >> common/FmtNumber (fast integer & float formatting)
+ *
+ * @author  Percy Smith, percy.smith@colorado.edu
+ * @date    October 17, 2026
+ * @log     Numbers formatted straight into the line buffer
+******************************************************************************/
+#include "record.h"
+#include <SdFat.h>              //P - puts SdFat's common/ folder on the include path
+#include "common/FmtNumber.h"
+
+// Scratch space for one formatted number ("-4294967295.00" + margin)
+#define FMT_SCRATCH_SIZE      24
+
+Record::Record()
+{
+  clear();
+} //Record()
+
+void Record::clear()
+{
+  len = 0;
+  truncated = false;
+  buf[0] = '\0';
+} //void Record::clear()
+
+void Record::add(const char *str)
+{
+  append(str, strlen(str));
+} //void Record::add(const char *str)
+
+void Record::add(char c)
+{
+  append(&c, 1);
+} //void Record::add(char c)
+
+/**************************************************************************/
+ /*!
+ *    @brief  Unsigned integer field (uint16_t ADS counts, etc.)
+ */
+/**************************************************************************/
+void Record::add_uint(uint32_t value)
+{
+  char tmp[FMT_SCRATCH_SIZE];
+  char *end = tmp + sizeof(tmp);
+  char *str = fmtBase10(end, value);
+  append(str, end - str);
+} //void Record::add_uint(uint32_t value)
+
+/**************************************************************************/
+ /*!
+ *    @brief  Signed integer field (quadstat longs, calibrated ints)
+ */
+/**************************************************************************/
+void Record::add_int(int32_t value)
+{
+  char tmp[FMT_SCRATCH_SIZE];
+  char *end = tmp + sizeof(tmp);
+  char *str = fmtSigned(end, value, 10, false);
+  append(str, end - str);
+} //void Record::add_int(int32_t value)
+
+/**************************************************************************/
+ /*!
+ *    @brief  Float field; same rounding, "nan"/"inf"/"ovf" as Print::print()
+ *        @param  digits  digits after the decimal point (Print default = 2)
+ */
+/**************************************************************************/
+void Record::add_float(double value, uint8_t digits)
+{
+  char tmp[FMT_SCRATCH_SIZE];
+  char *end = tmp + sizeof(tmp);
+  char *str = fmtDouble(end, value, digits, false);
+  append(str, end - str);
+} //void Record::add_float(double value, uint8_t digits)
+
+void Record::sep()
+{
+  add(',');
+} //void Record::sep()
+
+/**************************************************************************/
+ /*!
+ *    @brief  Terminates the line; a truncated line still ends in '\n'
+ */
+/**************************************************************************/
+void Record::end()
+{
+  if (len > sizeof(buf) - 2)
+    len = sizeof(buf) - 2;
+  buf[len++] = '\n';
+  buf[len] = '\0';
+} //void Record::end()
+
+const char *Record::c_str()
+{
+  return buf;
+} //const char *Record::c_str()
+
+uint16_t Record::length()
+{
+  return len;
+} //uint16_t Record::length()
+
+bool Record::overflow()
+{
+  return truncated;
+} //bool Record::overflow()
+
+/**************************************************************************/
+ /*!
+ *    @brief  Sends the whole line to a sink in one write() call
+ *    @return Bytes accepted by the sink
+ */
+/**************************************************************************/
+size_t Record::write_to(Print &output)
+{
+  return output.write((const uint8_t *)buf, len);
+} //size_t Record::write_to(Print &output)
+
+void Record::append(const char *str, uint16_t n)
+{
+  // keep one byte for '\n' and one for '\0'
+  uint16_t room = (len < sizeof(buf) - 2) ? sizeof(buf) - 2 - len : 0;
+  if (n > room)
+  {
+    n = room;
+    truncated = true;
+  }
+  memcpy(buf + len, str, n);
+  len += n;
+  buf[len] = '\0';
+} //void Record::append(const char *str, uint16_t n)
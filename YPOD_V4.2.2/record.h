@@ -0,0 +1,71 @@
+/*******************************************************************************
+ * @file    record.h
+ * @brief   Builds one RETIGO CSV line in a fixed buffer so every sink (SD,
+ *          Serial) gets the same bytes in a single write
+ *
+ * @cite    SdFat >> common/FmtNumber (fast integer & float formatting)
+ *
+ * @author  Percy Smith, percy.smith@colorado.edu
+ * @date    October 17, 2026
+ * @log     Replaces per-field output.print() calls in printOutput()
+******************************************************************************/
+#ifndef _RECORD_H
+#define _RECORD_H
+
+#include <Arduino.h>
+
+#include "YPOD_node.h"
+
+// Longest line: timestamp, IDs, 17 data columns (+8 quadstat longs)
+#if QUAD_ENABLED
+#define RECORD_BUF_SIZE_BASE  240
+#else
+#define RECORD_BUF_SIZE_BASE  160
+#endif  //QUAD_ENABLED
+// (+5 ADS mean, std & count triplets)
+#if ADS_OVERSAMPLE
+#define RECORD_BUF_SIZE_ADS   (RECORD_BUF_SIZE_BASE + 96)
+#else
+#define RECORD_BUF_SIZE_ADS   RECORD_BUF_SIZE_BASE
+#endif  //ADS_OVERSAMPLE
+// (+PM extended mean & max per bin, frame count)
+#if PMS_ENABLED && PMS_EXTENDED
+#define RECORD_BUF_SIZE_PMS   (RECORD_BUF_SIZE_ADS + 12 * PMS_SUMMARY_BINS + 6)
+#else
+#define RECORD_BUF_SIZE_PMS   RECORD_BUF_SIZE_ADS
+#endif  //PMS_ENABLED && PMS_EXTENDED
+// (+PM frame age)
+#if PMS_ENABLED && PMS_AGE_COLUMN
+#define RECORD_BUF_SIZE       (RECORD_BUF_SIZE_PMS + 12)
+#else
+#define RECORD_BUF_SIZE       RECORD_BUF_SIZE_PMS
+#endif  //PMS_ENABLED && PMS_AGE_COLUMN
+
+/*! One CSV line; fields are formatted exactly like Print::print() would */
+class Record {
+  public:
+    Record();
+    void clear();
+
+    void add(const char *str);
+    void add(char c);
+    void add_uint(uint32_t value);
+    void add_int(int32_t value);
+    void add_float(double value, uint8_t digits = 2);
+    void sep();
+    void end();
+
+    const char *c_str();
+    uint16_t length();
+    bool overflow();
+    size_t write_to(Print &output);
+
+  private:
+    void append(const char *str, uint16_t n);
+
+    char buf[RECORD_BUF_SIZE];
+    uint16_t len;
+    bool truncated;
+};  //class Record
+
+#endif  //_RECORD_H
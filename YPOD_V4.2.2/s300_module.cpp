@@ -0,0 +1,190 @@
+/*******************************************************************************
+ * @file    s300_module.cpp
+ * @brief   Validated, non-blocking ELT S300 CO2 reads (see s300_module.h)
+ *
+ * @author  Percy Smith, percy.smith@colorado.edu
+ * @date    October 17, 2026
+ * @log     Reply checks & retries within the cycle's budget
+******************************************************************************/
+#include "s300_module.h"
+
+/*! Index: what txn is (or the module is waiting on) in a busy cycle */
+enum s300_phase_e
+{
+  S300_REQUEST = 0,     // 'R' queued
+  S300_WAITING,         // nothing queued until ready_at, then the read
+  S300_READING,         // reply read queued
+  S300_PAUSED           // after a failed attempt: 'R' again at ready_at
+};
+
+S300_Module::S300_Module()
+{
+  co2 = 0;
+  state = S300_NACK;  // nothing read yet
+  tries = 0;
+  started = 0;
+  ready_at = 0;
+  phase = S300_REQUEST;
+  txn.result = I2C_OK;
+}
+
+/**************************************************************************/
+ /*!
+ *    @brief  Keeps the S300 at S300_CLOCK_HZ whatever the bus runs at
+ */
+/**************************************************************************/
+void S300_Module::begin()
+{
+  i2c_bus.limit_clock(S300_ADDR, S300_CLOCK_HZ);
+}
+
+/**************************************************************************/
+ /*!
+ *    @brief  Queues the first 'R' of a cycle; never blocks
+ *    @return False if the bus queue is full (the cycle is over)
+ */
+/**************************************************************************/
+bool S300_Module::start_read()
+{
+  started = millis();
+  tries = 0;
+  state = S300_BUSY;
+  if (request())
+    return true;
+  state = S300_NACK;
+  return false;
+} //bool S300_Module::start_read()
+
+/**************************************************************************/
+ /*!
+ *    @brief  One step per call: 'R' sent, reply due, reply read; a failed
+ *            attempt is asked for again after S300_RETRY_MS while the
+ *            budget lasts
+ *    @return True when the cycle is over, status() says how it went
+ */
+/**************************************************************************/
+bool S300_Module::read_done()
+{
+  if (state != S300_BUSY)
+    return true;
+  if ((phase == S300_REQUEST || phase == S300_READING) &&
+      txn.result == I2C_PENDING)
+    return false;
+
+  if (phase == S300_REQUEST)
+  {
+    if (txn.result != I2C_OK)
+      return retry(S300_NACK);
+    ready_at = millis() + S300_RESPONSE_MS;  // from when the queue sent it
+    phase = S300_WAITING;
+    return false;
+  }
+
+  if ((int32_t)(millis() - ready_at) < 0)
+    return false;
+
+  if (phase == S300_PAUSED)
+    return request() ? false : retry(S300_NACK);
+  if (phase == S300_WAITING)
+    return fetch() ? false : retry(S300_NACK);
+
+  uint16_t ppm;
+  s300_status_e result = check(ppm);
+  if (result != S300_OK)
+    return retry(result);
+  co2 = ppm;
+  state = S300_OK;
+  return true;
+} //bool S300_Module::read_done()
+
+s300_status_e S300_Module::status()
+{
+  return state;
+}
+
+/**************************************************************************/
+ /*!
+ *    @brief  The last valid reading in ppm (0 before the first)
+ */
+/**************************************************************************/
+uint16_t S300_Module::return_last()
+{
+  return co2;
+}
+
+/**************************************************************************/
+ /*!
+ *    @brief  'R' requests sent in the last (or current) cycle
+ */
+/**************************************************************************/
+uint8_t S300_Module::attempts()
+{
+  return tries;
+}
+
+bool S300_Module::request()
+{
+  tries++;
+  cmd = S300_READ_CMD;
+  txn.addr = S300_ADDR;
+  txn.tx = &cmd;
+  txn.tx_len = 1;
+  txn.rx = NULL;
+  txn.rx_len = 0;
+  if (!i2c_bus.submit(txn))
+    return false;
+  phase = S300_REQUEST;
+  return true;
+} //bool S300_Module::request()
+
+/*! Queues one read of the whole reply */
+bool S300_Module::fetch()
+{
+  txn.tx_len = 0;
+  txn.rx = reply;
+  txn.rx_len = S300_REPLY_SIZE;
+  if (!i2c_bus.submit(txn))
+    return false;
+  phase = S300_READING;
+  return true;
+} //bool S300_Module::fetch()
+
+/**************************************************************************/
+ /*!
+ *    @brief  The reply that came back: length, status byte & range
+ */
+/**************************************************************************/
+s300_status_e S300_Module::check(uint16_t &ppm)
+{
+  if (txn.result != I2C_OK)
+    return S300_NACK;
+  if (txn.rx_got < S300_REPLY_SIZE)
+    return S300_SHORT;
+  if (reply[0] != S300_STATUS_NORMAL)
+    return S300_NOT_READY;
+
+  ppm = (uint16_t)reply[1] << 8 | reply[2];
+  if (ppm > S300_MAX_PPM)
+    return S300_RANGE;
+  return S300_OK;
+} //s300_status_e S300_Module::check(uint16_t &ppm)
+
+/**************************************************************************/
+ /*!
+ *    @brief  This attempt failed: again after a pause, unless that runs
+ *            past the budget
+ *    @return True if the cycle is over (with `result`)
+ */
+/**************************************************************************/
+bool S300_Module::retry(s300_status_e result)
+{
+  uint32_t due = millis() + S300_RETRY_MS;
+  if (due - started + S300_RESPONSE_MS > S300_BUDGET_MS)
+  {
+    state = result;
+    return true;
+  }
+  phase = S300_PAUSED;
+  ready_at = due;
+  return false;
+} //bool S300_Module::retry(s300_status_e result)
@@ -0,0 +1,78 @@
+/*******************************************************************************
+ * @file    s300_module.h
+ * @brief   ELT S300 CO2 over I2C without blocking: start_read() sends 'R'
+ *          (0x52), read_done() fetches the 7 byte reply once it is due and
+ *          checks its length, status byte & range. A failed attempt is sent
+ *          again after S300_RETRY_MS until S300_BUDGET_MS has passed; the
+ *          reading only replaces the last one when it checks out. Transfers
+ *          go through the i2c_bus queue (one step per loop() pass)
+ *
+ *          Reply: status, CO2 ppm (MSB, LSB), 4 bytes not used
+ *
+ * @author  Percy Smith, percy.smith@colorado.edu
+ * @date    October 17, 2026
+ * @log     Replaces getS300CO2() in the .ino
+******************************************************************************/
+#ifndef _S300_MODULE_H
+#define _S300_MODULE_H
+
+#include <Arduino.h>
+
+#include "i2c_bus.h"
+
+#define S300_ADDR             (0x31)
+#define S300_READ_CMD         (0x52)  // 'R'
+#define S300_REPLY_SIZE       7
+#define S300_STATUS_NORMAL    0x08    // status byte of a valid reading (not warming up)
+#define S300_MAX_PPM          10000   // widest S300 range; anything above is garbage
+#define S300_CLOCK_HZ         100000  // kept at the clock it has always run at
+
+// Timing - the scheduler polls in between, so none of these block
+#define S300_RESPONSE_MS      10      // 'R' to the reply being read
+#define S300_RETRY_MS         20      // after a failed attempt, before 'R' again
+#define S300_BUDGET_MS        200     // from start_read(): then the cycle fails
+
+/*! Index: S300_OK, S300_BUSY (waiting on the reply), S300_NACK (no ACK on
+ *  'R' or the read, or the bus got stuck), S300_SHORT (reply under 7
+ *  bytes), S300_NOT_READY (status byte not normal), S300_RANGE (ppm out of
+ *  range) */
+enum s300_status_e
+{
+  S300_OK = 0,
+  S300_BUSY,
+  S300_NACK,
+  S300_SHORT,
+  S300_NOT_READY,
+  S300_RANGE
+};  //enum s300_status_e
+
+class S300_Module
+{
+  public:
+    S300_Module();
+    void begin();
+
+    bool start_read();
+    bool read_done();
+    s300_status_e status();
+    uint16_t return_last();
+    uint8_t attempts();
+
+  private:
+    bool request();
+    bool fetch();
+    s300_status_e check(uint16_t &ppm);
+    bool retry(s300_status_e result);
+
+    uint16_t co2;         // last valid ppm
+    s300_status_e state;  // of the cycle in flight, else how the last one ended
+    uint8_t tries;        // attempts this cycle
+    uint32_t started;     // millis() at start_read()
+    uint32_t ready_at;    // millis() when the reply (or the retry) is due
+    uint8_t phase;        // s300_phase_e (.cpp), while busy
+    i2c_txn_t txn;        // on the bus queue
+    uint8_t cmd;          // txn's write ('R')
+    uint8_t reply[S300_REPLY_SIZE];
+};
+
+#endif  //_S300_MODULE_H
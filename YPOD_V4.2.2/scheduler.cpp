@@ -0,0 +1,199 @@
+/*******************************************************************************
+ * @file    scheduler.cpp
+ * @brief   Cooperative tick scheduler for sensor acquisition
+ *
+ * @author  Percy Smith, percy.smith@colorado.edu
+ * @date    October 17, 2026
+ * @log     Task steps, periods & the measured cycle time
+******************************************************************************/
+#include "scheduler.h"
+#include "profiler.h"
+
+Scheduler::Scheduler()
+{
+  count = 0;
+  record_period = 0;
+  last_record = 0;
+  last_cycle = 0;
+} //Scheduler()
+
+/**************************************************************************/
+ /*!
+ *    @brief  Registers a sensor task
+ *        @param  name    short label (used for diagnostics)
+ *        @param  period  ms between conversion starts (0 = every record)
+ *        @param  timeout ms a started task may poll before being abandoned
+ *    @return Task id, or -1 if the table is full
+ */
+/**************************************************************************/
+int8_t Scheduler::add(const char *name, uint32_t period, uint32_t timeout,
+                      task_start_t start, task_poll_t poll, task_collect_t collect)
+{
+  if (count >= SCHED_MAX_TASKS)
+    return -1;
+
+  sched_task_t *task = &tasks[count];
+  task->name = name;
+  task->period = period;
+  task->timeout = timeout;
+  task->start = start;
+  task->poll = poll;
+  task->collect = collect;
+  task->started = 0;
+  task->state = TASK_IDLE;
+  task->has_run = false;
+  task->fresh = false;
+  task->ok = false;
+
+  return count++;
+} //int8_t Scheduler::add(...)
+
+/**************************************************************************/
+ /*!
+ *    @brief  Minimum ms between records (0 = as fast as the sensors allow)
+ */
+/**************************************************************************/
+void Scheduler::set_record_period(uint32_t period)
+{
+  record_period = period;
+} //void Scheduler::set_record_period(uint32_t period)
+
+/**************************************************************************/
+ /*!
+ *    @brief  One scheduler tick; never blocks on its own. Starts due tasks,
+ *            polls busy ones and collects whatever has finished
+ */
+/**************************************************************************/
+void Scheduler::run()
+{
+  for (uint8_t i = 0; i < count; i++)
+  {
+    sched_task_t *task = &tasks[i];
+    uint32_t now = millis();
+
+    // Finished tasks wait for the record so every column comes from one cycle
+    if (task->state == TASK_IDLE && (task->fresh || !task_due(task, now)))
+      continue;
+
+    PROF_START(PROF_TASK + i);
+    step(task, now);
+    PROF_STOP(PROF_TASK + i);
+  }
+} //void Scheduler::run()
+
+/**************************************************************************/
+ /*!
+ *    @brief  Starts an idle task that is due, or polls a busy one and
+ *            collects it once finished (or drops it on timeout)
+ */
+/**************************************************************************/
+void Scheduler::step(sched_task_t *task, uint32_t now)
+{
+  if (task->state == TASK_IDLE)
+  {
+    task->started = now;
+    task->has_run = true;
+    if (task->start())
+    {
+      task->state = TASK_BUSY;
+    }
+    else
+    {
+      task->fresh = true;
+      task->ok = false;
+    }
+  }
+  else if (task->poll())
+  {
+    task->collect();
+    task->state = TASK_IDLE;
+    task->fresh = true;
+    task->ok = true;
+  }
+  else if (now - task->started >= task->timeout)
+  {
+    task->state = TASK_IDLE;
+    task->fresh = true;
+    task->ok = false;
+  }
+} //void Scheduler::step(sched_task_t *task, uint32_t now)
+
+/**************************************************************************/
+ /*!
+ *    @brief  True when every task is either finished for this cycle or
+ *            not due yet (keeps its last value) and the record period passed
+ */
+/**************************************************************************/
+bool Scheduler::record_ready()
+{
+  uint32_t now = millis();
+
+  if (now - last_record < record_period)
+    return false;
+
+  for (uint8_t i = 0; i < count; i++)
+  {
+    sched_task_t *task = &tasks[i];
+    if (task->state == TASK_BUSY)
+      return false;
+    if (!task->fresh && task_due(task, now))
+      return false;
+  }
+
+  return true;
+} //bool Scheduler::record_ready()
+
+/**************************************************************************/
+ /*!
+ *    @brief  Marks the current record written and opens the next cycle
+ */
+/**************************************************************************/
+void Scheduler::record_done()
+{
+  uint32_t now = millis();
+
+  last_cycle = now - last_record;
+  last_record = now;
+
+  for (uint8_t i = 0; i < count; i++)
+    tasks[i].fresh = false;
+} //void Scheduler::record_done()
+
+bool Scheduler::task_ok(int8_t id)
+{
+  if (id < 0 || id >= count)
+    return false;
+
+  return tasks[id].ok;
+} //bool Scheduler::task_ok(int8_t id)
+
+uint8_t Scheduler::task_count()
+{
+  return count;
+} //uint8_t Scheduler::task_count()
+
+const sched_task_t *Scheduler::task(int8_t id)
+{
+  if (id < 0 || id >= count)
+    return NULL;
+
+  return &tasks[id];
+} //const sched_task_t *Scheduler::task(int8_t id)
+
+/**************************************************************************/
+ /*!
+ *    @brief  ms between the last two records (one full sampling cycle)
+ */
+/**************************************************************************/
+uint32_t Scheduler::cycle_time()
+{
+  return last_cycle;
+} //uint32_t Scheduler::cycle_time()
+
+bool Scheduler::task_due(sched_task_t *task, uint32_t now)
+{
+  if (!task->has_run)
+    return true;
+
+  return (now - task->started >= task->period);
+} //bool Scheduler::task_due(sched_task_t *task, uint32_t now)
@@ -0,0 +1,79 @@
+/*******************************************************************************
+ * @file    scheduler.h
+ * @brief   Cooperative tick scheduler for sensor acquisition. Each sensor is a
+ *          task with its own period and a start/poll/collect state machine so
+ *          conversions overlap instead of running back to back with delay()s
+ *
+ * @cite    YPOD_V4.2.2.ino >> loop() (the delay()-paced read sequence)
+ *
+ * @author  Percy Smith, percy.smith@colorado.edu
+ * @date    October 17, 2026
+ * @log     Replaces the delay(100) chain in loop()
+******************************************************************************/
+#ifndef _SCHEDULER_H
+#define _SCHEDULER_H
+
+#include <Arduino.h>
+
+#define SCHED_MAX_TASKS       8
+
+/*! Task start: kicks off a conversion. Return false to skip this cycle */
+typedef bool (*task_start_t)();
+/*! Task poll: returns true once the conversion has finished */
+typedef bool (*task_poll_t)();
+/*! Task collect: pulls the finished result into the record data */
+typedef void (*task_collect_t)();
+
+/*! Index: TASK_IDLE (waiting on period), TASK_BUSY (started, polling) */
+enum task_state_e
+{
+  TASK_IDLE = 0,
+  TASK_BUSY
+};  //enum task_state_e
+
+/*! (per each sensor) callbacks, timing & state */
+struct sched_task_t
+{
+  const char *name;
+  uint32_t period;          // ms between starts (0 = every record)
+  uint32_t timeout;         // ms a BUSY task may poll before it is abandoned
+  task_start_t start;
+  task_poll_t poll;
+  task_collect_t collect;
+  uint32_t started;         // millis() at the last start
+  task_state_e state;
+  bool has_run;             // started at least once since boot
+  bool fresh;               // finished (or failed) since the last record
+  bool ok;                  // last finished cycle produced data
+};  //struct sched_task_t
+
+/*! Runs every task's state machine once per run(); a record is ready when
+ *  every due task has finished, so the cycle is set by the slowest sensor */
+class Scheduler {
+  public:
+    Scheduler();
+    int8_t add(const char *name, uint32_t period, uint32_t timeout,
+               task_start_t start, task_poll_t poll, task_collect_t collect);
+    void set_record_period(uint32_t period);
+
+    void run();
+    bool record_ready();
+    void record_done();
+
+    bool task_ok(int8_t id);
+    uint8_t task_count();
+    const sched_task_t *task(int8_t id);
+    uint32_t cycle_time();
+
+  private:
+    bool task_due(sched_task_t *task, uint32_t now);
+    void step(sched_task_t *task, uint32_t now);
+
+    sched_task_t tasks[SCHED_MAX_TASKS];
+    uint8_t count;
+    uint32_t record_period;
+    uint32_t last_record;
+    uint32_t last_cycle;
+};  //class Scheduler
+
+#endif  //_SCHEDULER_H
@@ -0,0 +1,203 @@
+/*******************************************************************************
+ * @file    schema.cpp
+ * @brief   Column schema: header row, CSV line & binary record from the
+ *          table (see schema.h)
+ *
+ * @author  Percy Smith, percy.smith@colorado.edu
+ * @date    October 17, 2026
+ * @log     Header row, CSV line & binary record from one table
+******************************************************************************/
+#include "schema.h"
+
+/**************************************************************************/
+ /*!
+ *    @param  columns  the table, in PROGMEM
+ */
+/**************************************************************************/
+Schema::Schema(const column_t *columns, uint8_t count)
+{
+  table = columns;
+  n = count;
+} //Schema()
+
+uint8_t Schema::count()
+{
+  return n;
+} //uint8_t Schema::count()
+
+/*! Copies column `index` out of flash */
+void Schema::column(uint8_t index, column_t &out)
+{
+  memcpy_P(&out, &table[index], sizeof(out));
+} //void Schema::column(uint8_t index, column_t &out)
+
+/**************************************************************************/
+ /*!
+ *    @brief  False if the column's flag is not in this record's flags (its
+ *            sensor had nothing this cycle); unflagged columns always are
+ */
+/**************************************************************************/
+bool Schema::present(const column_t &c, uint16_t flags)
+{
+  return c.flag == 0 || (flags & COL_FLAG(c.flag));
+} //bool Schema::present(const column_t &c, uint16_t flags)
+
+/**************************************************************************/
+ /*!
+ *    @brief  The column's variable as an integer (a uint32_t keeps its bits)
+ */
+/**************************************************************************/
+int32_t Schema::integer(const column_t &c)
+{
+  if (c.kind & COL_REAL)
+    return (int32_t)real(c);
+
+  bool sign = c.kind & COL_SIGNED;
+  switch (c.kind & 0x0F)
+  {
+    case 1:
+      return sign ? *(const int8_t *)c.value : *(const uint8_t *)c.value;
+    case 2:
+      return sign ? *(const int16_t *)c.value : *(const uint16_t *)c.value;
+    case 4:
+      return sign ? *(const int32_t *)c.value : (int32_t)*(const uint32_t *)c.value;
+    case 8:
+      return (int32_t)*(const int64_t *)c.value;  // host `long`
+  }
+  return 0;
+} //int32_t Schema::integer(const column_t &c)
+
+/*! The column's variable as a double */
+double Schema::real(const column_t &c)
+{
+  if (!(c.kind & COL_REAL))
+    return (c.kind & COL_SIGNED) ? (double)integer(c) : (double)(uint32_t)integer(c);
+  if ((c.kind & 0x0F) == sizeof(float))
+    return *(const float *)c.value;
+  return *(const double *)c.value;
+} //double Schema::real(const column_t &c)
+
+/**************************************************************************/
+ /*!
+ *    @brief  RETIGO header row: "name(unit)," per column (no "()" if the
+ *            unit is ""), then '\n'; schema_header_length() bytes
+ */
+/**************************************************************************/
+void Schema::print_header(Print &out)
+{
+  column_t c;
+  for (uint8_t i = 0; i < n; i++)
+  {
+    column(i, c);
+    out.write((const uint8_t *)c.name, strlen(c.name));
+    if (c.unit[0])
+    {
+      out.write('(');
+      out.write((const uint8_t *)c.unit, strlen(c.unit));
+      out.write(')');
+    }
+    out.write(',');
+  }
+  out.write('\n');
+} //void Schema::print_header(Print &out)
+
+/**************************************************************************/
+ /*!
+ *    @brief  One CSV line (no '\n'): each column then ','; blank if its
+ *            flag is not in `flags`
+ *        @param  time  the timestamp text
+ */
+/**************************************************************************/
+void Schema::format(Record &record, uint16_t flags, const char *time)
+{
+  column_t c;
+  for (uint8_t i = 0; i < n; i++)
+  {
+    column(i, c);
+    if (present(c, flags))
+    {
+      switch (c.type)
+      {
+        case BIN_TIME:
+          record.add(time);
+          break;
+        case BIN_POD_ID:
+        case BIN_FIRMWARE:
+          record.add((const char *)c.value);
+          break;
+        case BIN_U16:
+        case BIN_U32:
+          record.add_uint((uint32_t)integer(c));
+          break;
+        case BIN_I16:
+        case BIN_I32:
+          record.add_int(integer(c));
+          break;
+        case BIN_F32:
+          record.add_float(real(c));
+          break;
+        case BIN_I16_F:
+        case BIN_I32_F:
+          record.add_float(integer(c));
+          break;
+      }
+    }
+    record.sep();
+  }
+} //void Schema::format(...)
+
+/**************************************************************************/
+ /*!
+ *    @brief  The same columns as a binary record; flagged values are
+ *            written either way, the flags say which ones to print
+ *        @param  offset  s after the file's base_time
+ */
+/**************************************************************************/
+void Schema::encode(BinRecord &record, uint16_t flags, uint32_t offset)
+{
+  column_t c;
+
+  record.clear();
+  for (uint8_t f = 1; f <= BIN_FLAGS; f++)
+    if (flags & COL_FLAG(f))
+      record.set_flag(f);
+
+  for (uint8_t i = 0; i < n; i++)
+  {
+    column(i, c);
+    switch (c.type)
+    {
+      case BIN_TIME:
+        record.add_time(offset);
+        break;
+      case BIN_POD_ID:
+      case BIN_FIRMWARE:
+        record.add_text(c.type);
+        break;
+      case BIN_U16:
+        record.add_u16(integer(c), c.flag);
+        break;
+      case BIN_I16:
+        record.add_i16(integer(c), c.flag);
+        break;
+      case BIN_U32:
+        record.add_u32(integer(c), c.flag);
+        break;
+      case BIN_I32:
+        record.add_i32(integer(c), c.flag);
+        break;
+      case BIN_F32:
+        record.add_f32(real(c), c.flag);
+        break;
+      case BIN_I16_F:
+        record.add_i16_f(integer(c), c.flag);
+        break;
+      case BIN_I32_F:
+        record.add_i32_f(integer(c), c.flag);
+        break;
+      default:
+        record.blank();
+    }
+  }
+  record.end();
+} //void Schema::encode(...)
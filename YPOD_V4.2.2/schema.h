@@ -0,0 +1,123 @@
+/*******************************************************************************
+ * @file    schema.h
+ * @brief   Column schema: one constexpr table (in flash) lists every
+ *          RETIGO column with its name, unit, binary type, presence flag
+ *          and the variable it prints. The CSV header row, the CSV line, the
+ *          binary record and the summary channels are all generated from
+ *          it, so they cannot drift apart
+ *
+ *          The sketch builds the table with the COL_* macros below. Sizes
+ *          (columns, binary record, header row) are constexpr, so a table
+ *          that outgrows BIN_MAX_COLUMNS or BIN_RECORD_SIZE is a
+ *          static_assert, not a truncated file
+ *
+ * @author  Percy Smith, percy.smith@colorado.edu
+ * @date    October 17, 2026
+ * @log     Replaces the hand-written columns in buildRecord(),
+ *          buildBinRecord() & the aggregation channel list
+******************************************************************************/
+#ifndef _SCHEMA_H
+#define _SCHEMA_H
+
+#include <Arduino.h>
+
+#include "record.h"
+#include "binlog.h"
+
+#define COL_NAME_SIZE         16
+#define COL_UNIT_SIZE         6
+
+// Value kinds: the variable's size in the low bits, then these
+#define COL_SIGNED            0x10
+#define COL_REAL              0x20
+
+// Bit of a record's presence flags for column flag n (1..BIN_FLAGS)
+#define COL_FLAG(n)           (1u << ((n) - 1))
+
+// `int` columns at the sketch's own width (16 bit on AVR), like add_int()
+#define BIN_INT               (sizeof(int) == sizeof(int16_t) ? BIN_I16 : BIN_I32)
+#define BIN_INT_F             (sizeof(int) == sizeof(int16_t) ? BIN_I16_F : BIN_I32_F)
+
+/*! One column. flag n > 0: blank unless bit n-1 of the record's presence
+ *  flags is set (as in binlog.h); summary: one of the aggregated channels */
+struct column_t
+{
+  char name[COL_NAME_SIZE];
+  char unit[COL_UNIT_SIZE];   // "" leaves "(unit)" off the header
+  uint8_t type;               // bin_col_e
+  uint8_t flag;
+  uint8_t kind;               // col_kind(): how to read value
+  bool summary;
+  const void *value;          // NULL for BIN_BLANK & BIN_TIME, text for the IDs
+};  //struct column_t
+
+/*! Value kind of a variable: size, signed, floating point */
+template <typename T>
+constexpr uint8_t col_kind(const T *)
+{
+  return sizeof(T) | ((T)-1 < (T)0 ? COL_SIGNED : 0) | ((T)0.5 != (T)0 ? COL_REAL : 0);
+}
+
+// Table entries
+#define COL(name, unit, type, flag, summary, var) \
+  { name, unit, (uint8_t)(type), flag, col_kind(&(var)), summary, &(var) }
+#define COL_BLANK(name, unit)   { name, unit, BIN_BLANK, 0, 0, false, NULL }
+#define COL_TIME(name, unit)    { name, unit, BIN_TIME, 0, 0, false, NULL }
+#define COL_TEXT(name, unit, type, text) \
+  { name, unit, type, 0, 0, false, text }
+
+/*! Bytes a column type takes in a binary record */
+constexpr uint8_t bin_col_size(uint8_t type)
+{
+  return type == BIN_TIME || type == BIN_U32 || type == BIN_I32 || type == BIN_F32 || type == BIN_I32_F ? 4
+       : type == BIN_U16 || type == BIN_I16 || type == BIN_I16_F ? 2
+       : 0;
+}
+
+constexpr uint16_t col_text_length(const char *text)
+{
+  return *text ? 1 + col_text_length(text + 1) : 0;
+}
+
+/*! Binary record bytes: sync & flags, then the columns */
+constexpr uint16_t schema_record_size(const column_t *columns, uint8_t count)
+{
+  return count ? bin_col_size(columns[0].type) + schema_record_size(columns + 1, count - 1) : 3;
+}
+
+/*! CSV header row bytes: "name(unit)," per column, then '\n' */
+constexpr uint16_t schema_header_length(const column_t *columns, uint8_t count)
+{
+  return count ? col_text_length(columns[0].name) + 1 +
+                   (columns[0].unit[0] ? col_text_length(columns[0].unit) + 2 : 0) +
+                   schema_header_length(columns + 1, count - 1)
+               : 1;
+}
+
+/*! Aggregated channels */
+constexpr uint8_t schema_summaries(const column_t *columns, uint8_t count)
+{
+  return count ? (columns[0].summary ? 1 : 0) + schema_summaries(columns + 1, count - 1) : 0;
+}
+
+/*! Reads a table in flash (PROGMEM) and turns records into CSV & binary */
+class Schema {
+  public:
+    Schema(const column_t *columns, uint8_t count);
+
+    uint8_t count();
+    void column(uint8_t index, column_t &out);
+    static bool present(const column_t &c, uint16_t flags);
+    static int32_t integer(const column_t &c);
+    static double real(const column_t &c);
+
+    void print_header(Print &out);
+    void format(Record &record, uint16_t flags, const char *time);
+    void encode(BinRecord &record, uint16_t flags, uint32_t offset);
+
+  private:
+    const column_t *table;
+    uint8_t n;
+};  //class Schema
+
+#endif  //_SCHEMA_H
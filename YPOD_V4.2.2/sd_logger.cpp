@@ -0,0 +1,608 @@
+/*******************************************************************************
+ * @file    sd_logger.cpp
+ * @brief   Persistent SD logging session: appends go through SdFat's sector
+ *          cache into a preallocated, contiguous daily file
+ *
+ * @cite    SdFat >> RingBuf.h, examples/RingBuf, examples/ExFatLogger
+ *
+ * @author  Percy Smith, percy.smith@colorado.edu
+ * @date    October 17, 2026
+ * @log     Open-once session, preallocated daily file & the
+ *          midnight roll in steps
+******************************************************************************/
+#include "sd_logger.h"
+
+/*! Erased SD sectors read back as all 0x00 or all 0xFF - never CSV text,
+ *  never a binary record's first byte */
+static bool is_erased(int c)
+{
+  return c == 0x00 || c == 0xFF;
+}
+
+/**************************************************************************/
+ /*!
+ *    @brief  True if the file ends in erased bytes, i.e. it still holds a
+ *            preallocated extent that was never truncated (power cut). A
+ *            binary file may also end in a 0x00/0xFF data byte; find_end()
+ *            then gives back its full size
+ */
+/**************************************************************************/
+static bool tail_erased(File &f)
+{
+  if (f.fileSize() == 0 || !f.seekSet(f.fileSize() - 1))
+    return false;
+
+  return is_erased(f.read());
+}
+
+/**************************************************************************/
+ /*!
+ *    @brief  Finds the end of the logged data in an untruncated extent by a
+ *            binary search for the first erased record. A LOG_BINARY file
+ *            (binlog.h) is its header then fixed-size records that each
+ *            start with BIN_SYNC; a CSV file is searched byte by byte
+ *    @return Length of the real data in bytes
+ */
+/**************************************************************************/
+static uint32_t find_end(File &f)
+{
+  binlog_header_t h;
+  uint32_t head = 0;
+  uint32_t unit = 1;
+
+  if (f.seekSet(0) && f.read(&h, sizeof(h)) == (int)sizeof(h) &&
+      memcmp(h.magic, BIN_MAGIC, sizeof(h.magic)) == 0 &&
+      h.record_size > 0 && h.header_size <= f.fileSize())
+  {
+    head = h.header_size;
+    unit = h.record_size;
+  }
+
+  uint32_t lo = 0;
+  uint32_t hi = (f.fileSize() - head + unit - 1) / unit;
+
+  while (lo < hi)
+  {
+    uint32_t mid = lo + (hi - lo) / 2;
+    f.seekSet(head + mid * unit);
+    if (is_erased(f.read()))
+      hi = mid;
+    else
+      lo = mid + 1;
+  }
+
+  uint32_t pos = head + lo * unit;
+  return pos < f.fileSize() ? pos : f.fileSize();
+}
+
+SD_Logger::SD_Logger()
+{
+  name[0] = '\0';
+  cs = 0;
+  contiguous = false;
+  rb_pos = 0;
+  pending = NULL;
+  rolling = LOG_ROLL_NONE;
+  extent = 0;
+  erase_next = 1;
+  erase_last = 0;
+  unsynced = 0;
+  last_flush = 0;
+  errors = 0;
+  reinits = 0;
+  dropped = 0;
+} //SD_Logger()
+
+/**************************************************************************/
+ /*!
+ *    @brief  Initialises the card and opens (creates) the log file; the file
+ *            stays open for the whole run. Boot is not loop() time: older
+ *            days' files a power cut left untruncated are trimmed and a new
+ *            file's extent is erased whole, here
+ *        @param  cs_pin    SD chip select
+ *        @param  file_name "YPODID_YYYY_MM_DD.CSV"
+ *        @param  header    prints what a file with no data yet starts with
+ *                          (CSV header row, LOG_BINARY file header)
+ *    @return True if the card is up and the file is open
+ */
+/**************************************************************************/
+bool SD_Logger::begin(uint8_t cs_pin, const char *file_name, log_writer_t header)
+{
+  cs = cs_pin;
+
+  if (!sd.begin(cs))
+    return false;
+
+  rb.begin(&file);
+  last_flush = millis();
+#if LOG_PREALLOCATE
+  trim_stale(file_name);
+#endif  //LOG_PREALLOCATE
+  if (!open_file(file_name))
+    return false;
+
+  while (erase_step())
+    ;
+  if (rb_pos == 0 && header)
+    return start_file(header);
+  return true;
+} //bool SD_Logger::begin(...)
+
+/**************************************************************************/
+ /*!
+ *    @brief  Writes one record into the file. SdFat's cache writes each
+ *            sector as it fills; the file is synced per LOG_FLUSH_RECORDS /
+ *            LOG_FLUSH_MS. Bytes the card refused stay in the ring
+ *    @return False if the record was dropped or the card reported an error
+ */
+/**************************************************************************/
+bool SD_Logger::append(const char *buf, uint16_t len)
+{
+  if (rb.bytesFree() < len)
+    write_out();
+
+  if (rb.bytesFree() < len)
+  {
+    // card is down and the staging buffer is full
+    dropped++;
+    return false;
+  }
+
+  rb.write(buf, len);
+  unsynced++;
+
+  bool ok = write_out();
+  if (!rolling && (unsynced >= LOG_FLUSH_RECORDS || millis() - last_flush >= LOG_FLUSH_MS))
+    ok = flush() && ok;
+
+  return ok;
+} //bool SD_Logger::append(const char *buf, uint16_t len)
+
+/**************************************************************************/
+ /*!
+ *    @brief  Writes the cached partial sector and syncs the directory
+ *            entry; a roll still in progress is finished first. Call
+ *            before sleep or power-down
+ */
+/**************************************************************************/
+bool SD_Logger::flush()
+{
+  while (rolling)
+    run();
+
+  bool ok = write_out() && commit();
+
+  if (!ok)
+  {
+    errors++;
+    ok = recover() && commit();
+  }
+
+  unsynced = 0;
+  last_flush = millis();
+  return ok;
+} //bool SD_Logger::flush()
+
+/**************************************************************************/
+ /*!
+ *    @brief  Flushes, cuts a preallocated extent back to the data actually
+ *            written and closes the file
+ */
+/**************************************************************************/
+void SD_Logger::end()
+{
+  flush();
+
+  if (contiguous)
+    file.truncate(rb_pos + rb.bytesUsed());
+
+  file.close();
+  rb.begin(&file);
+  rb_pos = 0;
+  pending = NULL;
+  contiguous = false;
+  erase_next = 1;
+  erase_last = 0;
+} //void SD_Logger::end()
+
+/**************************************************************************/
+ /*!
+ *    @brief  Finishes the current file (flush, truncate, close) and queues
+ *            the next one, e.g. the new day's file at midnight. run() opens
+ *            it on the next pass; records appended until then are staged
+ */
+/**************************************************************************/
+void SD_Logger::roll(const char *file_name, log_writer_t header)
+{
+  end();
+
+  strncpy(name, file_name, sizeof(name) - 1);
+  name[sizeof(name) - 1] = '\0';
+  pending = header;
+  rolling = LOG_ROLL_OPEN;
+} //void SD_Logger::roll(...)
+
+/**************************************************************************/
+ /*!
+ *    @brief  One bounded step of a roll() per loop() pass: open and
+ *            preallocate the new file; then erase its first chunk, write
+ *            its header and the records staged meanwhile; then erase the
+ *            rest of the extent, LOG_ERASE_SECTORS per call
+ *    @return False if the new file did not open; append() creates it,
+ *            header first, once the card answers again
+ */
+/**************************************************************************/
+bool SD_Logger::run()
+{
+  if (rolling == LOG_ROLL_OPEN)
+  {
+    if (open_file(name))
+    {
+      rolling = LOG_ROLL_START;
+      return true;
+    }
+
+    errors++;
+    file.close();
+    rolling = LOG_ROLL_NONE;
+    return false;
+  }
+
+  erase_step();
+  if (rolling == LOG_ROLL_START)
+  {
+    log_writer_t header = pending;
+    pending = NULL;
+    rolling = LOG_ROLL_NONE;
+    if (rb_pos == 0 && header && !start_file(header))
+      errors++;
+    write_out();
+  }
+  return true;
+} //bool SD_Logger::run()
+
+/**************************************************************************/
+ /*!
+ *    @brief  True while run() has a roll step or an erase chunk left
+ */
+/**************************************************************************/
+bool SD_Logger::busy()
+{
+  return rolling || erase_next <= erase_last;
+} //bool SD_Logger::busy()
+
+/**************************************************************************/
+ /*!
+ *    @brief  Appends to another file on the card (e.g. a summary file). It is
+ *            opened, written by `writer` and closed in this call, so the
+ *            daily log stays the only file held open
+ *        @param  writer  prints the data; new_file is true for an empty file
+ *    @return False if the file did not open or a write failed
+ */
+/**************************************************************************/
+bool SD_Logger::write_file(const char *file_name, log_writer_t writer)
+{
+  File side;
+  bool ok = side.open(file_name, O_WRONLY | O_CREAT | O_APPEND);
+
+  if (ok)
+  {
+    writer(side, side.fileSize() == 0);
+    ok = !side.getWriteError();
+    ok = side.close() && ok;
+  }
+  if (!ok)
+    errors++;
+  return ok;
+} //bool SD_Logger::write_file(const char *file_name, log_writer_t writer)
+
+/**************************************************************************/
+ /*!
+ *    @brief  Streams a whole file into `reader` (a parser such as
+ *            CalReader) in LOG_READ_CHUNK pieces; false if it is missing
+ *            or a read fails
+ */
+/**************************************************************************/
+bool SD_Logger::read_file(const char *file_name, Print &reader)
+{
+  File in;
+  uint8_t chunk[LOG_READ_CHUNK];
+  int n;
+
+  if (!in.open(file_name, O_RDONLY))
+    return false;
+  while ((n = in.read(chunk, sizeof(chunk))) > 0)
+    reader.write(chunk, n);
+  in.close();
+  return n == 0;
+} //bool SD_Logger::read_file(const char *file_name, Print &reader)
+
+bool SD_Logger::is_open()
+{
+  return file.isOpen();
+} //bool SD_Logger::is_open()
+
+bool SD_Logger::is_contiguous()
+{
+  return contiguous;
+} //bool SD_Logger::is_contiguous()
+
+/**************************************************************************/
+ /*!
+ *    @brief  Bytes logged to the current file (written + staged)
+ */
+/**************************************************************************/
+uint32_t SD_Logger::size()
+{
+  return rb_pos + rb.bytesUsed();
+} //uint32_t SD_Logger::size()
+
+uint16_t SD_Logger::error_count()
+{
+  return errors;
+} //uint16_t SD_Logger::error_count()
+
+uint16_t SD_Logger::reinit_count()
+{
+  return reinits;
+} //uint16_t SD_Logger::reinit_count()
+
+uint16_t SD_Logger::dropped_count()
+{
+  return dropped;
+} //uint16_t SD_Logger::dropped_count()
+
+/**************************************************************************/
+ /*!
+ *    @brief  Opens a daily file. A new file gets a full-day extent, still
+ *            to be erased (erase_step()) before its header goes in; an
+ *            existing one (reboot on the same day) resumes at its real end
+ */
+/**************************************************************************/
+bool SD_Logger::open_file(const char *file_name)
+{
+  if (file_name != name)
+  {
+    strncpy(name, file_name, sizeof(name) - 1);
+    name[sizeof(name) - 1] = '\0';
+  }
+  contiguous = false;
+
+  // no O_APPEND: writes go to rb_pos inside the extent, not to fileSize()
+  if (!file.open(name, O_RDWR | O_CREAT))
+    return false;
+
+  uint32_t end = file.fileSize();
+#if LOG_PREALLOCATE
+  if (end == 0)
+  {
+    if (!preallocate())
+      return false;
+  }
+  else if (tail_erased(file))
+  {
+    // left over from a power cut; keep the extent and carry on inside it
+    end = find_end(file);
+    contiguous = true;
+  }
+#endif  //LOG_PREALLOCATE
+
+  if (!file.seekSet(end))
+    return false;
+  rb_pos = end;
+  return true;
+} //bool SD_Logger::open_file(const char *file_name)
+
+/**************************************************************************/
+ /*!
+ *    @brief  Allocates LOG_DAY_BYTES of contiguous clusters. erase_step()
+ *            then erases them so the end of data can be found again after
+ *            a power cut. Falls back to a normally growing file if either
+ *            step fails
+ */
+/**************************************************************************/
+bool SD_Logger::preallocate()
+{
+  uint32_t bgn, end;
+
+  rb_pos = 0;
+  if (!file.preAllocate(LOG_DAY_BYTES))
+    return true;
+
+  if (!file.contiguousRange(&bgn, &end))
+  {
+    file.truncate(0);
+    return file.isOpen();
+  }
+
+  extent = bgn;
+  erase_next = bgn;
+  erase_last = end;
+
+  // a real seek clears SdFat's preallocate flag: each new sector is then
+  // read into the cache before the first record goes in, so the bytes past
+  // the data stay erased instead of holding the cache's old contents
+  contiguous = true;
+  return file.seekSet(LOG_SECTOR_SIZE) && file.seekSet(0);
+} //bool SD_Logger::preallocate()
+
+/**************************************************************************/
+ /*!
+ *    @brief  Erases the extent's next LOG_ERASE_SECTORS, so one call
+ *            holds the card for one chunk's erase (the first one covers
+ *            any file header).
+ *            If the card refuses, the file is cut to what is written and
+ *            grows normally from there: unerased sectors could hold old
+ *            data that looks like CSV
+ *    @return False if there was nothing left to erase or the erase failed
+ */
+/**************************************************************************/
+bool SD_Logger::erase_step()
+{
+  if (erase_next > erase_last)
+    return false;
+
+  uint32_t last = extent + ((erase_next - extent) | (LOG_ERASE_SECTORS - 1));
+  if (last > erase_last)
+    last = erase_last;
+
+  if (!sd.card()->erase(erase_next, last))
+  {
+    errors++;
+    erase_next = erase_last + 1;
+    contiguous = false;
+    file.truncate(rb_pos);
+    return false;
+  }
+
+  erase_next = last + 1;
+  return true;
+} //bool SD_Logger::erase_step()
+
+/**************************************************************************/
+ /*!
+ *    @brief  Prints a new file's header straight into the file
+ *    @return False if the card refused it
+ */
+/**************************************************************************/
+bool SD_Logger::start_file(log_writer_t header)
+{
+  file.clearWriteError();
+  header(file, true);
+  rb_pos = file.curPosition();
+  return !file.getWriteError();
+} //bool SD_Logger::start_file(log_writer_t header)
+
+/**************************************************************************/
+ /*!
+ *    @brief  rb.writeOut() that keeps rb_pos in step with the file
+ */
+/**************************************************************************/
+size_t SD_Logger::put(size_t n)
+{
+  size_t written = rb.writeOut(n);
+  rb_pos += written;
+  return written;
+} //size_t SD_Logger::put(size_t n)
+
+/**************************************************************************/
+ /*!
+ *    @brief  Moves everything staged into the file (SdFat's cache)
+ *    @return False on a short write (unwritten bytes stay staged)
+ */
+/**************************************************************************/
+bool SD_Logger::drain()
+{
+  if (!file.isOpen())
+    return false;
+
+  // a record never lands on sectors that still hold old card data
+  while (erase_next <= erase_last &&
+         extent + (rb_pos + rb.bytesUsed()) / LOG_SECTOR_SIZE >= erase_next)
+    erase_step();
+
+  size_t used = rb.bytesUsed();
+  return put(used) == used;
+} //bool SD_Logger::drain()
+
+/**************************************************************************/
+ /*!
+ *    @brief  drain() with one card re-initialisation on a write error
+ */
+/**************************************************************************/
+bool SD_Logger::write_out()
+{
+  if (rolling)
+    return true;    // run() opens the new file; the record waits in the ring
+
+  if (drain())
+    return true;
+
+  errors++;
+  return recover() && drain();
+} //bool SD_Logger::write_out()
+
+/**************************************************************************/
+ /*!
+ *    @brief  Writes what is staged and syncs; the cached partial sector
+ *            stays in the cache for the next record
+ */
+/**************************************************************************/
+bool SD_Logger::commit()
+{
+  return drain() && file.sync();
+} //bool SD_Logger::commit()
+
+/**************************************************************************/
+ /*!
+ *    @brief  Re-initialises the card and re-opens the file at rb_pos, or
+ *            starts the file roll() could not open. Only called after an
+ *            actual write/sync error
+ */
+/**************************************************************************/
+bool SD_Logger::recover()
+{
+  reinits++;
+  file.close();
+
+  if (!sd.begin(cs))
+    return false;
+  if (!file.open(name, O_RDWR | O_CREAT))
+    return false;
+
+  if (pending)
+  {
+    log_writer_t header = pending;
+    pending = NULL;
+    if (file.fileSize() == 0)
+      return start_file(header);
+    file.seekEnd();
+    rb_pos = file.curPosition();
+    return true;
+  }
+
+  if (!file.seekSet(rb_pos))
+  {
+    // directory entry never saw the last writes; continue from its end
+    file.seekEnd();
+    rb_pos = file.curPosition();
+  }
+
+  return true;
+} //bool SD_Logger::recover()
+
+/**************************************************************************/
+ /*!
+ *    @brief  Truncates this pod's older daily files that still carry an
+ *            erased extent (power was cut before end() ran); `file_name`,
+ *            today's, is left to open_file()
+ */
+/**************************************************************************/
+void SD_Logger::trim_stale(const char *file_name)
+{
+  File dir;
+  File entry;
+  char entry_name[LOG_NAME_SIZE];
+  const char *underscore = strchr(file_name, '_');
+  size_t prefix = underscore ? underscore - file_name + 1 : 0;
+
+  if (!prefix || !dir.open("/"))
+    return;
+
+  while (entry.openNext(&dir, O_RDONLY))
+  {
+    entry.getName(entry_name, sizeof(entry_name));
+    bool stale = !entry.isDir() && strncmp(entry_name, file_name, prefix) == 0 &&
+                 strcmp(entry_name, file_name) != 0 && tail_erased(entry);
+    uint32_t end = stale ? find_end(entry) : 0;
+    entry.close();
+
+    if (stale && entry.open(entry_name, O_RDWR))
+    {
+      entry.truncate(end);
+      entry.close();
+    }
+  }
+
+  dir.close();
+} //void SD_Logger::trim_stale()
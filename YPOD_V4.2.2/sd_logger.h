@@ -0,0 +1,133 @@
+/*******************************************************************************
+ * @file    sd_logger.h
+ * @brief   Persistent SD logging session: card is initialised once, the daily
+ *          file stays open and each record goes straight into SdFat's
+ *          512-byte sector cache, so the card still sees whole sectors
+ *          instead of one small write per record. Each new daily file is
+ *          preallocated as one contiguous, erased extent sized for a full
+ *          day, then truncated to its real length. roll() swaps to the next
+ *          day's file without a card re-init, in steps run() resumes on the
+ *          following loop() passes: close the old file, open & preallocate
+ *          the new one, then erase its extent LOG_ERASE_SECTORS at a time.
+ *          Records wait in the ring meanwhile
+ *
+ *          RAM (ATmega328P, default CSV build with PMS, the column schema
+ *          and I2C stats; AVR sizes of the members, not an avr-size run):
+ *            SdFat sd     ~608 B  sector cache 523, FAT volume + cwd 64,
+ *                                 SPI card 21
+ *            File file      44 B
+ *            ring          205 B  LOG_RECORD_SIZE 160 + LOG_RING_BUF_SIZE 32
+ *                                 + 13 (512 B more when it staged a sector)
+ *            the rest       61 B  name, counters, roll & erase state
+ *          ~918 B of the 2048, next to Serial (157), record (163), I2C
+ *          stats (152) and Wire (~200). The IDE's "Global variables use"
+ *          line is the number to check after changing these
+ *
+ * @cite    SdFat >> RingBuf.h, examples/RingBuf, examples/ExFatLogger
+ *
+ * @author  Percy Smith, percy.smith@colorado.edu
+ * @date    October 17, 2026
+ * @log     Sectors assembled in SdFat's cache; ring cut to one record
+******************************************************************************/
+#ifndef _SD_LOGGER_H
+#define _SD_LOGGER_H
+
+#include <Arduino.h>
+#include <SdFat.h>    //P - last tested with "SdFat@2.2.3"
+#include <RingBuf.h>
+
+#include "YPOD_node.h"
+#include "record.h"
+#include "binlog.h"
+
+#define LOG_SECTOR_SIZE       512
+#define LOG_NAME_SIZE         28    // "YPODID_YYYY_MM_DD.CSV" (or .BIN, or _15M.CSV) + '\0'
+#define LOG_READ_CHUNK        32    // stack buffer of read_file()
+
+// Longest record the file sees
+#if LOG_BINARY
+#define LOG_RECORD_SIZE       BIN_RECORD_SIZE
+#else
+#define LOG_RECORD_SIZE       RECORD_BUF_SIZE
+#endif  //LOG_BINARY
+
+// SdFat's cache assembles the sectors, so the ring only holds a record the
+// card has not taken yet
+#define LOG_RB_SIZE           (LOG_RECORD_SIZE + LOG_RING_BUF_SIZE)
+
+// One day of records at the configured rate, each at the longest line length
+#if SLEEP_ENABLED
+#define LOG_DAY_RECORDS       (86400UL / SLEEP_PERIOD_S)
+#elif RECORD_PERIOD_MS > 0
+#define LOG_DAY_RECORDS       (86400000UL / RECORD_PERIOD_MS)
+#else
+#define LOG_DAY_RECORDS       (86400000UL / LOG_EXPECTED_PERIOD_MS)
+#endif  //SLEEP_ENABLED
+#define LOG_DAY_BYTES         (LOG_DAY_RECORDS * LOG_RECORD_SIZE)
+
+/*! Prints a whole side file's data (write_file()), or a daily file's header
+ *  (begin(), roll()); new_file: write the header first */
+typedef void (*log_writer_t)(Print &out, bool new_file);
+
+/*! Index: LOG_ROLL_NONE, LOG_ROLL_OPEN (next run() opens the new file),
+ *  LOG_ROLL_START (next run() erases its first chunk & writes its header) */
+enum log_roll_e
+{
+  LOG_ROLL_NONE = 0,
+  LOG_ROLL_OPEN,
+  LOG_ROLL_START
+};  //enum log_roll_e
+
+/*! SD card + open log file + RAM staging buffer for one record */
+class SD_Logger {
+  public:
+    SD_Logger();
+    bool begin(uint8_t cs_pin, const char *file_name, log_writer_t header = NULL);
+    bool append(const char *buf, uint16_t len);
+    bool flush();
+    void end();
+    void roll(const char *file_name, log_writer_t header = NULL);
+    bool run();
+    bool busy();
+    bool write_file(const char *file_name, log_writer_t writer);
+    bool read_file(const char *file_name, Print &reader);
+
+    bool is_open();
+    bool is_contiguous();
+    uint32_t size();
+    uint16_t error_count();
+    uint16_t reinit_count();
+    uint16_t dropped_count();
+
+  private:
+    bool open_file(const char *file_name);
+    bool preallocate();
+    bool erase_step();
+    bool start_file(log_writer_t header);
+    size_t put(size_t n);
+    bool drain();
+    bool write_out();
+    bool commit();
+    bool recover();
+    void trim_stale(const char *file_name);
+
+    SdFat sd;
+    File file;
+    RingBuf<File, LOG_RB_SIZE> rb;
+    char name[LOG_NAME_SIZE];
+    uint8_t cs;
+    bool contiguous;        // file is a preallocated extent (truncate on end())
+    uint32_t rb_pos;        // file offset of the first byte staged in rb
+    log_writer_t pending;   // header of a file roll() has not started yet
+    uint8_t rolling;        // log_roll_e: the roll step run() does next
+    uint32_t extent;        // first card sector of the preallocated file
+    uint32_t erase_next;    // its next card sector to erase...
+    uint32_t erase_last;    // ...up to here (erase_next > erase_last: done)
+    uint16_t unsynced;      // records staged or written since the last flush
+    uint32_t last_flush;    // millis() at the last flush
+    uint16_t errors;        // failed writes/syncs
+    uint16_t reinits;       // card re-initialisations after an error
+    uint16_t dropped;       // records lost because the card stayed down
+};  //class SD_Logger
+
+#endif  //_SD_LOGGER_H
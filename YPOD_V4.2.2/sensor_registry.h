@@ -0,0 +1,82 @@
+/*******************************************************************************
+ * @file    sensor_registry.h
+ * @brief   Compile-time sensor registry. A sensor driver is a struct of
+ *          static functions:
+ *
+ *            begin()            once in setup()
+ *            tick()             every loop() pass (serial drains)
+ *            start() poll() collect()   its scheduler task
+ *
+ *          plus name(), PERIOD_MS & TIMEOUT_MS for the task. SensorList<>
+ *          of the drivers calls each one in turn: the calls are resolved
+ *          (and inlined) at compile time, no virtuals. A sensor switched
+ *          off in YPOD_node.h is NoSensor - none of its code is built. The
+ *          columns a sensor fills are in the column schema (schema.h)
+ *
+ * @author  Percy Smith, percy.smith@colorado.edu
+ * @date    October 17, 2026
+ * @log     Replaces the per-sensor #if blocks in setup(), loop() &
+ *          buildRecord()
+******************************************************************************/
+#ifndef _SENSOR_REGISTRY_H
+#define _SENSOR_REGISTRY_H
+
+#include <Arduino.h>
+
+#include "scheduler.h"
+
+/*! Defaults for the optional parts of a driver; derive and hide the rest */
+struct SensorDriver
+{
+  static const bool TASK = true;  // has a scheduler task
+  static void begin() {}
+  static void tick() {}
+};  //struct SensorDriver
+
+/*! A sensor that is not fitted: no task */
+struct NoSensor : SensorDriver
+{
+  static const bool TASK = false;
+  static const uint32_t PERIOD_MS = 0;
+  static const uint32_t TIMEOUT_MS = 0;
+  static const char *name() { return ""; }
+  static bool start() { return false; }
+  static bool poll() { return true; }
+  static void collect() {}
+};  //struct NoSensor
+
+/*! The drivers, in task order */
+template <typename... Drivers>
+struct SensorList
+{
+  static void begin() {}
+  static void tick() {}
+  static void add_tasks(Scheduler &scheduler) { (void)scheduler; }
+};  //struct SensorList
+
+template <typename Driver, typename... Rest>
+struct SensorList<Driver, Rest...>
+{
+  static void begin()
+  {
+    Driver::begin();
+    SensorList<Rest...>::begin();
+  }
+
+  static void tick()
+  {
+    Driver::tick();
+    SensorList<Rest...>::tick();
+  }
+
+  /*! Tasks start in list order each cycle */
+  static void add_tasks(Scheduler &scheduler)
+  {
+    if (Driver::TASK)
+      scheduler.add(Driver::name(), Driver::PERIOD_MS, Driver::TIMEOUT_MS,
+                    Driver::start, Driver::poll, Driver::collect);
+    SensorList<Rest...>::add_tasks(scheduler);
+  }
+};  //struct SensorList<Driver, Rest...>
+
+#endif  //_SENSOR_REGISTRY_H
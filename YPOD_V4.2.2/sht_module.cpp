@@ -0,0 +1,210 @@
+/*******************************************************************************
+ * @file    sht_module.cpp
+ * @brief   Non-blocking SHT2x T & RH with CRC & status checks (see
+ *          sht_module.h)
+ *
+ * @author  Percy Smith, percy.smith@colorado.edu
+ * @date    October 17, 2026
+ * @log     No-hold T & RH through the I2C queue, CRC checked
+******************************************************************************/
+#include "sht_module.h"
+
+/*! Index: what txn is (or the module is waiting on) in a busy cycle */
+enum sht_phase_e
+{
+  SHT_COMMAND = 0,      // measurement command queued
+  SHT_CONVERTING,       // nothing queued until ready_at
+  SHT_READING           // result read queued
+};
+
+SHT_Module::SHT_Module()
+{
+  data.temperature = 0;
+  data.humidity = 0;
+  state = SHT_TIMEOUT;  // nothing read yet
+  humidity = false;
+  phase = SHT_COMMAND;
+  raw_t = 0;
+  ready_at = 0;
+  txn.result = I2C_OK;
+}
+
+/**************************************************************************/
+ /*!
+ *    @brief  Queues the temperature conversion (no hold); never blocks
+ *    @return False if the bus queue is full
+ */
+/**************************************************************************/
+bool SHT_Module::start_read()
+{
+  humidity = false;
+  if (!command(SHT_T_NO_HOLD))
+  {
+    finish(SHT_NACK);
+    return false;
+  }
+  state = SHT_BUSY;
+  return true;
+} //bool SHT_Module::start_read()
+
+/**************************************************************************/
+ /*!
+ *    @brief  One step per call: command sent, conversion due, result read
+ *            (a NACK means not yet); a clean T starts RH
+ *    @return True when the cycle is over, status() says how it went
+ */
+/**************************************************************************/
+bool SHT_Module::read_done()
+{
+  if (state != SHT_BUSY)
+    return true;
+  if (phase != SHT_CONVERTING && txn.result == I2C_PENDING)
+    return false;
+
+  if (phase == SHT_COMMAND)
+  {
+    if (txn.result != I2C_OK)
+    {
+      finish(txn.result == I2C_TIMEOUT ? SHT_TIMEOUT : SHT_NACK);
+      return true;
+    }
+    // the conversion started when the queue sent the command, at most a
+    // loop() pass ago; millis() may tick right after it
+    ready_at = millis() + (cmd == SHT_RH_NO_HOLD ? SHT_RH_MS : SHT_T_MS) + 1;
+    phase = SHT_CONVERTING;
+    return false;
+  }
+
+  if (phase == SHT_CONVERTING)
+  {
+    if ((int32_t)(millis() - ready_at) < 0)
+      return false;
+    if (fetch())
+      return false;
+    finish(SHT_NACK);
+    return true;
+  }
+
+  uint16_t raw;
+  sht_status_e result = check(raw);
+  if (result == SHT_BUSY)
+  {
+    if (millis() - ready_at < SHT_TIMEOUT_MS)
+    {
+      phase = SHT_CONVERTING;  // read again on the next call
+      return false;
+    }
+    result = SHT_TIMEOUT;
+  }
+  if (result != SHT_OK)
+  {
+    finish(result);
+    return true;
+  }
+
+  if (!humidity)
+  {
+    raw_t = raw;
+    humidity = true;
+    if (command(SHT_RH_NO_HOLD))
+      return false;
+    finish(SHT_NACK);
+    return true;
+  }
+
+  data.temperature = ((175.72 * (float)raw_t) / (65536)) - 46.85;
+  data.humidity = ((125 * (float)raw) / (65536)) - 6.00;
+  finish(SHT_OK);
+  return true;
+} //bool SHT_Module::read_done()
+
+sht_status_e SHT_Module::status()
+{
+  return state;
+}
+
+/**************************************************************************/
+ /*!
+ *    @brief  The last pair that came in clean (0 before the first)
+ */
+/**************************************************************************/
+sht_data SHT_Module::return_last()
+{
+  return data;
+}
+
+/**************************************************************************/
+ /*!
+ *    @brief  SHT2x CRC-8: polynomial 0x31, initial 0, no reflection
+ */
+/**************************************************************************/
+uint8_t SHT_Module::crc8(const uint8_t *bytes, uint8_t len)
+{
+  uint8_t crc = 0;
+  for (uint8_t i = 0; i < len; i++)
+  {
+    crc ^= bytes[i];
+    for (uint8_t bit = 0; bit < 8; bit++)
+      crc = (crc & 0x80) ? (crc << 1) ^ 0x31 : (crc << 1);
+  }
+  return crc;
+} //uint8_t SHT_Module::crc8(const uint8_t *bytes, uint8_t len)
+
+/**************************************************************************/
+ /*!
+ *    @brief  Queues a measurement command; its result is due the conversion
+ *            time after it has been sent
+ */
+/**************************************************************************/
+bool SHT_Module::command(uint8_t code)
+{
+  cmd = code;
+  txn.addr = SHT_ADDR;
+  txn.tx = &cmd;
+  txn.tx_len = 1;
+  txn.rx = NULL;
+  txn.rx_len = 0;
+  if (!i2c_bus.submit(txn))
+    return false;
+  phase = SHT_COMMAND;
+  return true;
+} //bool SHT_Module::command(uint8_t code)
+
+/*! Queues one read attempt of the result */
+bool SHT_Module::fetch()
+{
+  txn.tx_len = 0;
+  txn.rx = frame;
+  txn.rx_len = sizeof(frame);
+  if (!i2c_bus.submit(txn))
+    return false;
+  phase = SHT_READING;
+  return true;
+} //bool SHT_Module::fetch()
+
+/**************************************************************************/
+ /*!
+ *    @brief  The read that came back: MSB, LSB (2 status bits) & CRC
+ *    @return SHT_BUSY while the sensor NACKs, else the frame's checks
+ */
+/**************************************************************************/
+sht_status_e SHT_Module::check(uint16_t &raw)
+{
+  if (txn.result == I2C_TIMEOUT)
+    return SHT_TIMEOUT;
+  if (txn.result != I2C_OK)
+    return SHT_BUSY;
+  if (txn.rx_got < sizeof(frame) || crc8(frame, 2) != frame[2])
+    return SHT_CRC;
+  if (((frame[1] & SHT_STATUS_RH) != 0) != humidity)
+    return SHT_STALE;
+
+  raw = ((uint16_t)frame[0] << 8 | frame[1]) & 0xFFFC;
+  return SHT_OK;
+} //sht_status_e SHT_Module::check(uint16_t &raw)
+
+void SHT_Module::finish(sht_status_e result)
+{
+  state = result;
+  humidity = false;
+}
@@ -0,0 +1,81 @@
+/*******************************************************************************
+ * @file    sht_module.h
+ * @brief   SHT2x (SHT25) temperature & humidity without holding the bus: the
+ *          no-hold-master commands start a conversion and the sensor NACKs
+ *          its address until the result is in, so read_done() polls while
+ *          the other sensors keep the I2C bus. Transfers go through the
+ *          i2c_bus queue (one step per loop() pass). Every result's CRC-8 and
+ *          status bits are checked; only a clean T & RH pair replaces the
+ *          last one
+ *
+ * @cite    Sensirion, "Datasheet SHT25", v4 (commands, timing, status bits)
+ * @cite    Sensirion, "CRC Checksum Calculation for SHT2x" (x^8+x^5+x^4+1)
+ *
+ * @author  Percy Smith, percy.smith@colorado.edu
+ * @date    October 17, 2026
+ * @log     Replaces the hold-master read_wire() in the .ino
+******************************************************************************/
+#ifndef _SHT_MODULE_H
+#define _SHT_MODULE_H
+
+#include <Arduino.h>
+
+#include "i2c_bus.h"
+
+#define SHT_ADDR              (0x40)
+#define SHT_T_NO_HOLD         (0xF3)
+#define SHT_RH_NO_HOLD        (0xF5)
+#define SHT_T_MS              85    // max conversion time, 14 bit T
+#define SHT_RH_MS             29    // max conversion time, 12 bit RH
+#define SHT_TIMEOUT_MS        50    // NACKs past the conversion time before giving up
+#define SHT_STATUS_RH         0x02  // result LSB status bit: set on RH, clear on T
+
+/*! Index: SHT_OK, SHT_BUSY (converting), SHT_NACK (command not taken),
+ *  SHT_CRC (corrupted or short result), SHT_STALE (not the measurement
+ *  asked for), SHT_TIMEOUT (no result in time, or the bus got stuck) */
+enum sht_status_e
+{
+  SHT_OK = 0,
+  SHT_BUSY,
+  SHT_NACK,
+  SHT_CRC,
+  SHT_STALE,
+  SHT_TIMEOUT
+};  //enum sht_status_e
+
+struct sht_data
+{
+  float temperature;    // C
+  float humidity;       // %RH
+};
+
+class SHT_Module
+{
+  public:
+    SHT_Module();
+
+    bool start_read();
+    bool read_done();
+    sht_status_e status();
+    sht_data return_last();
+
+    static uint8_t crc8(const uint8_t *bytes, uint8_t len);
+
+  private:
+    bool command(uint8_t code);
+    bool fetch();
+    sht_status_e check(uint16_t &raw);
+    void finish(sht_status_e result);
+
+    sht_data data;        // last clean pair
+    sht_status_e state;   // of the cycle in flight, or the last one
+    bool humidity;        // RH conversion in flight (else T)
+    uint8_t phase;        // sht_phase_e (.cpp), while busy
+    uint16_t raw_t;       // this cycle's T, kept until RH is in
+    uint32_t ready_at;    // millis() when the conversion is due
+    i2c_txn_t txn;        // on the bus queue
+    uint8_t cmd;          // txn's write
+    uint8_t frame[3];     // txn's read: MSB, LSB (2 status bits), CRC
+};
+
+#endif  //_SHT_MODULE_H
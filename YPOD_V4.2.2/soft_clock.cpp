@@ -0,0 +1,318 @@
+/*******************************************************************************
+ * @file    soft_clock.cpp
+ * @brief   RTC-disciplined software clock driven by the DS3231 1 Hz SQW
+ *
+ * @author  Percy Smith, percy.smith@colorado.edu
+ * @date    October 17, 2026
+ * @log     SQW edges, RTC resync & digit-by-digit timestamp text
+******************************************************************************/
+#include "soft_clock.h"
+
+static SoftClock *sqw_clock;    // the clock attachInterrupt() feeds
+
+static void sqw_isr()
+{
+  sqw_clock->sqw_edge();
+}
+
+static uint8_t days_in_month(uint16_t year, uint8_t month)
+{
+  static const uint8_t days[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+
+  if (month == 2 && year % 4 == 0 && (year % 100 != 0 || year % 400 == 0))
+    return 29;
+  return days[month - 1];
+}
+
+/*! Adds one to a two-digit text field, touching only the digits that change */
+static void inc2(char *p)
+{
+  if (p[1] != '9')
+  {
+    p[1]++;
+  }
+  else
+  {
+    p[1] = '0';
+    p[0]++;
+  }
+}
+
+SoftClock::SoftClock()
+{
+  read = NULL;
+  pin = -1;
+  sqw = false;
+  polled = false;
+  level = HIGH;
+  edges = 0;
+  edge_ms = 0;
+  synced_ms = 0;
+  slips = 0;
+  unix = 0;
+  strcpy(buf, "2000-01-01T00:00:00");
+  set(946684800UL);
+} //SoftClock()
+
+/**************************************************************************/
+ /*!
+ *    @brief  Starts the clock: waits for a first SQW edge (the RTC seconds
+ *            have just advanced), then reads the RTC once
+ *        @param  read_rtc  reads the DS3231 (set to 1 Hz SQW beforehand)
+ *        @param  sqw_pin   pin the SQW output is wired to, -1 if none
+ *    @return False if no edge came in: the RTC is then read per update()
+ */
+/**************************************************************************/
+bool SoftClock::begin(clock_read_t read_rtc, int8_t sqw_pin)
+{
+  read = read_rtc;
+  pin = sqw_pin;
+  edges = 0;
+
+  if (pin >= 0)
+  {
+    pinMode(pin, INPUT_PULLUP);  // SQW is open drain
+    level = digitalRead(pin);
+    int irq = digitalPinToInterrupt(pin);
+    polled = irq == NOT_AN_INTERRUPT;
+    if (!polled)
+    {
+      sqw_clock = this;
+      attachInterrupt(irq, sqw_isr, FALLING);
+    }
+
+    uint32_t start = millis();
+    while (edges == 0 && millis() - start < CLOCK_SQW_WAIT_MS)
+    {
+      poll();
+      delay(1);
+    }
+  }
+
+  sqw = edges > 0;
+  edges = 0;
+  set(read());
+  synced_ms = millis();
+  return sqw;
+} //bool SoftClock::begin(clock_read_t read_rtc, int8_t sqw_pin)
+
+/**************************************************************************/
+ /*!
+ *    @brief  Watches the SQW pin for a falling edge; call every loop() tick.
+ *            Nothing to do when the pin has an interrupt
+ */
+/**************************************************************************/
+void SoftClock::poll()
+{
+  if (!polled)
+    return;
+
+  uint8_t now = digitalRead(pin);
+  if (level == HIGH && now == LOW)
+    sqw_edge();
+  level = now;
+} //void SoftClock::poll()
+
+/**************************************************************************/
+ /*!
+ *    @brief  One SQW falling edge: the RTC's seconds register just advanced
+ */
+/**************************************************************************/
+void SoftClock::sqw_edge()
+{
+  edges++;
+  edge_ms = millis();
+} //void SoftClock::sqw_edge()
+
+/**************************************************************************/
+ /*!
+ *    @brief  Brings the time up to date before it is used: applies the
+ *            edges counted since the last call, and reads the RTC back
+ *            every RTC_RESYNC_MS (or every call once the SQW is lost)
+ */
+/**************************************************************************/
+void SoftClock::update()
+{
+  noInterrupts();
+  uint8_t n = edges;
+  uint32_t last = edge_ms;
+  edges = 0;
+  interrupts();
+
+  while (n--)
+    advance();
+
+  if (sqw && millis() - last > CLOCK_SQW_TIMEOUT_MS)
+    sqw = false;
+
+  if (!sqw)
+  {
+    set(read());
+    synced_ms = millis();
+    return;
+  }
+
+  // early in the second only, so an edge not yet seen cannot skew the check
+  if (millis() - synced_ms >= RTC_RESYNC_MS && millis() - last < 500)
+  {
+    uint32_t rtc = read();
+    synced_ms = millis();
+    if (edges == 0 && rtc != unix)
+    {
+      slips++;
+      set(rtc);
+    }
+  }
+} //void SoftClock::update()
+
+/**************************************************************************/
+ /*!
+ *    @brief  Sets the time; a short step forward is counted up digit by
+ *            digit, anything else re-formats the whole text
+ */
+/**************************************************************************/
+void SoftClock::set(uint32_t unixtime)
+{
+  if (unixtime > unix && unixtime - unix <= CLOCK_STEP_MAX)
+  {
+    while (unix != unixtime)
+      advance();
+    return;
+  }
+
+  // civil_from_days (H. Hinnant), unsigned since the epoch is 1970
+  uint32_t days = unixtime / 86400UL;
+  uint32_t secs = unixtime % 86400UL;
+  uint32_t z = days + 719468UL;
+  uint32_t era = z / 146097UL;
+  uint32_t doe = z - era * 146097UL;
+  uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  uint32_t mp = (5 * doy + 2) / 153;
+
+  day = doy - (153 * mp + 2) / 5 + 1;
+  month = mp < 10 ? mp + 3 : mp - 9;
+  year = yoe + era * 400 + (month <= 2);
+  hour = secs / 3600;
+  minute = secs / 60 % 60;
+  second = secs % 60;
+  unix = unixtime;
+  format();
+} //void SoftClock::set(uint32_t unixtime)
+
+/**************************************************************************/
+ /*!
+ *    @brief  Picks the count up after a power-down, when millis() and the
+ *            square wave both stood still
+ *        @param  unixtime  the second that has just begun (the RTC alarm
+ *                          that woke the MCU)
+ */
+/**************************************************************************/
+void SoftClock::restart(uint32_t unixtime)
+{
+  noInterrupts();
+  edges = 0;
+  edge_ms = millis();
+  interrupts();
+
+  if (pin >= 0)
+    level = digitalRead(pin);
+  synced_ms = millis();
+  set(unixtime);
+} //void SoftClock::restart(uint32_t unixtime)
+
+uint32_t SoftClock::unixtime()
+{
+  return unix;
+} //uint32_t SoftClock::unixtime()
+
+/**************************************************************************/
+ /*!
+ *    @brief  "YYYY-MM-DDThh:mm:ss" as of the last update()
+ */
+/**************************************************************************/
+const char *SoftClock::text()
+{
+  return buf;
+} //const char *SoftClock::text()
+
+bool SoftClock::has_sqw()
+{
+  return sqw;
+} //bool SoftClock::has_sqw()
+
+uint16_t SoftClock::slip_count()
+{
+  return slips;
+} //uint16_t SoftClock::slip_count()
+
+/**************************************************************************/
+ /*!
+ *    @brief  One second on; a field's text is only rewritten on a carry
+ */
+/**************************************************************************/
+void SoftClock::advance()
+{
+  unix++;
+
+  if (++second < 60)
+  {
+    inc2(&buf[17]);
+    return;
+  }
+  second = 0;
+  put(17, 0, 2);
+
+  if (++minute < 60)
+  {
+    inc2(&buf[14]);
+    return;
+  }
+  minute = 0;
+  put(14, 0, 2);
+
+  if (++hour < 24)
+  {
+    inc2(&buf[11]);
+    return;
+  }
+  hour = 0;
+  put(11, 0, 2);
+
+  if (++day <= days_in_month(year, month))
+  {
+    inc2(&buf[8]);
+    return;
+  }
+  day = 1;
+  put(8, 1, 2);
+
+  if (++month <= 12)
+  {
+    inc2(&buf[5]);
+    return;
+  }
+  month = 1;
+  put(5, 1, 2);
+  put(0, ++year, 4);
+} //void SoftClock::advance()
+
+void SoftClock::format()
+{
+  put(0, year, 4);
+  put(5, month, 2);
+  put(8, day, 2);
+  put(11, hour, 2);
+  put(14, minute, 2);
+  put(17, second, 2);
+} //void SoftClock::format()
+
+/*! Writes `value` as `digits` zero-padded digits at buf[pos] */
+void SoftClock::put(uint8_t pos, uint16_t value, uint8_t digits)
+{
+  for (uint8_t i = digits; i > 0; i--)
+  {
+    buf[pos + i - 1] = '0' + value % 10;
+    value /= 10;
+  }
+} //void SoftClock::put(uint8_t pos, uint16_t value, uint8_t digits)
@@ -0,0 +1,71 @@
+/*******************************************************************************
+ * @file    soft_clock.h
+ * @brief   RTC-disciplined software clock: the DS3231 is read once at boot,
+ *          then each falling edge of its 1 Hz SQW output advances the time
+ *          by one second. The "YYYY-MM-DDThh:mm:ss" text is kept up to date
+ *          digit by digit
+ *
+ *          The edge comes in on an external interrupt if the pin has one;
+ *          otherwise (the YPOD: pins 2 & 3 carry the PMS SoftwareSerial)
+ *          poll() samples the pin from loop(). Every RTC_RESYNC_MS the
+ *          DS3231 registers are read back to catch missed edges, and with
+ *          no SQW at all the registers are read on every update()
+ *
+ * @cite    Maxim DS3231 datasheet >> Control Register (INTCN, RS1/RS2), SQW
+ *
+ * @author  Percy Smith, percy.smith@colorado.edu
+ * @date    October 17, 2026
+ * @log     Replaces RTC.now() + sprintf() per record
+******************************************************************************/
+#ifndef _SOFT_CLOCK_H
+#define _SOFT_CLOCK_H
+
+#include <Arduino.h>
+
+#include "YPOD_node.h"
+
+#define CLOCK_TEXT_SIZE       20    // "YYYY-MM-DDThh:mm:ss" + '\0'
+#define CLOCK_SQW_WAIT_MS     1100  // begin() waits this long for a first edge
+#define CLOCK_SQW_TIMEOUT_MS  2500  // no edge for this long: SQW lost, read the RTC
+#define CLOCK_STEP_MAX        60    // set() forward by up to this many s digit by digit
+
+/*! Reads the RTC: unixtime of its time registers (an I2C burst read) */
+typedef uint32_t (*clock_read_t)();
+
+class SoftClock {
+  public:
+    SoftClock();
+    bool begin(clock_read_t read_rtc, int8_t sqw_pin);
+    void poll();
+    void update();
+    void set(uint32_t unixtime);
+    void restart(uint32_t unixtime);
+    void sqw_edge();
+
+    uint32_t unixtime();
+    const char *text();
+    bool has_sqw();
+    uint16_t slip_count();
+
+  private:
+    void advance();
+    void format();
+    void put(uint8_t pos, uint16_t value, uint8_t digits);
+
+    clock_read_t read;
+    int8_t pin;
+    bool sqw;                   // edges are arriving
+    bool polled;                // pin has no interrupt: poll() watches it
+    uint8_t level;              // pin level at the last poll()
+    volatile uint8_t edges;     // seconds counted since the last update()
+    volatile uint32_t edge_ms;  // millis() at the last edge
+    uint32_t synced_ms;         // millis() at the last RTC read
+    uint16_t slips;             // RTC reads that disagreed (missed edges)
+
+    uint32_t unix;
+    uint16_t year;
+    uint8_t month, day, hour, minute, second;
+    char buf[CLOCK_TEXT_SIZE];
+};  //class SoftClock
+
+#endif  //_SOFT_CLOCK_H
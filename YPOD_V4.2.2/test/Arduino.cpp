@@ -0,0 +1,60 @@
+#include "Arduino.h"
+
+unsigned long cpu_time;
+int sim_sqw_pin = -1;
+int sim_irq_pin = -1;
+static void (*sqw_isr)();
+
+unsigned long millis()
+{
+    return cpu_time / 1000;
+}
+
+unsigned long micros()
+{
+    return cpu_time;
+}
+
+void delay(unsigned long ms)
+{
+    sim_advance(ms * 1000);
+}
+
+void delayMicroseconds(unsigned long us)
+{
+    sim_advance(us);
+}
+
+// Runs the SQW interrupt at each whole second passed, with the clock set to it
+void sim_advance(unsigned long us)
+{
+    unsigned long end = cpu_time + us;
+    while (sqw_isr && sim_irq_pin >= 0 && sim_irq_pin == sim_sqw_pin
+           && (cpu_time / 1000000 + 1) * 1000000 <= end) {
+        cpu_time = (cpu_time / 1000000 + 1) * 1000000;
+        sqw_isr();
+    }
+    cpu_time = end;
+}
+
+int digitalRead(uint8_t pin)
+{
+    if (pin == sim_sqw_pin)
+        return cpu_time % 1000000 < 500000 ? LOW : HIGH;
+    return HIGH;
+}
+
+int digitalPinToInterrupt(uint8_t pin)
+{
+    return pin == sim_irq_pin ? 0 : NOT_AN_INTERRUPT;
+}
+
+void attachInterrupt(uint8_t, void (*isr)(), int)
+{
+    sqw_isr = isr;
+}
+
+void detachInterrupt(uint8_t)
+{
+    sqw_isr = 0;
+}
@@ -0,0 +1,79 @@
+/*******************************************************************************
+ * @file    Arduino.h
+ * @brief   Host stand-in for the Arduino core; virtual clock only
+ *
+ * @cite    libraries/MCP342x/test (same fake-core approach)
+******************************************************************************/
+#ifndef _FAKE_ARDUINO_H
+#define _FAKE_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+
+#define sq(x) ((x)*(x))
+
+inline uint16_t makeWord(uint8_t h, uint8_t l) { return (h << 8) | l; }
+
+// One address space: flash tables are plain memory
+#define PROGMEM
+#define memcpy_P memcpy
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+
+// Virtual clock in microseconds; only advances through delay()/sim_advance()
+extern unsigned long cpu_time;
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned long us);
+void sim_advance(unsigned long us);
+
+// Pins: only a 1 Hz square wave (an RTC's SQW output) on sim_sqw_pin, falling
+// at each whole second of cpu_time; every other pin reads HIGH. sim_irq_pin
+// is the one pin with an external interrupt
+#define LOW 0
+#define HIGH 1
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define CHANGE 1
+#define FALLING 2
+#define RISING 3
+#define NOT_AN_INTERRUPT -1
+
+extern int sim_sqw_pin;
+extern int sim_irq_pin;
+
+int digitalRead(uint8_t pin);
+int digitalPinToInterrupt(uint8_t pin);
+void attachInterrupt(uint8_t irq, void (*isr)(), int mode);
+void detachInterrupt(uint8_t irq);
+inline void pinMode(uint8_t, uint8_t) {}
+inline void noInterrupts() {}
+inline void interrupts() {}
+
+// Minimal Print: sinks implement write(uint8_t), bulk writes fall back to it
+class Print
+{
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buf, size_t len) {
+        size_t n = 0;
+        while (len--) n += write(*buf++);
+        return n;
+    }
+};
+
+// Minimal Stream: the byte-level read side of a serial port
+class Stream : public Print
+{
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+};
+
+#endif  //_FAKE_ARDUINO_H
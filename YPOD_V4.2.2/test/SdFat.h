@@ -0,0 +1,10 @@
+/*******************************************************************************
+ * @file    SdFat.h
+ * @brief   Host stand-in for SdFat; real sources are used for common/ only
+******************************************************************************/
+#ifndef _FAKE_SDFAT_H
+#define _FAKE_SDFAT_H
+
+#include "Arduino.h"
+
+#endif  //_FAKE_SDFAT_H
@@ -0,0 +1,2 @@
+/*  Host stand-in: Stream lives in the fake Arduino.h  */
+#include "Arduino.h"
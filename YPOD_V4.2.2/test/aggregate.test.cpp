@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+#include <math.h>
+#include <vector>
+#include "Arduino.h"
+#include "aggregate.h"
+
+const uint32_t DAY = 1791849600UL;          // 2026-10-13T00:00:00
+const uint8_t CHANNELS = 2;
+
+/*  A row the sketch would write: the tier's window as it ended  */
+struct Row {
+    uint8_t tier;
+    uint32_t window;
+    uint16_t records;
+    agg_stats_t stats[CHANNELS];
+};
+
+/*  Drives the aggregator like the sketch's aggregateRecord()  */
+class Pod {
+public:
+    Aggregator agg;
+    agg_stats_t table[AGG_TIERS * CHANNELS];
+    std::vector<Row> rows;
+
+    Pod() { agg.begin(table, CHANNELS); }
+
+    void record(uint32_t now, float a, float b = NAN) {
+        for (uint8_t t = 0; t < AGG_TIERS; t++) {
+            if (agg.ended(t, now)) {
+                Row r = { t, agg.window(t), agg.records(t) };
+                for (uint8_t c = 0; c < CHANNELS; c++)
+                    r.stats[c] = agg.stats(t)[c];
+                rows.push_back(r);
+                agg.close(t, now);
+            }
+        }
+        agg.record(now);
+        agg.add(0, a);
+        if (!isnan(b))
+            agg.add(1, b);
+    }
+
+    std::vector<Row> tier(uint8_t t) {
+        std::vector<Row> out;
+        for (size_t i = 0; i < rows.size(); i++)
+            if (rows[i].tier == t)
+                out.push_back(rows[i]);
+        return out;
+    }
+};
+
+TEST(Aggregate, MinuteRowsOnTheClock)
+{
+    Pod pod;
+    for (uint32_t s = 30; s < 200; s++)     // 00:00:30 .. 00:03:19, one a second
+        pod.record(DAY + s, s, 2 * s);
+
+    std::vector<Row> m = pod.tier(AGG_1MIN);
+    ASSERT_EQ(3u, m.size());
+    EXPECT_EQ(DAY, m[0].window);            // the partial first minute
+    EXPECT_EQ(30, m[0].records);
+    EXPECT_EQ(30, m[0].stats[0].count);
+    EXPECT_FLOAT_EQ(44.5, m[0].stats[0].mean);
+    EXPECT_FLOAT_EQ(30, m[0].stats[0].lo);
+    EXPECT_FLOAT_EQ(59, m[0].stats[0].hi);
+    EXPECT_FLOAT_EQ(89, m[0].stats[1].mean);
+
+    EXPECT_EQ(DAY + 60, m[1].window);
+    EXPECT_EQ(60, m[1].records);
+    EXPECT_FLOAT_EQ(89.5, m[1].stats[0].mean);
+    EXPECT_FLOAT_EQ(60, m[1].stats[0].lo);
+    EXPECT_FLOAT_EQ(119, m[1].stats[0].hi);
+    EXPECT_EQ(DAY + 120, m[2].window);
+    EXPECT_TRUE(pod.tier(AGG_15MIN).empty());
+}
+
+TEST(Aggregate, TiersMergeTheShorterOnes)
+{
+    Pod pod;
+    for (uint32_t s = 0; s < 2 * 3600 + 10; s += 5)
+        pod.record(DAY + s, s % 900, 1);
+
+    std::vector<Row> q = pod.tier(AGG_15MIN), h = pod.tier(AGG_HOUR);
+    ASSERT_EQ(8u, q.size());
+    ASSERT_EQ(2u, h.size());
+    for (size_t i = 0; i < q.size(); i++) {
+        EXPECT_EQ(DAY + 900 * i, q[i].window);
+        EXPECT_EQ(180, q[i].records);
+        EXPECT_EQ(180, q[i].stats[0].count);
+        EXPECT_NEAR(447.5, q[i].stats[0].mean, 0.01);
+        EXPECT_FLOAT_EQ(0, q[i].stats[0].lo);
+        EXPECT_FLOAT_EQ(895, q[i].stats[0].hi);
+    }
+    EXPECT_EQ(DAY + 3600, h[1].window);
+    EXPECT_EQ(720, h[1].records);
+    EXPECT_NEAR(447.5, h[1].stats[0].mean, 0.01);
+    EXPECT_FLOAT_EQ(1, h[1].stats[1].mean);
+    EXPECT_EQ(720, h[1].stats[1].count);
+}
+
+// Ends a window whose shorter tiers were never closed inside it: a pod off
+// from 00:14:30 to 01:20 still gets its 15-min and hourly rows
+TEST(Aggregate, GapClosesEveryTier)
+{
+    Pod pod;
+    pod.record(DAY + 870, 1);
+    pod.record(DAY + 880, 3);
+    pod.record(DAY + 4800, 10);
+
+    ASSERT_EQ(3u, pod.rows.size());
+    EXPECT_EQ(AGG_1MIN, pod.rows[0].tier);
+    EXPECT_EQ(DAY + 840, pod.rows[0].window);
+    EXPECT_EQ(AGG_15MIN, pod.rows[1].tier);
+    EXPECT_EQ(DAY, pod.rows[1].window);
+    EXPECT_EQ(AGG_HOUR, pod.rows[2].tier);
+    EXPECT_EQ(DAY, pod.rows[2].window);
+    EXPECT_FLOAT_EQ(2, pod.rows[2].stats[0].mean);
+    EXPECT_EQ(2, pod.rows[2].records);
+
+    EXPECT_EQ(DAY + 4800, pod.agg.window(AGG_1MIN));
+    EXPECT_EQ(1, pod.agg.records(AGG_1MIN));
+    EXPECT_EQ(0, pod.agg.records(AGG_HOUR));
+}
+
+TEST(Aggregate, BlankChannelIsCountedApart)
+{
+    Pod pod;
+    pod.record(DAY + 0, 4, 7);
+    pod.record(DAY + 10, 6);                // second channel blank
+    pod.record(DAY + 20, 8);
+    pod.record(DAY + 60, 0);
+
+    ASSERT_EQ(1u, pod.rows.size());
+    EXPECT_EQ(3, pod.rows[0].records);
+    EXPECT_EQ(3, pod.rows[0].stats[0].count);
+    EXPECT_EQ(1, pod.rows[0].stats[1].count);
+    EXPECT_FLOAT_EQ(7, pod.rows[0].stats[1].mean);
+
+    // a channel with nothing in a window stays empty after the merge
+    Pod quiet;
+    quiet.record(DAY, 1);
+    quiet.record(DAY + 3600, 1);
+    ASSERT_EQ(3u, quiet.rows.size());
+    EXPECT_EQ(0, quiet.rows[2].stats[1].count);
+}
+
+// Welford's running mean needs no growing sum: an hour of 1 Hz values in
+// float stays within 0.01 of the exact (double) mean
+TEST(Aggregate, RunningMeanStaysAccurate)
+{
+    Pod pod;
+    double exact = 0;
+    uint32_t n = 0;
+    for (uint32_t s = 0; s < 3600; s++) {
+        float x = 1000.0f + 37.3f * sinf(s * 0.01f) + (s % 7) * 0.11f;
+        pod.record(DAY + s, x);
+        exact += x;
+        n++;
+    }
+    pod.record(DAY + 3600, 0);
+
+    std::vector<Row> h = pod.tier(AGG_HOUR);
+    ASSERT_EQ(1u, h.size());
+    EXPECT_EQ(3600, h[0].stats[0].count);
+    EXPECT_NEAR(exact / n, h[0].stats[0].mean, 0.01);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,350 @@
+#include <gtest/gtest.h>
+#include <math.h>
+#include <string>
+#include <vector>
+#include "Arduino.h"
+#include "binlog.h"
+#include "binlog_decode.h"
+#include "record.h"
+
+const uint32_t BASE_TIME = 1791849600UL;    // 2026-10-13T00:00:00
+
+/*  One sample, logged both ways  */
+struct Sample {
+    uint32_t offset;
+    float t, rh, co2;
+    uint16_t fig1, fig2, e2v, co1, co2_ch2;
+    bool pm;
+    uint16_t pm1, pm25, pm10;
+    uint32_t age;
+    int16_t tvoc, co_cal;
+    long quad;
+};
+
+std::string timestamp(uint32_t offset)
+{
+    return binlog_time(BASE_TIME + offset);
+}
+
+/*  Same column order as buildRecord() in the sketch (calibrated, quadstat on)  */
+void build_csv(Record &r, const Sample &s)
+{
+    r.clear();
+    r.add(timestamp(s.offset).c_str());
+    r.sep();
+    r.sep();
+    r.sep();
+    r.add("YPODE8");
+    r.sep();
+    r.add("YPOD_V4.2.2");
+    r.sep();
+    r.sep();
+    r.sep();
+    r.add_float(s.t);
+    r.sep();
+    r.add_float(s.rh);
+    r.sep();
+    r.add_int(s.tvoc);
+    r.sep();
+    r.add_uint(s.fig1);
+    r.sep();
+    r.add_uint(s.fig2);
+    r.sep();
+    r.add_uint(s.e2v);
+    r.sep();
+    r.add_float(s.co_cal);
+    r.sep();
+    r.add_uint(s.co1);
+    r.sep();
+    r.add_uint(s.co2_ch2);
+    r.sep();
+    r.add_float(s.co2);
+    r.sep();
+    if (s.pm) {
+        r.add_uint(s.pm1);
+        r.sep();
+        r.add_uint(s.pm25);
+        r.sep();
+        r.add_uint(s.pm10);
+        r.sep();
+    } else {
+        r.add(",,,");
+    }
+    r.add_int(s.quad);
+    r.sep();
+    r.add_int(-s.quad);
+    r.sep();
+    if (s.pm)
+        r.add_uint(s.age);
+    r.sep();
+    r.end();
+}
+
+void build_bin(BinRecord &b, const Sample &s)
+{
+    b.clear();
+    b.add_time(s.offset);
+    b.blank();
+    b.blank();
+    b.add_text(BIN_POD_ID);
+    b.add_text(BIN_FIRMWARE);
+    b.blank();
+    b.blank();
+    b.add_f32(s.t);
+    b.add_f32(s.rh);
+    b.add_i16(s.tvoc);
+    b.add_u16(s.fig1);
+    b.add_u16(s.fig2);
+    b.add_u16(s.e2v);
+    b.add_i16_f(s.co_cal);
+    b.add_u16(s.co1);
+    b.add_u16(s.co2_ch2);
+    b.add_f32(s.co2);
+    if (s.pm)
+        b.set_flag(1);
+    b.add_u16(s.pm1, 1);
+    b.add_u16(s.pm25, 1);
+    b.add_u16(s.pm10, 1);
+    b.add_i16(s.quad);
+    b.add_i16(-s.quad);
+    b.add_u32(s.age, 1);
+    b.end();
+}
+
+const Sample SAMPLES[] = {
+    { 0, 21.456f, 45.25f, 412.5f, 8000, 9000, 7000, 4500, 4300, true, 5, 8, 12, 730, 120, 129, 1000 },
+    { 3, -46.85f, 0.004f, 0, 0, 65535, 1, 2, 3, false, 0, 0, 0, 0, -5, -32768, -32767 },
+    { 86399, 99.999f, 101325.12f, -1, 12000, 11000, 6000, 4000, 3900, true, 65535, 0, 1, 1200, 32767, 32767, 32767 },
+};
+
+/*  Header + one record per sample, as the SD file holds them  */
+std::vector<uint8_t> build_file(BinRecord &b)
+{
+    std::vector<uint8_t> file;
+    for (const Sample &s : SAMPLES) {
+        build_bin(b, s);
+        if (file.empty()) {
+            uint8_t header[BIN_HEADER_MAX];
+            uint16_t len = b.header(header, BASE_TIME, "YPODE8", "YPOD_V4.2.2");
+            file.assign(header, header + len);
+        }
+        file.insert(file.end(), b.data(), b.data() + b.length());
+    }
+    return file;
+}
+
+TEST(Binlog, DecodesToTheSameCsv)
+{
+    BinRecord bin;
+    std::vector<uint8_t> file = build_file(bin);
+    BinlogReader reader;
+    ASSERT_TRUE(reader.open(file.data(), file.size())) << reader.error();
+    ASSERT_EQ(3u, reader.count());
+
+    for (size_t i = 0; i < reader.count(); i++) {
+        Record csv;
+        build_csv(csv, SAMPLES[i]);
+        std::string line;
+        EXPECT_TRUE(reader.is_record(i));
+        reader.record_csv(i, line);
+        EXPECT_EQ(std::string(csv.c_str()), line);
+    }
+}
+
+TEST(Binlog, HeaderDescribesTheSchema)
+{
+    BinRecord bin;
+    std::vector<uint8_t> file = build_file(bin);
+    BinlogReader reader;
+    ASSERT_TRUE(reader.open(file.data(), file.size()));
+
+    const binlog_header_t &h = reader.header();
+    EXPECT_EQ(0, memcmp(BIN_MAGIC, h.magic, 4));
+    EXPECT_EQ(BIN_VERSION, h.version);
+    EXPECT_EQ(23, h.columns);
+    EXPECT_EQ(sizeof(binlog_header_t) + 2 * 23, h.header_size);
+    EXPECT_EQ(bin.length(), h.record_size);
+    EXPECT_EQ(BASE_TIME, h.base_time);
+    EXPECT_STREQ("YPODE8", h.pod_id);
+
+    // sync 1 & flags 2 + time 4 + 3 floats 12 + 12 16-bit ints 24 + age 4
+    EXPECT_EQ(47u, bin.length());
+    EXPECT_FALSE(bin.overflow());
+
+    Record csv;
+    build_csv(csv, SAMPLES[0]);
+    printf("  %u B/record binary, %u B CSV\n", bin.length(), csv.length());
+}
+
+TEST(Binlog, RejectsOtherFiles)
+{
+    BinRecord bin;
+    std::vector<uint8_t> file = build_file(bin);
+    BinlogReader reader;
+
+    std::string text = "2026-10-13T00:00:00,,,YPODE8,\n";
+    EXPECT_FALSE(reader.open((const uint8_t *)text.data(), text.size()));
+    EXPECT_EQ(0u, reader.count());
+
+    std::vector<uint8_t> bad = file;
+    bad[offsetof(binlog_header_t, record_size)]++;
+    EXPECT_FALSE(reader.open(bad.data(), bad.size()));
+
+    EXPECT_FALSE(reader.open(file.data(), sizeof(binlog_header_t) + 10));
+    EXPECT_TRUE(reader.open(file.data(), file.size()));
+}
+
+TEST(Binlog, ErasedTailIsNotARecord)
+{
+    BinRecord bin;
+    std::vector<uint8_t> file = build_file(bin);
+    file.insert(file.end(), bin.length(), 0xFF);
+    file.insert(file.end(), bin.length(), 0x00);
+    file.insert(file.end(), 7, 0x00);    // partial record: not counted
+
+    BinlogReader reader;
+    ASSERT_TRUE(reader.open(file.data(), file.size()));
+    ASSERT_EQ(5u, reader.count());
+    EXPECT_TRUE(reader.is_record(2));
+    EXPECT_FALSE(reader.is_record(3));
+    EXPECT_FALSE(reader.is_record(4));
+}
+
+TEST(Binlog, SchemaIsFixedByTheFirstRecord)
+{
+    BinRecord bin;
+    bin.add_u16(1);
+    bin.add_f32(2);
+    bin.end();
+    uint8_t header[BIN_HEADER_MAX];
+    EXPECT_EQ(sizeof(binlog_header_t) + 4, bin.header(header, 0, "", ""));
+
+    bin.clear();
+    bin.add_u16(3);
+    bin.add_f32(4);
+    bin.end();
+    EXPECT_EQ(sizeof(binlog_header_t) + 4, bin.header(header, 0, "", ""));
+    EXPECT_EQ(9, bin.length());
+    EXPECT_EQ(BIN_SYNC, bin.data()[0]);
+    EXPECT_EQ(3, bin.data()[3]);
+}
+
+TEST(Binlog, FlagsPastTheFirstByte)
+{
+    BinRecord bin;
+    bin.set_flag(9);
+    bin.set_flag(BIN_FLAGS);
+    bin.set_flag(BIN_FLAGS + 1);            // ignored
+    bin.add_u16(1, 9);
+    bin.add_u16(2, 10);
+    bin.add_u16(3, BIN_FLAGS);
+    bin.end();
+    EXPECT_EQ(0x00, bin.data()[1]);
+    EXPECT_EQ(0x81, bin.data()[2]);
+
+    std::vector<uint8_t> file(BIN_HEADER_MAX);
+    file.resize(bin.header(file.data(), BASE_TIME, "YPODE8", "YPOD_V4.2.2"));
+    file.insert(file.end(), bin.data(), bin.data() + bin.length());
+    BinlogReader reader;
+    ASSERT_TRUE(reader.open(file.data(), file.size())) << reader.error();
+    std::string line;
+    reader.record_csv(0, line);
+    EXPECT_EQ("1,,3,\n", line);
+}
+
+// A version 3 header carries the CSV header row; a row that does not end
+// the line, or one in a version 2 file, is refused
+TEST(Binlog, HeaderRowAfterTheSchema)
+{
+    const std::string row = "Timestamp(UTC),T(C),\n";
+    BinRecord bin;
+    bin.add_time(5);
+    bin.add_f32(21.5f);
+    bin.end();
+
+    std::vector<uint8_t> file(BIN_HEADER_MAX);
+    file.resize(bin.header(file.data(), BASE_TIME, "YPODE8", "YPOD_V4.2.2", row.size()));
+    EXPECT_EQ(sizeof(binlog_header_t) + 4, file.size());
+    file.insert(file.end(), row.begin(), row.end());
+    file.insert(file.end(), bin.data(), bin.data() + bin.length());
+
+    BinlogReader reader;
+    ASSERT_TRUE(reader.open(file.data(), file.size())) << reader.error();
+    EXPECT_EQ(sizeof(binlog_header_t) + 4 + row.size(), reader.header().header_size);
+    ASSERT_EQ(1u, reader.count());
+    std::string text, line;
+    reader.header_csv(text);
+    reader.record_csv(0, line);
+    EXPECT_EQ(row + "2026-10-13T00:00:05,21.50,\n", text + line);
+
+    std::vector<uint8_t> bad = file;
+    bad[sizeof(binlog_header_t) + 4 + row.size() - 1] = ',';
+    EXPECT_FALSE(reader.open(bad.data(), bad.size()));
+    bad = file;
+    bad[offsetof(binlog_header_t, version)] = 2;
+    EXPECT_FALSE(reader.open(bad.data(), bad.size()));
+}
+
+// A version 1 file (one flags byte per record) still decodes
+TEST(Binlog, ReadsVersion1Files)
+{
+    BinRecord bin;
+    std::vector<uint8_t> file = build_file(bin), v1;
+    BinlogReader reader;
+    ASSERT_TRUE(reader.open(file.data(), file.size()));
+    uint16_t header_size = reader.header().header_size;
+    uint16_t record_size = reader.header().record_size;
+
+    v1.assign(file.begin(), file.begin() + header_size);
+    v1[offsetof(binlog_header_t, version)] = 1;
+    v1[offsetof(binlog_header_t, record_size)]--;
+    for (size_t at = header_size; at < file.size(); at += record_size) {
+        ASSERT_EQ(0, file[at + 2]);
+        v1.insert(v1.end(), file.begin() + at, file.begin() + at + 2);
+        v1.insert(v1.end(), file.begin() + at + 3, file.begin() + at + record_size);
+    }
+
+    ASSERT_TRUE(reader.open(v1.data(), v1.size())) << reader.error();
+    ASSERT_EQ(3u, reader.count());
+    for (size_t i = 0; i < reader.count(); i++) {
+        Record csv;
+        build_csv(csv, SAMPLES[i]);
+        std::string line;
+        reader.record_csv(i, line);
+        EXPECT_EQ(std::string(csv.c_str()), line);
+    }
+}
+
+TEST(Binlog, Timestamps)
+{
+    EXPECT_EQ("1970-01-01T00:00:00", binlog_time(0));
+    EXPECT_EQ("2026-10-13T00:00:00", binlog_time(BASE_TIME));
+    EXPECT_EQ("2026-10-13T23:59:59", binlog_time(BASE_TIME + 86399));
+    EXPECT_EQ("2000-02-29T12:34:56", binlog_time(951827696UL));
+    EXPECT_EQ("2028-03-01T00:00:00", binlog_time(1835481600UL));
+    EXPECT_EQ("2099-12-31T23:59:59", binlog_time(4102444799UL));
+}
+
+TEST(Binlog, FloatsMatchRecord)
+{
+    const float values[] = { 0, 1, -1, 0.004f, -0.004f, 21.456f, 45.25f,
+                             -46.85f, -99, 101325.12f, 412.5f, 1e6f, 3.14159f, 99.999f };
+    for (float v : values) {
+        Record record;
+        record.add_float(v);
+        EXPECT_EQ(std::string(record.c_str()), binlog_float(v)) << v;
+    }
+    // Just below a rounding step the AVR's float sum rounds up where the
+    // host's double does not; the decoder prints what the pod would
+    EXPECT_EQ("0.02", binlog_float(0.015f));
+    EXPECT_EQ("46.00", binlog_float(45.995f));
+    EXPECT_EQ("nan", binlog_float(NAN));
+    EXPECT_EQ("inf", binlog_float(-INFINITY));
+    EXPECT_EQ("ovf", binlog_float(5e9f));
+    EXPECT_EQ("12.346", binlog_float(12.3456f, 3));
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
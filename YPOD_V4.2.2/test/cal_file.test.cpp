@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <string>
+#include "Arduino.h"
+#include "cal_file.h"
+#include "calibration.h"
+
+/*  One CAL.CSV line for a pod, numbers as the table has them  */
+std::string csv_line(const cal_pod_t &p, const char *id)
+{
+    char buf[400];
+    snprintf(buf, sizeof(buf), "%s,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g\n",
+             id, p.co.gain, p.co.rh, p.co.offset, p.co2.gain, p.co2.root, p.co2.rh, p.co2.t, p.co2.offset,
+             p.t.gain, p.t.offset, p.rh.gain, p.rh.offset,
+             p.voc.fig2600, p.voc.square, p.voc.fig2602, p.voc.t, p.voc.rh, p.voc.offset);
+    return buf;
+}
+
+const char HEADER[] = "ID,co_gain,co_rh,co_offset,co2_gain,co2_root,co2_rh,co2_t,co2_offset,t_gain,t_offset,"
+                      "rh_gain,rh_offset,voc_fig2600,voc_square,voc_fig2602,voc_t,voc_rh,voc_offset\n";
+const char K3_NEW[] = "K3,0.002,-0.1,4,1.1,0,-0.14,-1.7,98.6,1.1,-5.7,1.2,-6.5,0.1,0,0.16,-6.4,-1.5,-63\n";
+
+/*  Feeds `text` the way SD_Logger::read_file() does, in `chunk` byte pieces  */
+bool read(CalReader &reader, const std::string &text, size_t chunk = 32)
+{
+    for (size_t i = 0; i < text.size(); i += chunk)
+        reader.write((const uint8_t *)text.data() + i, std::min(chunk, text.size() - i));
+    return reader.end();
+}
+
+void expect_row(const cal_pod_t &want, const cal_pod_t &got)
+{
+    EXPECT_EQ(want.letter, got.letter);
+    EXPECT_EQ(want.number, got.number);
+    EXPECT_EQ(0, memcmp(&want.co, &got.co, sizeof(want.co)));
+    EXPECT_EQ(0, memcmp(&want.co2, &got.co2, sizeof(want.co2)));
+    EXPECT_EQ(0, memcmp(&want.t, &got.t, sizeof(want.t)));
+    EXPECT_EQ(0, memcmp(&want.rh, &got.rh, sizeof(want.rh)));
+    EXPECT_EQ(0, memcmp(&want.voc, &got.voc, sizeof(want.voc)));
+}
+
+TEST(CalFile, EveryPodOfAFullFile)
+{
+    // the whole compiled table written out: each pod reads back its own row, bit for bit
+    std::string file = std::string(HEADER) + "# after the 2026 collocation\n";
+    for (unsigned i = 0; i < CAL_POD_COUNT; i++) {
+        char id[3] = { CAL_PODS[i].letter, CAL_PODS[i].number, '\0' };
+        file += csv_line(CAL_PODS[i], id);
+    }
+    for (unsigned i = 0; i < CAL_POD_COUNT; i++) {
+        CalReader reader(CAL_PODS[i].letter, CAL_PODS[i].number);
+        ASSERT_TRUE(read(reader, file)) << CAL_PODS[i].letter << CAL_PODS[i].number;
+        expect_row(CAL_PODS[i], reader.row());
+    }
+    printf("  %u pods, %zu bytes of CAL.CSV\n", CAL_POD_COUNT, file.size());
+}
+
+TEST(CalFile, PodNotInTheFile)
+{
+    CalReader reader('Q', '1');
+    EXPECT_FALSE(read(reader, std::string(HEADER) + K3_NEW));
+    EXPECT_FALSE(read(reader, ""));
+}
+
+TEST(CalFile, LastGoodLineWins)
+{
+    CalReader reader('K', '3');
+    ASSERT_TRUE(read(reader, csv_line(cal_lookup('K', '3'), "K3") + K3_NEW, 1));
+    EXPECT_DOUBLE_EQ(0.002, reader.row().co.gain);
+    EXPECT_DOUBLE_EQ(-63, reader.row().voc.offset);
+}
+
+TEST(CalFile, BadLinesAreIgnored)
+{
+    const char *bad[] = {
+        "K3,0.002,-0.1,4,1.1,0,-0.14,-1.7,98.6,1.1,-5.7,1.2,-6.5,0.1,0,0.16,-6.4,-1.5\n",        // 17 numbers
+        "K3,0.002,-0.1,4,1.1,0,-0.14,-1.7,98.6,1.1,-5.7,1.2,-6.5,0.1,0,0.16,-6.4,-1.5,\n",       // 17 and a comma
+        "K3,0.002,-0.1,4,1.1,0,-0.14,-1.7,98.6,1.1,-5.7,1.2,-6.5,0.1,0,0.16,-6.4,-1.5,-63,1\n",  // 19
+        "K3,0.002,-0.1,4,1.1,0,-0.14,-1.7,98.6,1.1,-5.7,1.2,-6.5,0.1,0,0.16,-6.4,-1.5,-63,,\n",  // 2 empty after
+        "K3,0.002,-0.1,4,1.1,0,-0.14,-1.7,98.6,1.1,-5.7,1.2,-6.5,0.1,0,0.16,-6.4,-1.5x,-63\n",   // not a number
+        "K3,0.002,-0.1,4,1.1,0,-0.14,,98.6,1.1,-5.7,1.2,-6.5,0.1,0,0.16,-6.4,-1.5,-63\n",        // empty
+        "K3,0.002,-0.1,4,1.1,0,-0.14,-1.70000000000000,98.6,1.1,-5.7,1.2,-6.5,0.1,0,0.16,-6.4,-1.5,-63\n",
+        "K33,0.002,-0.1,4,1.1,0,-0.14,-1.7,98.6,1.1,-5.7,1.2,-6.5,0.1,0,0.16,-6.4,-1.5,-63\n",
+        "YPODK3,0.002,-0.1,4,1.1,0,-0.14,-1.7,98.6,1.1,-5.7,1.2,-6.5,0.1,0,0.16,-6.4,-1.5,-63\n",
+    };
+    for (const char *line : bad) {
+        CalReader reader('K', '3');
+        EXPECT_FALSE(read(reader, line)) << line;
+        // a bad line after a good one leaves the good one
+        ASSERT_TRUE(read(reader, std::string(K3_NEW) + line)) << line;
+        EXPECT_DOUBLE_EQ(0.002, reader.row().co.gain);
+    }
+}
+
+TEST(CalFile, SpacesCrLfAndNoLastNewline)
+{
+    CalReader reader('K', '3');
+    ASSERT_TRUE(read(reader, "\r\n K3, 0.002, -0.1, 4, 1.1, 0, -0.14, -1.7, 98.6, 1.1, -5.7, 1.2, -6.5,"
+                             " 0.1, 0, 0.16, -6.4, -1.5, -63\r\n"));
+    EXPECT_DOUBLE_EQ(-6.4, reader.row().voc.t);
+
+    CalReader last('K', '3');
+    std::string line(K3_NEW);
+    ASSERT_TRUE(read(last, line.substr(0, line.size() - 1)));
+    EXPECT_DOUBLE_EQ(-63, last.row().voc.offset);
+}
+
+TEST(CalFile, TrailingCommaRow)
+{
+    // rows as the pod's own CSVs end them, with a comma after the last field
+    std::string line(K3_NEW);
+    line.insert(line.size() - 1, ",");
+    CalReader reader('K', '3');
+    ASSERT_TRUE(read(reader, line));
+    EXPECT_DOUBLE_EQ(-63, reader.row().voc.offset);
+
+    CalReader crlf('K', '3');
+    ASSERT_TRUE(read(crlf, line.substr(0, line.size() - 1) + " \r\n"));
+    EXPECT_DOUBLE_EQ(-63, crlf.row().voc.offset);
+
+    CalReader last('K', '3');
+    ASSERT_TRUE(read(last, line.substr(0, line.size() - 1)));
+    EXPECT_DOUBLE_EQ(-63, last.row().voc.offset);
+}
+
+TEST(CalFile, CalUsesTheLoadedRow)
+{
+    // YPOD_node.h's pod, compiled row first, then a changed one from the file
+    Cal cal;
+    cal_pod_t pod = cal_lookup(calID_letter, calID_number);
+    calOutput compiled = cal.calibrate(4500, 1000, 55.3f, 22.7f, 12000, 3000);
+
+    char id[3] = { calID_letter, calID_number, '\0' };
+    cal_pod_t changed = pod;
+    changed.co.offset += 10;
+    changed.co2.offset -= 100;
+    changed.t.offset += 1;
+    CalReader reader(calID_letter, calID_number);
+    ASSERT_TRUE(read(reader, csv_line(changed, id)));
+    ASSERT_TRUE(cal.set(reader.row()));
+
+    calOutput got = cal.calibrate(4500, 1000, 55.3f, 22.7f, 12000, 3000);
+    EXPECT_EQ(compiled.CO_ + 10, got.CO_);
+    EXPECT_NEAR(compiled.CO2_ - 100, got.CO2_, 1);
+    EXPECT_FLOAT_EQ(compiled.T_ + 1, got.T_);
+    EXPECT_EQ(compiled.TVOC_, got.TVOC_);
+}
+
+TEST(CalFile, RowTooLargeForFixedPointIsRefused)
+{
+    Cal cal;
+    calOutput before = cal.calibrate(4500, 1000, 55.3f, 22.7f, 12000, 3000);
+    cal_pod_t typo = cal_lookup(calID_letter, calID_number);
+    typo.co2.gain = 1.1e9;  // "1.1" with the decimal point lost, and then some
+    EXPECT_EQ(!CAL_FIXED_POINT, cal.set(typo));
+    if (CAL_FIXED_POINT) {
+        EXPECT_EQ(before.CO2_, cal.calibrate(4500, 1000, 55.3f, 22.7f, 12000, 3000).CO2_);
+    }
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include <math.h>
+#include <stdio.h>
+#include "Arduino.h"
+#include "cal_table.h"
+#include "cal_fixed.h"
+#include "calibration.h"
+
+/*  Every input the pods can report: 16 bit counts & ppm, SHT25 T & RH  */
+#define ADC_STEP    1285        // 0..65535 counts, 52 steps
+#define CO2_STEP    1285        // 0..65535 ppm
+#define RH_MIN      0.0         // SHT25 specified range
+#define RH_MAX      100.0
+#define T_MIN       -40.0
+#define T_MAX       125.0
+#define ENV_STEPS   12
+
+/*  Largest |fixed - float| before the int truncation, in ppm (the sqrt CO2
+ *  fits reach ~0.07: sqrt to 1/512, times a root coefficient near 35), and
+ *  the worst int column difference (a result crossing a whole number can
+ *  flip by 1)  */
+const double MAX_ERROR = 0.1;
+const int MAX_INT_ERROR = 1;
+
+struct pod_error_t {
+    double co, co2, voc;
+    int co_int, co2_int, voc_int;
+};
+
+/*  The float equations of cal_table.h without the clamp and truncation  */
+double co_ref(const cal_co_t &c, uint16_t co, double rh)
+{
+    return c.gain * co + c.rh * rh + c.offset;
+}
+
+double co2_ref(const cal_co2_t &c, double co2, double rh, double t)
+{
+    return c.gain * co2 + (c.root ? c.root * sqrt(co2) : 0) + c.rh * rh + c.t * t + c.offset;
+}
+
+double voc_ref(const cal_voc_t &c, uint16_t f1, uint16_t f2, double rh, double t)
+{
+    return c.fig2600 * f1 + (c.square ? c.square * ((double)f1 * f1) : 0) + c.fig2602 * f2 + c.t * t + c.rh * rh + c.offset;
+}
+
+void worst(double &err, int &err_int, double ref, int32_t q, int ref_int)
+{
+    err = fmax(err, fabs(ref - q / (double)(1 << CAL_Q)));
+    err_int = std::max(err_int, abs(ref_int - cal_int(q)));
+}
+
+/*  Fixed against float over the grid; the fixed side gets T & RH through cal_q() as Cal does  */
+pod_error_t sweep(const cal_pod_t &pod)
+{
+    cal_pod_q_t q = cal_fixed(pod);
+    pod_error_t e = {};
+
+    for (int i = 0; i <= ENV_STEPS; i++)
+    for (int j = 0; j <= ENV_STEPS; j++) {
+        float rh = RH_MIN + (RH_MAX - RH_MIN) * i / ENV_STEPS;
+        float t = T_MIN + (T_MAX - T_MIN) * j / ENV_STEPS;
+        int16_t rh_q = cal_q(rh), t_q = cal_q(t);
+
+        for (uint32_t a = 0; a <= 65535; a += ADC_STEP) {
+            worst(e.co, e.co_int, co_ref(pod.co, a, rh), eval_co_q(q.co, a, rh_q),
+                  eval_co(pod.co, a, rh));
+        }
+        for (uint32_t a = 0; a <= 65535; a += CO2_STEP) {
+            worst(e.co2, e.co2_int, co2_ref(pod.co2, a, rh, t), eval_co2_q(q.co2, a, rh_q, t_q),
+                  eval_co2(pod.co2, a, rh, t));
+        }
+        for (uint32_t a = 0; a <= 65535; a += ADC_STEP)
+        for (uint32_t b = 0; b <= 65535; b += 4 * ADC_STEP) {
+            worst(e.voc, e.voc_int, voc_ref(pod.voc, a, b, rh, t), eval_voc_q(q.voc, a, b, rh_q, t_q),
+                  eval_voc(pod.voc, a, b, rh, t));
+        }
+    }
+    return e;
+}
+
+TEST(CalFixed, EveryPodMatchesFloat)
+{
+    printf("  max |fixed - float| over the input range (ppm; int column)\n");
+    printf("  pod      CO             CO2            TVOC\n");
+    for (unsigned i = 0; i < CAL_POD_COUNT; i++) {
+        const cal_pod_t &pod = CAL_PODS[i];
+        pod_error_t e = sweep(pod);
+        printf("  %c%c   %8.4f (%d)   %8.4f (%d)   %8.4f (%d)\n", pod.letter, pod.number,
+               e.co, e.co_int, e.co2, e.co2_int, e.voc, e.voc_int);
+
+        EXPECT_LE(e.co, MAX_ERROR) << pod.letter << pod.number;
+        EXPECT_LE(e.co2, MAX_ERROR) << pod.letter << pod.number;
+        EXPECT_LE(e.voc, MAX_ERROR) << pod.letter << pod.number;
+        EXPECT_LE(e.co_int, MAX_INT_ERROR) << pod.letter << pod.number;
+        EXPECT_LE(e.co2_int, MAX_INT_ERROR) << pod.letter << pod.number;
+        EXPECT_LE(e.voc_int, MAX_INT_ERROR) << pod.letter << pod.number;
+    }
+}
+
+TEST(CalFixed, NoCalibrationPassesRawSignal)
+{
+    cal_pod_q_t q = cal_fixed(CAL_POD_NONE);
+    EXPECT_EQ(1234, cal_int(eval_co_q(q.co, 1234, cal_q(40))));
+    EXPECT_EQ(900, cal_int(eval_co2_q(q.co2, 900, cal_q(40), cal_q(20))));
+    EXPECT_EQ(1, cal_int(eval_voc_q(q.voc, 1234, 5678, cal_q(40), cal_q(20))));
+}
+
+TEST(CalFixed, SquareRoot)
+{
+    for (uint32_t x = 0; x <= 65535; x++)
+        ASSERT_NEAR(sqrt((double)x), cal_sqrt_q(x) / 256.0, 0.5 / 256) << x;
+}
+
+TEST(CalFixed, NegativeClampsToZero)
+{
+    EXPECT_EQ(0, cal_int(-1));
+    EXPECT_EQ(0, cal_int(-100000));
+    EXPECT_EQ(0, cal_int(255));
+    EXPECT_EQ(1, cal_int(256));
+}
+
+TEST(CalFixed, CalUsesTheFixedPath)
+{
+    // Cal (CAL_FIXED_POINT) gives what the equations here give for this pod
+    Cal cal;
+    cal_pod_q_t q = cal_fixed(cal_lookup(calID_letter, calID_number));
+    calOutput out = cal.calibrate(4500, 1000, 55.3f, 22.7f, 12000, 3000);
+    EXPECT_EQ(cal_int(eval_co_q(q.co, 4500, cal_q(55.3f))), out.CO_);
+    EXPECT_EQ(cal_int(eval_co2_q(q.co2, 1000, cal_q(55.3f), cal_q(22.7f))), out.CO2_);
+    EXPECT_EQ(cal_int(eval_voc_q(q.voc, 12000, 3000, cal_q(55.3f), cal_q(22.7f))), out.TVOC_);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include "Arduino.h"
+#include "cal_table.h"
+#include "calibration.h"
+#include "calibration_switch.h"
+
+/*  Inputs spanning what the pods report: ADS counts, S300 ppm, SHT25 %RH & C  */
+const uint16_t CO[]   = { 0, 350, 2000, 4500, 12000, 30000, 65535 };
+const float CO2[]     = { 0, 415, 1000, 5000 };
+const float RH[]      = { 0, 20.5f, 55.3f, 95 };
+const float T[]       = { -10, 0, 22.7f, 40 };
+const uint16_t FIG[]  = { 0, 3000, 12000, 25000, 40000 };  // sq() of these fits a 32-bit int
+
+#define COUNT(a) (sizeof(a) / sizeof(a[0]))
+
+/*  Fields the old switch got wrong; checked separately below  */
+enum field_e { F_CO = 1, F_CO2 = 2, F_T = 4, F_RH = 8, F_VOC = 16 };
+
+int known_switch_bugs(char letter, char number)
+{
+    if (letter == 'X' && number == '1')
+        return F_CO;            // missing break: X1 fell into X9's CO equation
+    if (letter == 'E' && number == '8')
+        return F_CO2 | F_VOC;   // missing break after 'E': fell into default
+    return 0;
+}
+
+calOutput table_calibrate(const cal_pod_t &pod, uint16_t co, float co2, float rh, float t,
+                          uint16_t fig2600, uint16_t fig2602)
+{
+    calOutput out;
+    out.CO_ = eval_co(pod.co, co, rh);
+    out.CO2_ = eval_co2(pod.co2, co2, rh, t);
+    out.T_ = eval_linear(pod.t, t);
+    out.RH_ = eval_linear(pod.rh, rh);
+    out.TVOC_ = eval_voc(pod.voc, fig2600, fig2602, rh, t);
+    return out;
+}
+
+// Runs both implementations over the input grid; returns the number of points compared
+int compare_pod(char letter, char number)
+{
+    Switch_Cal legacy(letter, number);
+    cal_pod_t pod = cal_lookup(letter, number);
+    int skip = known_switch_bugs(letter, number);
+    int points = 0;
+
+    for (unsigned a = 0; a < COUNT(CO); a++)
+    for (unsigned b = 0; b < COUNT(CO2); b++)
+    for (unsigned c = 0; c < COUNT(RH); c++)
+    for (unsigned d = 0; d < COUNT(T); d++)
+    for (unsigned e = 0; e < COUNT(FIG); e++) {
+        uint16_t fig2602 = FIG[COUNT(FIG) - 1 - e];
+        calOutput want = legacy.calibrate(CO[a], CO2[b], RH[c], T[d], FIG[e], fig2602);
+        calOutput got = table_calibrate(pod, CO[a], CO2[b], RH[c], T[d], FIG[e], fig2602);
+
+        if (!(skip & F_CO))  { EXPECT_EQ(want.CO_, got.CO_) << letter << number; }
+        if (!(skip & F_CO2)) { EXPECT_EQ(want.CO2_, got.CO2_) << letter << number; }
+        if (!(skip & F_T))   { EXPECT_EQ(want.T_, got.T_) << letter << number; }
+        if (!(skip & F_RH))  { EXPECT_EQ(want.RH_, got.RH_) << letter << number; }
+        if (!(skip & F_VOC)) { EXPECT_EQ(want.TVOC_, got.TVOC_) << letter << number; }
+        points++;
+    }
+    return points;
+}
+
+TEST(Calibration, TableMatchesSwitchForEveryPod)
+{
+    int points = 0;
+    for (unsigned i = 0; i < CAL_POD_COUNT; i++)
+        points += compare_pod(CAL_PODS[i].letter, CAL_PODS[i].number);
+
+    printf("  %u pods, %d input points each matched the switch\n", CAL_POD_COUNT, points / CAL_POD_COUNT);
+}
+
+TEST(Calibration, UnknownPodsPassRawSignal)
+{
+    // letters/numbers with no case in the switch fell through to the raw signal (TVOC = 1)
+    const char ids[][2] = { { 'Q', '1' }, { 'U', '9' }, { 'E', '1' }, { 'D', '3' }, { 'I', 'D' } };
+    for (unsigned i = 0; i < COUNT(ids); i++) {
+        compare_pod(ids[i][0], ids[i][1]);
+        cal_pod_t pod = cal_lookup(ids[i][0], ids[i][1]);
+        EXPECT_EQ(0, pod.letter);
+        EXPECT_EQ(1, eval_voc(pod.voc, 1234, 5678, 40, 20));
+        EXPECT_EQ(1234, eval_co(pod.co, 1234, 40));
+        EXPECT_FLOAT_EQ(21.5f, eval_linear(pod.t, 21.5f));
+    }
+}
+
+TEST(Calibration, FixedSwitchFallThroughs)
+{
+    Switch_Cal x1('X', '1'), x9('X', '9'), e8('E', '8');
+    cal_pod_t pod_x1 = cal_lookup('X', '1');
+    cal_pod_t pod_e8 = cal_lookup('E', '8');
+
+    // X1 now uses its own CO fit instead of X9's
+    EXPECT_EQ(x9.calibrate(2000, 0, 40, 20, 0, 0).CO_, x1.calibrate(2000, 0, 40, 20, 0, 0).CO_);
+    EXPECT_EQ((int)((0.00112 * 4000) + (-0.07675 * 10.0f) + 1.25783), eval_co(pod_x1.co, 4000, 10));
+
+    // E8 CO2 (sqrt fit) and methane (quadratic) now apply instead of raw CO2 / TVOC = 1
+    EXPECT_EQ(900, e8.calibrate(0, 900, 40, 20, 5000, 0).CO2_);
+    EXPECT_EQ(1, e8.calibrate(0, 900, 40, 20, 5000, 0).TVOC_);
+    EXPECT_EQ((int)((-0.14443 * 900.0f) + (34.7383 * sqrt(900.0f)) - 228.426), eval_co2(pod_e8.co2, 900, 40, 20));
+    EXPECT_EQ((int)((-0.913449 * 5000) + (0.000233333 * 5000.0 * 5000) + 2938.14), eval_voc(pod_e8.voc, 5000, 0, 40, 20));
+}
+
+TEST(Calibration, MethaneSquareDoesNotOverflow)
+{
+    // sq(fig2600) on a 16-bit int wrapped above 255 counts; the table squares in floating point
+    cal_pod_t pod = cal_lookup('D', '2');
+    EXPECT_EQ((int)((-0.84023 * 60000) + (0.0003215 * 60000.0 * 60000) + 2592.58), eval_voc(pod.voc, 60000, 0, 40, 20));
+}
+
+TEST(Calibration, CalUsesThisPodsRow)
+{
+    // YPOD_node.h picks the pod for the firmware build
+    Cal cal;
+    cal_pod_t pod = cal_lookup(calID_letter, calID_number);
+    ASSERT_EQ(calID_letter, pod.letter);
+
+    calOutput got = cal.calibrate(4500, 1000, 55.3f, 22.7f, 12000, 3000);
+    calOutput want = table_calibrate(pod, 4500, 1000, 55.3f, 22.7f, 12000, 3000);
+    EXPECT_NEAR(want.CO_, got.CO_, CAL_FIXED_POINT);     // fixed point: cal_fixed.test
+    EXPECT_NEAR(want.CO2_, got.CO2_, CAL_FIXED_POINT);
+    EXPECT_EQ(want.T_, got.T_);
+    EXPECT_EQ(want.RH_, got.RH_);
+    EXPECT_NEAR(want.TVOC_, got.TVOC_, CAL_FIXED_POINT);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,29 @@
+/*******************************************************************************
+ * @file    calibration_switch.h
+ * @brief   Reference copy of the switch-based Cal class; the pod is picked at
+ *          run time so every ypodID can be checked in one test binary
+******************************************************************************/
+#ifndef _CALIBRATION_SWITCH_H
+#define _CALIBRATION_SWITCH_H
+
+#include <math.h>
+#include "calibration.h"
+
+class Switch_Cal {
+  public:
+    Switch_Cal(char letter, char number) : calID_letter(letter), calID_number(number) {}
+    calOutput calibrate (uint16_t co, float co2, float rh, float t, uint16_t fig2600, uint16_t fig2602);
+
+  private:
+    // shadow the YPOD_node.h constants so the switches below stay verbatim
+    char calID_letter;
+    char calID_number;
+
+    int calibrate_co (uint16_t co, float rh);
+    int calibrate_co2 (float co2, float rh, float t);
+    float calibrate_t (float t);
+    float calibrate_rh (float rh);
+    int calibrate_voc (uint16_t fig2600, uint16_t fig2602, float rh, float t);
+};
+
+#endif // _CALIBRATION_SWITCH_H
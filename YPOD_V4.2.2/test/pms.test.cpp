@@ -0,0 +1,265 @@
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <deque>
+#include <vector>
+#include "Arduino.h"
+#include "PMS.h"
+#include "pms_summary.h"
+
+/*  Serial port fed by the test; bytes become available at 9600 baud  */
+const unsigned long BYTE_US = 1042;     // 10 bits at 9600 baud
+
+class SimSerial : public Stream {
+public:
+    struct Byte { unsigned long at; uint8_t value; };
+    std::deque<Byte> rx;
+    int requests = 0;
+
+    // Queues `len` bytes, the first arriving `delay_us` from now
+    void send(const uint8_t *buf, size_t len, unsigned long delay_us = 0) {
+        unsigned long at = cpu_time + delay_us;
+        if (!rx.empty() && rx.back().at > at) at = rx.back().at;
+        for (size_t i = 0; i < len; i++) {
+            at += BYTE_US;
+            rx.push_back({ at, buf[i] });
+        }
+    }
+    int available() override {
+        int n = 0;
+        for (size_t i = 0; i < rx.size() && rx[i].at <= cpu_time; i++) n++;
+        return n;
+    }
+    int read() override {
+        if (!available()) return -1;
+        uint8_t c = rx.front().value;
+        rx.pop_front();
+        return c;
+    }
+    int peek() override {
+        return available() ? rx.front().value : -1;
+    }
+    size_t write(uint8_t) override {
+        return 1;
+    }
+    size_t write(const uint8_t *buf, size_t len) override {
+        if (len == 7 && buf[2] == 0xE2) requests++;
+        return len;
+    }
+};
+
+// Builds a PMS5003 frame (28 byte payload) whose fields are pm + 0..12
+size_t make_frame(uint8_t *frame, uint16_t pm, bool corrupt = false)
+{
+    uint16_t sum = 0;
+    size_t n = 0;
+    frame[n++] = 0x42;
+    frame[n++] = 0x4D;
+    frame[n++] = 0;
+    frame[n++] = 28;
+    for (int i = 0; i < 13; i++) {
+        frame[n++] = (pm + i) >> 8;
+        frame[n++] = (pm + i) & 0xFF;
+    }
+    for (size_t i = 0; i < n; i++) sum += frame[i];
+    if (corrupt) sum++;
+    frame[n++] = sum >> 8;
+    frame[n++] = sum & 0xFF;
+    return n;
+}
+
+void send_frame(SimSerial &serial, uint16_t pm, unsigned long delay_us = 0, bool corrupt = false)
+{
+    uint8_t frame[32];
+    serial.send(frame, make_frame(frame, pm, corrupt), delay_us);
+}
+
+TEST(PMS, FrameSplitAcrossPollsIsPublishedOnce)
+{
+    cpu_time = 0;
+    SimSerial serial;
+    PMS pms(serial);
+    PMS::DATA data;
+    uint32_t arrived;
+
+    send_frame(serial, 12);
+    int polls = 0;
+    while (!pms.hasFrame() && millis() < 100) {
+        pms.poll();
+        polls++;
+        sim_advance(5000);      // 5 ms loop tick: ~5 bytes per drain
+    }
+
+    ASSERT_TRUE(pms.take(data, arrived));
+    EXPECT_GT(polls, 1);
+    EXPECT_EQ(12, data.pm10_standard);
+    EXPECT_EQ(15, data.pm10_env);
+    EXPECT_EQ(17, data.pm100_env);
+    EXPECT_EQ(23, data.particles_100um);
+    EXPECT_TRUE(data.hasParticles);
+    EXPECT_GE(arrived, 32 * BYTE_US / 1000);    // stamped on the tick that parsed the checksum
+    EXPECT_LE(arrived, 32 * BYTE_US / 1000 + 5);
+    EXPECT_FALSE(pms.take(data, arrived));
+}
+
+TEST(PMS, BadChecksumAndNoiseAreSkipped)
+{
+    cpu_time = 0;
+    SimSerial serial;
+    PMS pms(serial);
+    PMS::DATA data;
+    uint32_t arrived;
+
+    const uint8_t noise[] = { 0x00, 0x42, 0x17, 0x4D, 0x42, 0x4D, 0x00, 0x99 };
+    serial.send(noise, sizeof(noise));
+    send_frame(serial, 40, 0, true);
+    send_frame(serial, 50);
+    sim_advance(200000);
+    pms.poll();
+
+    ASSERT_TRUE(pms.take(data, arrived));
+    EXPECT_EQ(50, data.pm10_standard);
+}
+
+TEST(PMS, MailboxKeepsNewestFrameAndItsArrival)
+{
+    cpu_time = 0;
+    SimSerial serial;
+    PMS pms(serial);
+    PMS::DATA data;
+    uint32_t arrived;
+
+    send_frame(serial, 100);
+    send_frame(serial, 200, 500000);    // second frame ~0.5 s later
+    for (int i = 0; i < 1000; i++) {
+        pms.poll();
+        sim_advance(1000);
+    }
+
+    ASSERT_TRUE(pms.take(data, arrived));
+    EXPECT_EQ(200, data.pm10_standard);
+    EXPECT_NEAR(500 + 32 * BYTE_US / 1000, arrived, 1);
+}
+
+TEST(PMS, DiscardInputDropsStaleFrameWithoutBlocking)
+{
+    cpu_time = 0;
+    SimSerial serial;
+    PMS pms(serial);
+    PMS::DATA data;
+    uint32_t arrived;
+
+    send_frame(serial, 7);
+    sim_advance(20000);
+    pms.poll();                 // half a frame parsed
+    sim_advance(20000);
+
+    unsigned long before = cpu_time;
+    pms.discardInput();
+    EXPECT_EQ(before, cpu_time);
+    pms.poll();
+    EXPECT_FALSE(pms.hasFrame());
+
+    pms.passiveMode();
+    pms.requestRead();
+    EXPECT_EQ(1, serial.requests);
+    send_frame(serial, 8, 30000);
+    sim_advance(100000);
+    pms.poll();
+    ASSERT_TRUE(pms.take(data, arrived));
+    EXPECT_EQ(8, data.pm10_standard);
+}
+
+TEST(PMS, ShortFrameHasNoParticleCounts)
+{
+    cpu_time = 0;
+    SimSerial serial;
+    PMS pms(serial);
+    PMS::DATA data;
+
+    // PMS1003-style frame: 9 data words
+    uint8_t frame[24] = { 0x42, 0x4D, 0, 20 };
+    for (int i = 4; i < 22; i += 2) frame[i + 1] = 30;
+    uint16_t sum = 0;
+    for (int i = 0; i < 22; i++) sum += frame[i];
+    frame[22] = sum >> 8;
+    frame[23] = sum & 0xFF;
+    serial.send(frame, sizeof(frame));
+    sim_advance(100000);
+
+    ASSERT_TRUE(pms.read(data));
+    EXPECT_EQ(30, data.pm25_env);
+    EXPECT_FALSE(data.hasParticles);
+}
+
+std::vector<uint16_t> handled;     // pm10_env of each frame the handler saw
+void record_frame(const PMS::DATA &data)
+{
+    handled.push_back(data.pm10_env);
+}
+
+TEST(PMS, HandlerSeesEveryFrame)
+{
+    cpu_time = 0;
+    handled.clear();
+    SimSerial serial;
+    PMS pms(serial);
+    pms.onFrame(record_frame);
+
+    send_frame(serial, 100);
+    send_frame(serial, 200);
+    send_frame(serial, 300, 0, true);   // bad checksum: not a frame
+    sim_advance(200000);
+    pms.poll();                         // both in one drain, only one in the mailbox
+
+    ASSERT_EQ(2u, handled.size());
+    EXPECT_EQ(103, handled[0]);
+    EXPECT_EQ(203, handled[1]);
+
+    pms.onFrame(NULL);
+    send_frame(serial, 400);
+    sim_advance(100000);
+    pms.poll();
+    EXPECT_EQ(2u, handled.size());
+}
+
+TEST(PmsSummary, MeanMaxAndCountPerInterval)
+{
+    PmsSummary summary;
+    PMS::DATA data = PMS::DATA();
+    const uint16_t pm25[] = { 10, 11, 11, 30 };
+    for (uint16_t v : pm25) {
+        data.pm10_env = 4;
+        data.pm25_env = v;
+        data.pm100_env = 65535;         // full scale: the sums must not wrap
+        summary.add(data);
+    }
+    EXPECT_EQ(4, summary.frame_count());
+
+    // atmospheric bins only with the default switches
+    ASSERT_EQ(3, PMS_SUMMARY_BINS);
+    pms_summary_t s = summary.take();
+    EXPECT_EQ(4, s.frames);
+    EXPECT_EQ(4, s.mean[0]);
+    EXPECT_EQ(16, s.mean[1]);           // 15.5 rounds up
+    EXPECT_EQ(65535, s.mean[2]);
+    EXPECT_EQ(4, s.peak[0]);
+    EXPECT_EQ(30, s.peak[1]);
+    EXPECT_EQ(65535, s.peak[2]);
+
+    // the next interval starts empty
+    s = summary.take();
+    EXPECT_EQ(0, s.frames);
+    EXPECT_EQ(0, s.mean[1]);
+    EXPECT_EQ(0, s.peak[1]);
+    data.pm25_env = 7;
+    summary.add(data);
+    s = summary.take();
+    EXPECT_EQ(1, s.frames);
+    EXPECT_EQ(7, s.mean[1]);
+    EXPECT_EQ(7, s.peak[1]);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
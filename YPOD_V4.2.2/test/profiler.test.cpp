@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include "Arduino.h"
+#include "profiler.h"
+
+TEST(Profiler, BucketsAreHalfOctaves)
+{
+    EXPECT_EQ(0, Profiler::bucket_of(0));
+    EXPECT_EQ(0, Profiler::bucket_of(15));
+    EXPECT_EQ(1, Profiler::bucket_of(16));
+    EXPECT_EQ(1, Profiler::bucket_of(23));
+    EXPECT_EQ(2, Profiler::bucket_of(24));
+    EXPECT_EQ(3, Profiler::bucket_of(32));
+    EXPECT_EQ(PROF_BUCKETS - 1, Profiler::bucket_of(0xFFFFFFFF));
+
+    // every bucket's top is the first value of the next one
+    for (uint8_t b = 0; b < PROF_BUCKETS - 1; b++) {
+        EXPECT_EQ(b, Profiler::bucket_of(Profiler::bucket_top(b) - 1)) << (int)b;
+        EXPECT_EQ(b + 1, Profiler::bucket_of(Profiler::bucket_top(b))) << (int)b;
+    }
+}
+
+TEST(Profiler, PercentilesAreBucketTopsCappedAtMax)
+{
+    Profiler prof;
+
+    EXPECT_EQ(0u, prof.percentile(PROF_LOOP, 50));
+    for (int i = 0; i < 90; i++)
+        prof.add_sample(PROF_LOOP, 100);        // bucket [96, 128)
+    for (int i = 0; i < 10; i++)
+        prof.add_sample(PROF_LOOP, 114000);     // bucket [98304, 131072)
+
+    EXPECT_EQ(100u, prof.samples(PROF_LOOP));
+    EXPECT_EQ(90u * 100 + 10u * 114000, prof.total_us(PROF_LOOP));
+    EXPECT_EQ(114000u, prof.max_us(PROF_LOOP));
+    EXPECT_EQ(128u, prof.percentile(PROF_LOOP, 50));
+    EXPECT_EQ(128u, prof.percentile(PROF_LOOP, 90));
+    EXPECT_EQ(114000u, prof.percentile(PROF_LOOP, 95));
+    EXPECT_EQ(0u, prof.samples(PROF_SD));
+}
+
+TEST(Profiler, StartStopUsesMicros)
+{
+    cpu_time = 0;
+    Profiler prof;
+
+    prof.start(PROF_TASK + 2);
+    sim_advance(85000);
+    prof.stop(PROF_TASK + 2);
+    EXPECT_EQ(85000u, prof.max_us(PROF_TASK + 2));
+    EXPECT_EQ(1u, prof.samples(PROF_TASK + 2));
+}
+
+TEST(Profiler, FullBucketHalvesHistogram)
+{
+    Profiler prof;
+
+    for (long i = 0; i < 70000; i++)
+        prof.add_sample(PROF_PMS, 20);
+    for (int i = 0; i < 10000; i++)
+        prof.add_sample(PROF_PMS, 5000);
+
+    // shape kept: ~5/6 of the (halved) counts are still the short ones
+    EXPECT_EQ(80000u, prof.samples(PROF_PMS));
+    EXPECT_EQ(24u, prof.percentile(PROF_PMS, 50));
+    EXPECT_EQ(5000u, prof.percentile(PROF_PMS, 95));
+}
+
+TEST(Profiler, WindowIsDueAfterPeriod)
+{
+    cpu_time = 0;
+    Profiler prof;
+
+    sim_advance((PROFILE_PERIOD_MS - 1) * 1000UL);
+    EXPECT_FALSE(prof.due());
+    sim_advance(1000);
+    EXPECT_TRUE(prof.due());
+    prof.add_sample(PROF_SD, 1000);
+    prof.reset();
+    EXPECT_FALSE(prof.due());
+    EXPECT_EQ(0u, prof.samples(PROF_SD));
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
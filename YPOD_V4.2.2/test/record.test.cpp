@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include <math.h>
+#include <string>
+#include "Arduino.h"
+#include "record.h"
+
+/*  Reference: what Print::print(double, 2) in the Arduino core emits  */
+std::string arduinoPrintFloat(double number, uint8_t digits = 2)
+{
+    if (isnan(number)) return "nan";
+    if (isinf(number)) return "inf";
+    if (number > 4294967040.0) return "ovf";
+    if (number < -4294967040.0) return "ovf";
+
+    std::string out;
+    if (number < 0.0) {
+        out += '-';
+        number = -number;
+    }
+    double rounding = 0.5;
+    for (uint8_t i = 0; i < digits; ++i)
+        rounding /= 10.0;
+    number += rounding;
+
+    unsigned long int_part = (unsigned long)number;
+    double remainder = number - (double)int_part;
+    out += std::to_string(int_part);
+    if (digits > 0)
+        out += '.';
+    while (digits-- > 0) {
+        remainder *= 10.0;
+        unsigned int toPrint = (unsigned int)remainder;
+        out += std::to_string(toPrint);
+        remainder -= toPrint;
+    }
+    return out;
+}
+
+class StringSink : public Print {
+public:
+    std::string data;
+    int writes = 0;
+    size_t write(uint8_t c) {
+        data += (char)c;
+        return 1;
+    }
+    size_t write(const uint8_t *buf, size_t len) {
+        writes++;
+        data.append((const char *)buf, len);
+        return len;
+    }
+};
+
+TEST(Record, FloatsMatchArduinoPrint)
+{
+    // float (not double) like the sketch's sensor values on AVR
+    const float values[] = { 0, 1, -1, 0.004f, 0.005f, 0.015f, -0.004f, 21.456f, 45.995f,
+                             -46.85f, -99, 101325.12f, 412.5f, 1e6f, 3.14159f, 99.999f };
+    for (float v : values) {
+        Record record;
+        record.add_float(v);
+        EXPECT_EQ(arduinoPrintFloat(v), record.c_str()) << v;
+    }
+    for (int i = -20000; i <= 20000; i += 7) {
+        float v = i / 137.0f;
+        Record record;
+        record.add_float(v);
+        ASSERT_EQ(arduinoPrintFloat(v), record.c_str()) << v;
+    }
+}
+
+TEST(Record, SpecialFloats)
+{
+    Record record;
+    record.add_float(NAN);
+    record.sep();
+    record.add_float(-INFINITY);
+    record.sep();
+    record.add_float(5e9);
+    EXPECT_STREQ("nan,inf,ovf", record.c_str());
+}
+
+TEST(Record, Integers)
+{
+    Record record;
+    record.add_uint(0);
+    record.sep();
+    record.add_uint(65535);
+    record.sep();
+    record.add_int(-8388608);
+    record.sep();
+    record.add_int(2147483647);
+    record.end();
+    EXPECT_STREQ("0,65535,-8388608,2147483647\n", record.c_str());
+}
+
+TEST(Record, OneWritePerSink)
+{
+    Record record;
+    record.add("2026-10-17T12:00:00");
+    record.add(",,,YPODE8,YPOD_V4.2.2,");
+    record.add_float(21.5f);
+    record.end();
+
+    StringSink file, serial;
+    record.write_to(file);
+    record.write_to(serial);
+    EXPECT_EQ(1, file.writes);
+    EXPECT_EQ(1, serial.writes);
+    EXPECT_EQ("2026-10-17T12:00:00,,,YPODE8,YPOD_V4.2.2,21.50\n", file.data);
+    EXPECT_EQ(file.data, serial.data);
+}
+
+TEST(Record, OverflowKeepsNewline)
+{
+    Record record;
+    for (int i = 0; i < RECORD_BUF_SIZE; i++)
+        record.add_uint(1234);
+    record.end();
+    EXPECT_TRUE(record.overflow());
+    EXPECT_EQ(RECORD_BUF_SIZE - 1, record.length());
+    EXPECT_EQ('\n', record.c_str()[record.length() - 1]);
+    EXPECT_EQ('\0', record.c_str()[record.length()]);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "Arduino.h"
+#include "sensor_registry.h"
+
+/*  Drivers that log each call, so the order the registry makes them in shows  */
+std::string calls;
+
+template <char Id>
+struct LogSensor : SensorDriver {
+    static const uint32_t PERIOD_MS = 0;
+    static const uint32_t TIMEOUT_MS = 100;
+    static const char *name() {
+        static const char text[2] = { Id, '\0' };
+        return text;
+    }
+    static void begin() { calls += 'b'; calls += Id; }
+    static void tick() { calls += 't'; calls += Id; }
+    static bool start() { calls += 's'; calls += Id; return true; }
+    static bool poll() { return true; }
+    static void collect() { calls += 'c'; calls += Id; }
+};
+
+/*  One without a tick; the rest log theirs  */
+struct QuietSensor : LogSensor<'C'> {
+    static void tick() {}
+};
+
+typedef SensorList<LogSensor<'A'>, NoSensor, QuietSensor, NoSensor, LogSensor<'D'> > Sensors;
+
+TEST(Registry, CallsEachDriverInOrder)
+{
+    calls.clear();
+    Sensors::begin();
+    Sensors::tick();
+    EXPECT_EQ("bAbCbDtAtD", calls);
+}
+
+TEST(Registry, FittedSensorsGetATask)
+{
+    Scheduler scheduler;
+    Sensors::add_tasks(scheduler);
+    ASSERT_EQ(3, scheduler.task_count());
+    EXPECT_STREQ("A", scheduler.task(0)->name);
+    EXPECT_STREQ("C", scheduler.task(1)->name);
+    EXPECT_STREQ("D", scheduler.task(2)->name);
+    EXPECT_EQ(100u, scheduler.task(0)->timeout);
+
+    calls.clear();
+    cpu_time = 0;
+    scheduler.run();        // start
+    scheduler.run();        // poll & collect
+    EXPECT_EQ("sAsCsDcAcCcD", calls);
+}
+
+TEST(Registry, EmptyList)
+{
+    Scheduler scheduler;
+    SensorList<>::begin();
+    SensorList<>::add_tasks(scheduler);
+    SensorList<NoSensor, NoSensor>::add_tasks(scheduler);
+    EXPECT_EQ(0, scheduler.task_count());
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include "Arduino.h"
+#include "scheduler.h"
+
+/*  Simulated sensor tasks - each one finishes `latency` ms after start()  */
+struct SimSensor {
+    const char *name;
+    unsigned long latency;      // ms from start() to data ready
+    unsigned long legacy;       // ms the old loop() spent on it (incl. delay(100)s)
+    bool fail;
+    unsigned long started;
+    int collected;
+};
+
+// Representative YPOD conversion times
+SimSensor sensors[] = {
+    { "PMS",    150,  100 + 250 + 150, false, 0, 0 },  // passive request + 32 byte frame
+    { "SHT25",  114,  100 + 114,       false, 0, 0 },  // 85 ms T + 29 ms RH
+    { "S300",    20,  100 + 20,        false, 0, 0 },
+    { "ADS",     40,  500 + 40,        false, 0, 0 },  // 5 x 128 SPS conversions
+    { "QUAD",   268,  536,             false, 0, 0 },  // 4 x 67 ms, both MCP342x in parallel (was 8 x 67 ms)
+    { "BME180",  31,  100 + 31,        false, 0, 0 },  // 5 ms T + 26 ms P (oss 3)
+};
+const int SENSOR_COUNT = sizeof(sensors) / sizeof(sensors[0]);
+// printOutput() held 9 delay(100)s and ran twice (SD + Serial); loop() 3 more around the RTC & SD
+const unsigned long LEGACY_RECORD_DELAYS = 21 * 100;
+
+template <int N> bool sim_start()
+{
+    sensors[N].started = millis();
+    return !sensors[N].fail;
+}
+
+template <int N> bool sim_poll()
+{
+    return millis() - sensors[N].started >= sensors[N].latency;
+}
+
+template <int N> void sim_collect()
+{
+    sensors[N].collected++;
+}
+
+template <int N> void add_sim(Scheduler &scheduler, uint32_t period, uint32_t timeout = 1000)
+{
+    scheduler.add(sensors[N].name, period, timeout, sim_start<N>, sim_poll<N>, sim_collect<N>);
+}
+
+void reset_sensors()
+{
+    cpu_time = 0;
+    for (int i = 0; i < SENSOR_COUNT; i++) {
+        sensors[i].fail = false;
+        sensors[i].started = 0;
+        sensors[i].collected = 0;
+    }
+}
+
+void add_all(Scheduler &scheduler, uint32_t period = 0)
+{
+    add_sim<0>(scheduler, period);
+    add_sim<1>(scheduler, period);
+    add_sim<2>(scheduler, period);
+    add_sim<3>(scheduler, period);
+    add_sim<4>(scheduler, period);
+    add_sim<5>(scheduler, period);
+}
+
+// Runs loop() with a 1 ms tick until `records` records have been taken
+int run_records(Scheduler &scheduler, int records, unsigned long limit_ms = 60000)
+{
+    int taken = 0;
+    while (taken < records && millis() < limit_ms) {
+        scheduler.run();
+        if (scheduler.record_ready()) {
+            scheduler.record_done();
+            taken++;
+        }
+        sim_advance(1000);
+    }
+    return taken;
+}
+
+TEST(Scheduler, CycleIsBoundedBySlowestSensor)
+{
+    reset_sensors();
+    Scheduler scheduler;
+    add_all(scheduler);
+
+    ASSERT_EQ(3, run_records(scheduler, 3));
+
+    unsigned long slowest = 0, legacy = LEGACY_RECORD_DELAYS;
+    for (int i = 0; i < SENSOR_COUNT; i++) {
+        slowest = std::max(slowest, sensors[i].latency);
+        legacy += sensors[i].legacy;
+        EXPECT_EQ(3, sensors[i].collected) << sensors[i].name;
+    }
+
+    printf("  simulated cycle: %u ms (slowest sensor %lu ms, delay()-driven loop ~%lu ms)\n",
+           (unsigned)scheduler.cycle_time(), slowest, legacy);
+    EXPECT_GE(scheduler.cycle_time(), slowest);
+    EXPECT_LE(scheduler.cycle_time(), slowest + 2 * SENSOR_COUNT);
+}
+
+TEST(Scheduler, RecordPeriodHoldsRecordsBack)
+{
+    reset_sensors();
+    Scheduler scheduler;
+    add_all(scheduler);
+    scheduler.set_record_period(2000);
+
+    ASSERT_EQ(3, run_records(scheduler, 3));
+    EXPECT_EQ(2000u, scheduler.cycle_time());
+}
+
+TEST(Scheduler, SlowPeriodTaskKeepsLastValue)
+{
+    reset_sensors();
+    Scheduler scheduler;
+    add_sim<4>(scheduler, 10000);   // quad only every 10 s
+    add_sim<2>(scheduler, 0);       // S300 every record
+
+    ASSERT_EQ(20, run_records(scheduler, 20));
+    EXPECT_EQ(20, sensors[2].collected);
+    EXPECT_LT(sensors[4].collected, 3);
+    EXPECT_TRUE(scheduler.task_ok(0));
+}
+
+TEST(Scheduler, FailedStartDoesNotStallRecord)
+{
+    reset_sensors();
+    Scheduler scheduler;
+    add_all(scheduler);
+    sensors[0].fail = true;
+
+    ASSERT_EQ(2, run_records(scheduler, 2));
+    EXPECT_FALSE(scheduler.task_ok(0));
+    EXPECT_TRUE(scheduler.task_ok(1));
+    EXPECT_EQ(0, sensors[0].collected);
+}
+
+TEST(Scheduler, TimedOutTaskIsDropped)
+{
+    reset_sensors();
+    Scheduler scheduler;
+    sensors[4].latency = 5000;      // never answers within its timeout
+    add_sim<4>(scheduler, 0, 800);
+    add_sim<2>(scheduler, 0);
+
+    ASSERT_EQ(1, run_records(scheduler, 1));
+    EXPECT_FALSE(scheduler.task_ok(0));
+    EXPECT_TRUE(scheduler.task_ok(1));
+    EXPECT_GE(scheduler.cycle_time(), 800u);
+    EXPECT_LT(scheduler.cycle_time(), 900u);
+    sensors[4].latency = 268;
+}
+
+TEST(Scheduler, RejectsTasksPastTableSize)
+{
+    Scheduler scheduler;
+    for (int i = 0; i < SCHED_MAX_TASKS; i++)
+        EXPECT_EQ(i, scheduler.add("T", 0, 100, sim_start<0>, sim_poll<0>, sim_collect<0>));
+    EXPECT_EQ(-1, scheduler.add("T", 0, 100, sim_start<0>, sim_poll<0>, sim_collect<0>));
+    EXPECT_EQ(SCHED_MAX_TASKS, scheduler.task_count());
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
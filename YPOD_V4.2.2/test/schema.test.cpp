@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "Arduino.h"
+#include "schema.h"
+#include "binlog_decode.h"
+
+const uint32_t BASE_TIME = 1791849600UL;    // 2026-10-13T00:00:00
+
+/*  The sketch's variables, one of each kind a column can point at  */
+const char pod_id[] = "YPODE8";
+char firmware[32] = "YPOD_V4.2.2";
+double t_bmp = 21.456;
+float rh = 45.25f;
+int tvoc = -5;
+uint16_t fig = 65535;
+int co_cal = 129;
+long quad = -32767;
+uint32_t age = 1200;
+float mean = 8.5f;
+uint16_t count = 3;
+
+#define FLAG_PM     1
+#define FLAG_STATS  9   // past the first flags byte
+
+constexpr column_t table[] PROGMEM = {
+    COL_TIME("Timestamp", "UTC"),
+    COL_BLANK("EAST_LONGITUDE", "deg"),
+    COL_TEXT("ID", "-", BIN_POD_ID, pod_id),
+    COL_TEXT("firmware", "-", BIN_FIRMWARE, firmware),
+    COL("T_BMP", "C", BIN_F32, 0, true, t_bmp),
+    COL("RH", "%", BIN_F32, 0, true, rh),
+    COL("TVOC", "ppm", BIN_INT, 0, true, tvoc),
+    COL("Fig1", "raw", BIN_U16, 0, true, fig),
+    COL("CO", "ppm", BIN_INT_F, 0, false, co_cal),
+    COL("a1C1", "raw", BIN_I16, 0, true, quad),
+    COL("PM_age", "ms", BIN_U32, FLAG_PM, false, age),
+    COL("Fig1_mean", "raw", BIN_F32, FLAG_STATS, false, mean),
+    COL("Fig1_n", "", BIN_U16, 0, false, count),
+};
+constexpr uint8_t COLUMNS = sizeof(table) / sizeof(table[0]);
+
+const char HEADER[] = "Timestamp(UTC),EAST_LONGITUDE(deg),ID(-),firmware(-),T_BMP(C),RH(%),TVOC(ppm),"
+                      "Fig1(raw),CO(ppm),a1C1(raw),PM_age(ms),Fig1_mean(raw),Fig1_n,\n";
+
+// Sizes the sketch checks at compile time
+static_assert(schema_header_length(table, COLUMNS) == sizeof(HEADER) - 1, "header row length");
+static_assert(schema_summaries(table, COLUMNS) == 5, "summary columns");
+static_assert(schema_record_size(table, COLUMNS) == 3 + 4 + 4 + 4 + sizeof(int) + 2 + sizeof(int) + 2 + 4 + 4 + 2,
+              "binary record size");
+
+/*  Collects what a Print gets  */
+struct Text : Print {
+    std::string out;
+    size_t write(uint8_t c) { out += (char)c; return 1; }
+};
+
+std::string format(uint16_t flags, uint32_t offset)
+{
+    Schema schema(table, COLUMNS);
+    Record record;
+    record.clear();
+    schema.format(record, flags, binlog_time(BASE_TIME + offset).c_str());
+    record.end();
+    return std::string(record.c_str(), record.length());
+}
+
+TEST(Schema, HeaderRowNamesEveryColumn)
+{
+    Schema schema(table, COLUMNS);
+    Text text;
+    schema.print_header(text);
+    EXPECT_EQ(HEADER, text.out);
+    EXPECT_EQ(COLUMNS, schema.count());
+}
+
+TEST(Schema, FormatsEachKind)
+{
+    EXPECT_EQ("2026-10-13T00:00:07,,YPODE8,YPOD_V4.2.2,21.46,45.25,-5,65535,129.00,-32767,1200,8.50,3,\n",
+              format(COL_FLAG(FLAG_PM) | COL_FLAG(FLAG_STATS), 7));
+}
+
+TEST(Schema, FlaggedColumnsBlankWithoutTheirFlag)
+{
+    EXPECT_EQ("2026-10-13T00:00:07,,YPODE8,YPOD_V4.2.2,21.46,45.25,-5,65535,129.00,-32767,,,3,\n", format(0, 7));
+    EXPECT_EQ("2026-10-13T00:00:07,,YPODE8,YPOD_V4.2.2,21.46,45.25,-5,65535,129.00,-32767,1200,,3,\n",
+              format(COL_FLAG(FLAG_PM), 7));
+}
+
+TEST(Schema, BinaryDecodesToTheSameCsv)
+{
+    Schema schema(table, COLUMNS);
+    BinRecord bin;
+    std::vector<uint8_t> file;
+    std::string csv = HEADER;               // the text-mode file
+    const uint16_t flags[] = { 0, COL_FLAG(FLAG_PM), COL_FLAG(FLAG_PM) | COL_FLAG(FLAG_STATS) };
+
+    for (uint16_t f : flags) {
+        schema.encode(bin, f, 60);
+        if (file.empty()) {
+            // as the sketch's printLogHeader(): file header, then the header row
+            uint8_t header[BIN_HEADER_MAX];
+            uint16_t len = bin.header(header, BASE_TIME, pod_id, firmware, schema_header_length(table, COLUMNS));
+            file.assign(header, header + len);
+            Text row;
+            schema.print_header(row);
+            file.insert(file.end(), row.out.begin(), row.out.end());
+        }
+        file.insert(file.end(), bin.data(), bin.data() + bin.length());
+        csv += format(f, 60);
+    }
+    EXPECT_EQ(schema_record_size(table, COLUMNS), bin.length());
+
+    BinlogReader reader;
+    ASSERT_TRUE(reader.open(file.data(), file.size())) << reader.error();
+    ASSERT_EQ(3u, reader.count());
+    EXPECT_EQ(COLUMNS, reader.header().columns);
+    std::string decoded, line;
+    reader.header_csv(decoded);
+    for (size_t i = 0; i < reader.count(); i++) {
+        reader.record_csv(i, line);
+        decoded += line;
+    }
+    EXPECT_EQ(csv, decoded);
+}
+
+TEST(Schema, ValuesForTheSummaries)
+{
+    Schema schema(table, COLUMNS);
+    column_t c;
+    std::vector<double> values;
+    for (uint8_t i = 0; i < schema.count(); i++) {
+        schema.column(i, c);
+        if (c.summary)
+            values.push_back(Schema::real(c));
+    }
+    ASSERT_EQ(5u, values.size());
+    EXPECT_DOUBLE_EQ(21.456, values[0]);
+    EXPECT_FLOAT_EQ(45.25f, values[1]);
+    EXPECT_EQ(-5, values[2]);
+    EXPECT_EQ(65535, values[3]);
+    EXPECT_EQ(-32767, values[4]);
+}
+
+TEST(Schema, ValueKinds)
+{
+    EXPECT_EQ(2, col_kind(&fig));
+    EXPECT_EQ(4, col_kind(&age));
+    EXPECT_EQ(sizeof(int) | COL_SIGNED, col_kind(&tvoc));
+    EXPECT_EQ(sizeof(float) | COL_SIGNED | COL_REAL, col_kind(&rh));
+    EXPECT_EQ(sizeof(double) | COL_SIGNED | COL_REAL, col_kind(&t_bmp));
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
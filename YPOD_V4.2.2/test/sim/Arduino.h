@@ -0,0 +1,212 @@
+/*******************************************************************************
+ * @file    Arduino.h
+ * @brief   Host stand-in for the Arduino AVR core used by the whole-sketch
+ *          simulation: virtual clock, Print/Stream, HardwareSerial with a
+ *          9600 baud TX model, digital pins, the few AVR registers the
+ *          sleep code sets and PROGMEM helpers
+ *
+ * @cite    ../Arduino.h (unit-test core), libraries/MCP342x/test
+ *
+ * @author  Percy Smith, percy.smith@colorado.edu
+ * @date    October 17, 2026
+ * @log     Fake core with a virtual clock for the whole sketch
+******************************************************************************/
+#ifndef _FAKE_ARDUINO_H
+#define _FAKE_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <string>
+#include <algorithm>
+
+#include "binary.h"
+
+typedef uint8_t byte;
+typedef bool boolean;
+typedef uint16_t word;
+
+#define HIGH          0x1
+#define LOW           0x0
+#define INPUT         0x0
+#define OUTPUT        0x1
+#define INPUT_PULLUP  0x2
+
+#define CHANGE        1
+#define FALLING       2
+#define RISING        3
+#define NOT_AN_INTERRUPT  -1
+// No external interrupts on the host: sketches fall back to polling
+#define digitalPinToInterrupt(p)  NOT_AN_INTERRUPT
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+#define SS            10
+#define NUM_PINS      32
+static const uint8_t SDA = 18;  // A4 & A5, as on the Uno
+static const uint8_t SCL = 19;
+
+using std::min;     // macros on AVR; templates keep <algorithm> usable
+using std::max;
+#define sq(x) ((x)*(x))
+#define lowByte(w) ((uint8_t)((w) & 0xff))
+#define highByte(w) ((uint8_t)((w) >> 8))
+
+inline uint16_t makeWord(uint8_t h, uint8_t l) { return (h << 8) | l; }
+
+/*  Program memory is ordinary memory on the host  */
+#define PROGMEM
+#define PSTR(s) (s)
+#define pgm_read_byte(addr) (*(const unsigned char *)(addr))
+#define pgm_read_word(addr) (*(const unsigned short *)(addr))
+#define memcpy_P memcpy
+#define strcpy_P strcpy
+#define strlen_P strlen
+
+class __FlashStringHelper;
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper *>(string_literal))
+
+// Virtual clock in microseconds; only advances through delay(), sim_advance()
+// and the bus models in sim.h
+extern unsigned long cpu_time;
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned long us);
+void sim_advance(unsigned long us);
+void yield();
+inline void interrupts() {}
+inline void noInterrupts() {}
+inline void attachInterrupt(uint8_t, void (*)(), int) {}
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+
+/*  ATmega328P registers the sketch touches directly; pin-change mapping as
+ *  in the Uno's pins_arduino.h. sleep_cpu() (avr/sleep.h) wakes on them  */
+#define _BV(bit)      (1 << (bit))
+#define ADEN          7
+extern uint8_t ADCSRA;
+extern uint8_t PCICR;
+extern uint8_t PCMSK0, PCMSK1, PCMSK2;
+#define digitalPinToPCICR(p)    (((p) <= 21) ? (&PCICR) : ((uint8_t *)0))
+#define digitalPinToPCICRbit(p) (((p) <= 7) ? 2 : (((p) <= 13) ? 0 : 1))
+#define digitalPinToPCMSK(p)    (((p) <= 7) ? (&PCMSK2) : (((p) <= 13) ? (&PCMSK0) : (&PCMSK1)))
+#define digitalPinToPCMSKbit(p) (((p) <= 7) ? (p) : (((p) <= 13) ? ((p) - 8) : ((p) - 14)))
+
+/*! Minimal Arduino String - SdFat's String overloads only need c_str() */
+class String
+{
+public:
+    String(const char *str = "");
+    String(const String &other);
+    ~String();
+    String &operator=(const String &other);
+    const char *c_str() const { return buf; }
+    unsigned int length() const { return strlen(buf); }
+
+private:
+    char *buf;
+};
+
+/*! Print as in the AVR core: number formatting identical to Print.cpp */
+class Print
+{
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buf, size_t len);
+    size_t write(const char *str) {
+        return str ? write((const uint8_t *)str, strlen(str)) : 0;
+    }
+    size_t write(const char *buf, size_t len) {
+        return write((const uint8_t *)buf, len);
+    }
+    virtual int availableForWrite() { return 0; }
+    virtual void flush() {}
+    int getWriteError() { return write_error; }
+    void clearWriteError() { write_error = 0; }
+
+    size_t print(const __FlashStringHelper *str);
+    size_t print(const String &str);
+    size_t print(const char str[]);
+    size_t print(char c);
+    size_t print(unsigned char n, int base = DEC);
+    size_t print(int n, int base = DEC);
+    size_t print(unsigned int n, int base = DEC);
+    size_t print(long n, int base = DEC);
+    size_t print(unsigned long n, int base = DEC);
+    size_t print(double n, int digits = 2);
+
+    size_t println(const __FlashStringHelper *str);
+    size_t println(const String &str);
+    size_t println(const char str[]);
+    size_t println(char c);
+    size_t println(unsigned char n, int base = DEC);
+    size_t println(int n, int base = DEC);
+    size_t println(unsigned int n, int base = DEC);
+    size_t println(long n, int base = DEC);
+    size_t println(unsigned long n, int base = DEC);
+    size_t println(double n, int digits = 2);
+    size_t println();
+
+protected:
+    void setWriteError(int err = 1) { write_error = err; }
+
+private:
+    int write_error = 0;
+    size_t printNumber(unsigned long n, uint8_t base);
+    size_t printFloat(double number, uint8_t digits);
+};
+
+/*! Stream read side; readBytes() takes only what is already buffered */
+class Stream : public Print
+{
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+    void setTimeout(unsigned long timeout) { (void)timeout; }
+    size_t readBytes(char *buf, size_t len);
+    size_t readBytes(uint8_t *buf, size_t len) {
+        return readBytes((char *)buf, len);
+    }
+};
+
+#define SERIAL_TX_BUFFER_SIZE 64   // HardwareSerial.h
+
+/*! UART0: every byte is captured; TX blocks like the AVR core once its
+ *  64-byte buffer is full, and flush() waits for the last stop bit */
+class HardwareSerial : public Stream
+{
+public:
+    HardwareSerial();
+    void begin(unsigned long baud);
+    void end();
+    int available() override;
+    int read() override;
+    int peek() override;
+    int availableForWrite() override;
+    void flush() override;
+    size_t write(uint8_t c) override;
+    using Print::write;
+    operator bool() { return true; }
+
+    std::string sim_out;                // everything written since begin()
+
+private:
+    unsigned long baud;
+    unsigned long tx_done;              // cpu_time when the TX buffer is empty
+};
+
+extern HardwareSerial Serial;
+
+#endif  //_FAKE_ARDUINO_H
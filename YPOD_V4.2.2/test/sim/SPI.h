@@ -0,0 +1,45 @@
+/*******************************************************************************
+ * @file    SPI.h
+ * @brief   Host stand-in for the AVR SPI library; every byte is exchanged with
+ *          the simulated SD card in sim.h, which charges its transfer time
+ *
+ * @author  Percy Smith, percy.smith@colorado.edu
+ * @date    October 17, 2026
+ * @log     SPI bytes timed against the simulated SD card
+******************************************************************************/
+#ifndef _FAKE_SPI_H
+#define _FAKE_SPI_H
+
+#include "Arduino.h"
+
+#define SPI_MODE0 0x00
+#define MSBFIRST  1
+
+class SPISettings
+{
+public:
+    SPISettings() : clock(4000000) {}
+    SPISettings(uint32_t clock, uint8_t bitOrder, uint8_t dataMode) : clock(clock) {
+        (void)bitOrder;
+        (void)dataMode;
+    }
+    uint32_t clock;
+};
+
+class SPIClass
+{
+public:
+    void begin() {}
+    void end() {}
+    void beginTransaction(SPISettings settings);
+    void endTransaction() {}
+    uint8_t transfer(uint8_t data);
+    void transfer(void *buf, size_t count);
+
+private:
+    uint32_t clock;
+};
+
+extern SPIClass SPI;
+
+#endif  //_FAKE_SPI_H
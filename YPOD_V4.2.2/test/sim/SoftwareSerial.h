@@ -0,0 +1,37 @@
+/*******************************************************************************
+ * @file    SoftwareSerial.h
+ * @brief   Host stand-in for SoftwareSerial; RX comes from the simulated
+ *          PMS5003 in sim.h through the same 64-byte buffer the RX
+ *          interrupt fills on the board (overflowing bytes are dropped)
+ *
+ * @author  Percy Smith, percy.smith@colorado.edu
+ * @date    October 17, 2026
+ * @log     PMS5003 port with the board's 64-byte RX buffer
+******************************************************************************/
+#ifndef _FAKE_SOFTWARE_SERIAL_H
+#define _FAKE_SOFTWARE_SERIAL_H
+
+#include "Arduino.h"
+
+#define _SS_MAX_RX_BUFF 64
+
+class SoftwareSerial : public Stream
+{
+public:
+    SoftwareSerial(uint8_t rx, uint8_t tx) : rx_pin(rx), tx_pin(tx) {}
+    void begin(long speed);
+    bool listen() { return true; }
+    bool stopListening() { return true; }   // the PMS model sends nothing asleep
+    bool overflow();
+    int available() override;
+    int read() override;
+    int peek() override;
+    size_t write(uint8_t c) override;
+    using Print::write;
+
+private:
+    uint8_t rx_pin;
+    uint8_t tx_pin;
+};
+
+#endif  //_FAKE_SOFTWARE_SERIAL_H
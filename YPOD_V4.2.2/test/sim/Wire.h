@@ -0,0 +1,63 @@
+/*******************************************************************************
+ * @file    Wire.h
+ * @brief   Host stand-in for the AVR TwoWire class; transactions go to the
+ *          simulated I2C bus in sim.h, which charges their bus time
+ *
+ * @author  Percy Smith, percy.smith@colorado.edu
+ * @date    October 17, 2026
+ * @log     TwoWire on the simulated I2C bus, with its timeout
+******************************************************************************/
+#ifndef _FAKE_WIRE_H
+#define _FAKE_WIRE_H
+
+#include "Arduino.h"
+
+#define BUFFER_LENGTH 32
+#define WIRE_HAS_TIMEOUT
+
+class TwoWire : public Stream
+{
+public:
+    TwoWire();
+    void begin();
+    void end();
+    void setClock(uint32_t clock);
+    void setWireTimeout(uint32_t timeout = 25000, bool reset_with_timeout = false);
+    bool getWireTimeoutFlag() { return timeout_flag; }
+    void clearWireTimeoutFlag() { timeout_flag = false; }
+
+    void beginTransmission(uint8_t address);
+    void beginTransmission(int address) { beginTransmission((uint8_t)address); }
+    uint8_t endTransmission(uint8_t stop = true);
+
+    uint8_t requestFrom(uint8_t address, uint8_t quantity, uint8_t stop = true);
+    uint8_t requestFrom(int address, int quantity) {
+        return requestFrom((uint8_t)address, (uint8_t)quantity);
+    }
+    uint8_t requestFrom(int address, int quantity, int stop) {
+        return requestFrom((uint8_t)address, (uint8_t)quantity, (uint8_t)stop);
+    }
+
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *buf, size_t len) override;
+    using Print::write;
+    int available() override;
+    int read() override;
+    int peek() override;
+
+private:
+    uint8_t tx_address;
+    uint8_t tx_buf[BUFFER_LENGTH];
+    uint8_t tx_len;
+    bool transmitting;
+    uint8_t rx_buf[BUFFER_LENGTH];
+    uint8_t rx_len;
+    uint8_t rx_index;
+    uint32_t timeout_us;
+    bool timeout_flag;
+    bool stuck();
+};
+
+extern TwoWire Wire;
+
+#endif  //_FAKE_WIRE_H
@@ -0,0 +1,26 @@
+/*******************************************************************************
+ * @file    sleep.h
+ * @brief   Host stand-in for <avr/sleep.h>: sleep_cpu() hands the virtual
+ *          clock to sim_sleep_cpu() (sim_core.cpp), which runs it forward to
+ *          the next change on a pin with its pin-change interrupt enabled
+ *
+ * @author  Percy Smith, percy.smith@colorado.edu
+ * @date    October 17, 2026
+ * @log     sleep_cpu() for the duty-cycled sim runs
+******************************************************************************/
+#ifndef _FAKE_AVR_SLEEP_H
+#define _FAKE_AVR_SLEEP_H
+
+#include "../Arduino.h"
+
+#define SLEEP_MODE_IDLE       0
+#define SLEEP_MODE_PWR_DOWN   2
+
+void sim_sleep_cpu();
+
+inline void set_sleep_mode(uint8_t mode) { (void)mode; }
+inline void sleep_enable() {}
+inline void sleep_disable() {}
+inline void sleep_cpu() { sim_sleep_cpu(); }
+
+#endif  //_FAKE_AVR_SLEEP_H
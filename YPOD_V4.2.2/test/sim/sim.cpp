@@ -0,0 +1,991 @@
+/*******************************************************************************
+ * @file    sim.cpp
+ * @brief   Board models for the whole-sketch simulation (see sim.h)
+ *
+ * @cite    TI ADS1115, Sensirion SHT2x, ELT S300, Maxim DS3231, Microchip
+ *          MCP3424, Plantower PMS5003 datasheets; SD Physical Layer
+ *          Simplified Specification (SPI mode)
+ *
+ * @author  Percy Smith, percy.smith@colorado.edu
+ * @date    October 17, 2026
+ * @log     Sensor, RTC, PMS & SD card models
+******************************************************************************/
+#include "sim.h"
+#include <SdFat.h>
+#include <RTClib.h>
+
+SimI2C sim_i2c;
+SimPMS5003 *sim_pms;
+SimSDCard *sim_sd;
+SimDS3231 *sim_rtc;
+
+static uint8_t bcd(uint8_t v) { return ((v / 10) << 4) | (v % 10); }
+static uint8_t unbcd(uint8_t v) { return (v >> 4) * 10 + (v & 0x0F); }
+
+/*  SimTrace  */
+SimTrace::SimTrace(double value)
+{
+    set(value);
+}
+
+void SimTrace::set(double value)
+{
+    points.clear();
+    points.push_back(std::make_pair(0UL, value));
+}
+
+void SimTrace::add(unsigned long ms, double value)
+{
+    if (points.size() == 1 && points[0].first == 0 && ms == 0)
+        points.clear();
+    points.push_back(std::make_pair(ms, value));
+}
+
+double SimTrace::at(unsigned long ms) const
+{
+    if (points.empty())
+        return 0;
+    if (ms <= points.front().first)
+        return points.front().second;
+    for (size_t i = 1; i < points.size(); i++) {
+        if (ms <= points[i].first) {
+            const std::pair<unsigned long, double> &a = points[i - 1], &b = points[i];
+            return a.second + (b.second - a.second) * (double)(ms - a.first) / (double)(b.first - a.first);
+        }
+    }
+    return points.back().second;
+}
+
+/*  SimI2C - 9 clocks per byte plus the address byte  */
+SimI2C::SimI2C()
+{
+    clock = 100000;
+    transfers = nacks = bytes = busy_us = 0;
+    stuck_bits = 0;
+    scl_pulses = 0;
+}
+
+void SimI2C::attach(SimI2CDevice *device)
+{
+    devices.push_back(device);
+}
+
+void SimI2C::detach_all()
+{
+    devices.clear();
+}
+
+void SimI2C::set_clock(uint32_t hz)
+{
+    clock = hz;
+}
+
+SimI2CDevice *SimI2C::find(uint8_t address)
+{
+    for (size_t i = 0; i < devices.size(); i++)
+        if (devices[i]->address == address)
+            return devices[i];
+    return NULL;
+}
+
+void SimI2C::charge(uint8_t len)
+{
+    bytes += len + 1;
+    sim_advance(SIM_I2C_OVERHEAD_US + (len + 1) * 9 * 1000000UL / clock);
+}
+
+bool SimI2C::write(uint8_t address, const uint8_t *buf, uint8_t len)
+{
+    unsigned long start = cpu_time;
+    bool ack = true;
+
+    transfers++;
+    if (address == 0) {
+        for (size_t i = 0; i < devices.size() && len > 0; i++)
+            devices[i]->general_call(buf[0]);
+        charge(len);
+    } else {
+        SimI2CDevice *device = find(address);
+        ack = device && device->write(buf, len);
+        charge(ack ? len : 0);
+    }
+
+    if (!ack)
+        nacks++;
+    busy_us += cpu_time - start;
+    return ack;
+}
+
+uint8_t SimI2C::read(uint8_t address, uint8_t *buf, uint8_t len)
+{
+    unsigned long start = cpu_time;
+    SimI2CDevice *device = find(address);
+    uint8_t n = device ? device->read(buf, len) : 0;   // may stretch the clock
+
+    transfers++;
+    charge(n);
+    if (!n)
+        nacks++;
+    busy_us += cpu_time - start;
+    return n;
+}
+
+void SimI2C::scl_pulse()
+{
+    scl_pulses++;
+    if (stuck_bits)
+        stuck_bits--;
+}
+
+/*  SimADS1115  */
+static const uint16_t ADS_SPS[8] = { 8, 16, 32, 64, 128, 250, 475, 860 };
+
+void SimADS1115::reset()
+{
+    pointer = 0;
+    reg[0] = 0;
+    reg[1] = 0x8583;
+    reg[2] = 0x8000;
+    reg[3] = 0x7FFF;
+    done_at = 0;
+    pending = 0;
+    conversions = 0;
+}
+
+bool SimADS1115::write(const uint8_t *buf, uint8_t len)
+{
+    if (len == 0)
+        return true;
+
+    pointer = buf[0] & 0x03;
+    if (len < 3)
+        return true;
+
+    uint16_t value = (buf[1] << 8) | buf[2];
+    if (pointer == 0)
+        return true;
+    reg[pointer] = value;
+
+    if (pointer == 1 && (value & 0x8000)) {
+        uint8_t mux = (value >> 12) & 0x07;
+        double counts = mux >= 4 ? ain[mux - 4].now() : ain[0].now() - ain[(mux == 0) ? 1 : 3].now();
+        if (counts > 32767) counts = 32767;
+        if (counts < -32768) counts = -32768;
+        pending = (uint16_t)(int16_t)lround(counts);
+        done_at = cpu_time + 1000000UL / ADS_SPS[(value >> 5) & 0x07] + 10;
+        reg[1] &= 0x7FFF;
+        conversions++;
+    }
+    return true;
+}
+
+uint8_t SimADS1115::read(uint8_t *buf, uint8_t len)
+{
+    if (done_at && cpu_time >= done_at) {
+        reg[0] = pending;
+        reg[1] |= 0x8000;
+        done_at = 0;
+    }
+
+    uint16_t value = reg[pointer];
+    for (uint8_t i = 0; i < len; i++)
+        buf[i] = (i & 1) ? (value & 0xFF) : (value >> 8);
+    return len;
+}
+
+/*  SimSHT2x - RH 12 bit / T 14 bit (user register 0x02)  */
+#define SHT_T_US    85000UL
+#define SHT_RH_US   29000UL
+
+static uint8_t sht_crc(const uint8_t *data, uint8_t len)
+{
+    uint8_t crc = 0;
+    for (uint8_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8; bit++)
+            crc = (crc & 0x80) ? (crc << 1) ^ 0x31 : (crc << 1);
+    }
+    return crc;
+}
+
+void SimSHT2x::reset()
+{
+    command = 0;
+    done_at = 0;
+    result = 0;
+    user_reg = 0x02;
+    measurements = 0;
+    corrupt = 0;
+}
+
+bool SimSHT2x::write(const uint8_t *buf, uint8_t len)
+{
+    if (len == 0)
+        return true;
+
+    command = buf[0];
+    switch (command) {
+    case 0xE3:
+    case 0xF3: {
+        double raw = (temperature.now() + 46.85) * 65536.0 / 175.72;
+        result = (uint16_t)lround(raw < 0 ? 0 : raw > 65532 ? 65532 : raw) & 0xFFFC;
+        done_at = cpu_time + SHT_T_US;
+        measurements++;
+        break;
+    }
+    case 0xE5:
+    case 0xF5: {
+        double raw = (humidity.now() + 6.0) * 65536.0 / 125.0;
+        result = ((uint16_t)lround(raw < 0 ? 0 : raw > 65532 ? 65532 : raw) & 0xFFFC) | 0x02;
+        done_at = cpu_time + SHT_RH_US;
+        measurements++;
+        break;
+    }
+    case 0xE6:
+        if (len > 1)
+            user_reg = buf[1];
+        break;
+    case 0xFE:
+        user_reg = 0x02;
+        done_at = cpu_time + 15000;
+        break;
+    }
+    return true;
+}
+
+uint8_t SimSHT2x::read(uint8_t *buf, uint8_t len)
+{
+    if (command == 0xE7) {
+        buf[0] = user_reg;
+        return 1;
+    }
+    if (command != 0xE3 && command != 0xE5 && command != 0xF3 && command != 0xF5)
+        return 0;
+
+    if (cpu_time < done_at) {
+        if (command == 0xF3 || command == 0xF5)
+            return 0;                       // no hold: NACK until done
+        sim_advance(done_at - cpu_time);    // hold master: SCL held low
+    }
+
+    uint8_t frame[3] = { (uint8_t)(result >> 8), (uint8_t)(result & 0xFF), 0 };
+    frame[2] = sht_crc(frame, 2);
+    if (corrupt) {
+        frame[2] ^= 0x5A;
+        corrupt--;
+    }
+    if (len > 3)
+        len = 3;
+    memcpy(buf, frame, len);
+    command = 0;
+    return len;
+}
+
+/*  SimS300  */
+void SimS300::reset()
+{
+    command = 0;
+    reads = 0;
+    status = 0x08;
+    short_reads = 0;
+}
+
+bool SimS300::write(const uint8_t *buf, uint8_t len)
+{
+    if (len > 0)
+        command = buf[0];
+    return true;
+}
+
+uint8_t SimS300::read(uint8_t *buf, uint8_t len)
+{
+    if (command != 0x52)
+        return 0;
+
+    uint16_t ppm = (uint16_t)lround(co2.now());
+    memset(buf, 0, len);
+    buf[0] = status;
+    if (len > 1) buf[1] = ppm >> 8;
+    if (len > 2) buf[2] = ppm & 0xFF;
+    reads++;
+    if (short_reads && len > 2) {
+        short_reads--;
+        return 2;
+    }
+    return len;
+}
+
+/*  SimDS3231 - 24 h clock, OSF clear  */
+void SimDS3231::reset()
+{
+    memset(reg, 0, sizeof(reg));
+    reg[0x0E] = 0x1C;
+    reg[0x11] = 25;
+    pointer = 0;
+    base = DateTime(2026, 1, 1).unixtime();
+    base_us = cpu_time;
+    alarm_seen = base;
+    reads = 0;
+    alarms = 0;
+}
+
+void SimDS3231::set(uint32_t unixtime)
+{
+    base = unixtime;
+    base_us = cpu_time;
+    alarm_seen = unixtime;
+}
+
+uint32_t SimDS3231::unixtime() const
+{
+    return base + (cpu_time - base_us) / 1000000UL;
+}
+
+int SimDS3231::sqw()
+{
+    check_alarm();
+    if (reg[0x0E] & 0x04)   // INTCN: low while an enabled alarm flag is set
+        return (reg[0x0E] & reg[0x0F] & 0x03) ? LOW : HIGH;
+    if (reg[0x0E] & 0x18)   // not 1 Hz
+        return HIGH;
+    return (cpu_time - base_us) % 1000000UL < 500000UL ? LOW : HIGH;
+}
+
+// SQW/INT only changes on the half seconds of the time registers
+unsigned long SimDS3231::next_change() const
+{
+    return base_us + ((cpu_time - base_us) / 500000UL + 1) * 500000UL;
+}
+
+// A1F for every second since the last look that matched alarm 1
+void SimDS3231::check_alarm()
+{
+    uint32_t now = unixtime();
+    if (now - alarm_seen > 40 * 86400UL)
+        alarm_seen = now - 40 * 86400UL;
+    while (alarm_seen < now) {
+        alarm_seen++;
+        if (alarm1_at(alarm_seen)) {
+            if (!(reg[0x0F] & 0x01))
+                alarms++;
+            reg[0x0F] |= 0x01;
+        }
+    }
+}
+
+// A1M1..A1M4 (bit 7 of 0x07..0x0A) set = that field is not compared
+bool SimDS3231::alarm1_at(uint32_t t) const
+{
+    DateTime now(t);
+    const uint8_t *a = &reg[0x07];
+    if (!(a[0] & 0x80) && unbcd(a[0] & 0x7F) != now.second())
+        return false;
+    if (!(a[1] & 0x80) && unbcd(a[1] & 0x7F) != now.minute())
+        return false;
+    if (!(a[2] & 0x80) && unbcd(a[2] & 0x3F) != now.hour())
+        return false;
+    if (a[3] & 0x80)
+        return true;
+    if (a[3] & 0x40)        // DY/DT: day of the week, Sunday = 7
+        return unbcd(a[3] & 0x0F) == (now.dayOfTheWeek() == 0 ? 7 : now.dayOfTheWeek());
+    return unbcd(a[3] & 0x3F) == now.day();
+}
+
+uint8_t SimDS3231::reg_value(uint8_t r) const
+{
+    if (r > 6)
+        return reg[r];
+
+    DateTime now(unixtime());
+    switch (r) {
+    case 0: return bcd(now.second());
+    case 1: return bcd(now.minute());
+    case 2: return bcd(now.hour());
+    case 3: return bcd(now.dayOfTheWeek() == 0 ? 7 : now.dayOfTheWeek());
+    case 4: return bcd(now.day());
+    case 5: return bcd(now.month());
+    default: return bcd(now.year() - 2000);
+    }
+}
+
+bool SimDS3231::write(const uint8_t *buf, uint8_t len)
+{
+    if (len == 0)
+        return true;
+
+    check_alarm();          // seconds already passed count against the old alarm
+    uint8_t time[7];
+    bool set_time = false;
+    for (uint8_t i = 0; i < 7; i++)
+        time[i] = reg_value(i);
+
+    pointer = buf[0] % sizeof(reg);
+    for (uint8_t i = 1; i < len; i++) {
+        if (pointer <= 6) {
+            time[pointer] = buf[i];
+            set_time = true;
+        } else {
+            reg[pointer] = buf[i];
+        }
+        pointer = (pointer + 1) % sizeof(reg);
+    }
+
+    if (set_time) {
+        DateTime t(2000 + unbcd(time[6]), unbcd(time[5] & 0x1F), unbcd(time[4]),
+                   unbcd(time[2] & 0x3F), unbcd(time[1]), unbcd(time[0]));
+        set(t.unixtime());
+    }
+    return true;
+}
+
+uint8_t SimDS3231::read(uint8_t *buf, uint8_t len)
+{
+    if (pointer == 0)
+        reads++;
+    check_alarm();
+    for (uint8_t i = 0; i < len; i++) {
+        buf[i] = reg_value(pointer);
+        pointer = (pointer + 1) % sizeof(reg);
+    }
+    return len;
+}
+
+/*  SimMCP342x  */
+static const unsigned long MCP_US[4] = { 4167, 16667, 66667, 266667 };
+static const long MCP_MAX[4] = { 2047, 8191, 32767, 131071 };
+
+void SimMCP342x::reset()
+{
+    config = 0x90;
+    done_at = 0;
+    result = 0;
+    fresh = false;
+    conversions = 0;
+    reads = 0;
+    nack_channel = -1;
+}
+
+void SimMCP342x::start()
+{
+    uint8_t res = (config >> 2) & 0x03;
+    double value = ch[(config >> 5) & 0x03].now();
+
+    if (value > MCP_MAX[res]) value = MCP_MAX[res];
+    if (value < -MCP_MAX[res] - 1) value = -MCP_MAX[res] - 1;
+    result = lround(value);
+    done_at = cpu_time + MCP_US[res];
+    fresh = true;
+    conversions++;
+}
+
+bool SimMCP342x::write(const uint8_t *buf, uint8_t len)
+{
+    if (len == 0)
+        return true;
+
+    if (nack_channel == ((buf[0] >> 5) & 0x03)) {
+        nack_channel = -1;
+        return false;
+    }
+    config = buf[0];
+    if (config & 0x80)
+        start();
+    return true;
+}
+
+void SimMCP342x::general_call(uint8_t cmd)
+{
+    if (cmd == 0x06)
+        reset();
+    else if (cmd == 0x08)
+        start();
+}
+
+uint8_t SimMCP342x::read(uint8_t *buf, uint8_t len)
+{
+    bool ready = fresh && cpu_time >= done_at;
+    uint8_t cfg = (config & 0x7F) | (ready ? 0 : 0x80);
+    uint8_t data[4];
+    uint8_t n = 0;
+
+    reads++;
+    if (((config >> 2) & 0x03) == 3)
+        data[n++] = (result >> 16) & 0xFF;
+    data[n++] = (result >> 8) & 0xFF;
+    data[n++] = result & 0xFF;
+
+    for (uint8_t i = 0; i < len; i++)
+        buf[i] = i < n ? data[i] : cfg;
+    return len;
+}
+
+/*  SimPMS5003 - 9600 8N1, 32 byte frames  */
+#define PMS_BYTE_US      1042
+#define PMS_RX_BUFF      63     // SoftwareSerial keeps one slot free
+
+void SimPMS5003::reset()
+{
+    pm1.set(5);
+    pm25.set(8);
+    pm10.set(12);
+    latency_ms = 40;
+    interval_ms = 1000;
+    frames = rx_bytes = dropped = 0;
+    asleep = false;
+    woke_at = slept_at = asleep_us = 0;
+    wire.clear();
+    rx.clear();
+    cmd_len = 0;
+    passive = false;
+    next_active = 1000000UL;
+    overflow = false;
+}
+
+void SimPMS5003::send_frame(unsigned long at)
+{
+    uint16_t words[13];
+    uint16_t pm[3] = { (uint16_t)lround(pm1.at(at / 1000)),
+                       (uint16_t)lround(pm25.at(at / 1000)),
+                       (uint16_t)lround(pm10.at(at / 1000)) };
+    uint8_t frame[32] = { 0x42, 0x4D, 0x00, 28 };
+    uint16_t sum = 0;
+
+    for (int i = 0; i < 3; i++) {
+        words[i] = pm[i];           // CF=1 standard
+        words[3 + i] = pm[i];       // atmospheric
+    }
+    words[6] = pm[0] * 150;         // > 0.3 um / 0.1 L
+    words[7] = pm[0] * 45;
+    words[8] = pm[1] * 8;
+    words[9] = pm[1];
+    words[10] = pm[2] / 4;
+    words[11] = pm[2] / 10;
+    words[12] = 0;                  // reserved
+    for (int i = 0; i < 13; i++) {
+        frame[4 + 2 * i] = words[i] >> 8;
+        frame[5 + 2 * i] = words[i] & 0xFF;
+    }
+    for (int i = 0; i < 30; i++)
+        sum += frame[i];
+    frame[30] = sum >> 8;
+    frame[31] = sum & 0xFF;
+
+    if (!wire.empty() && wire.back().first > at)
+        at = wire.back().first;
+    for (int i = 0; i < 32; i++) {
+        at += PMS_BYTE_US;
+        wire.push_back(std::make_pair(at, frame[i]));
+    }
+    frames++;
+}
+
+void SimPMS5003::receive()
+{
+    while (!passive && !asleep && next_active <= cpu_time) {
+        send_frame(next_active);
+        next_active += interval_ms * 1000UL;
+    }
+
+    while (!wire.empty() && wire.front().first <= cpu_time) {
+        rx_bytes++;
+        if (rx.size() < PMS_RX_BUFF) {
+            rx.push_back(wire.front().second);
+        } else {
+            dropped++;
+            overflow = true;
+        }
+        wire.pop_front();
+    }
+}
+
+void SimPMS5003::command(uint8_t c)
+{
+    if (cmd_len == 0 && c != 0x42)
+        return;
+    cmd[cmd_len++] = c;
+    if (cmd_len < 7)
+        return;
+    cmd_len = 0;
+
+    uint16_t sum = 0;
+    for (int i = 0; i < 5; i++)
+        sum += cmd[i];
+    if (cmd[1] != 0x4D || sum != ((cmd[5] << 8) | cmd[6]))
+        return;
+
+    receive();
+    switch (cmd[2]) {
+    case 0xE1:
+        passive = cmd[4] == 0;
+        if (!passive)
+            next_active = cpu_time + interval_ms * 1000UL;
+        break;
+    case 0xE2:
+        if (passive && !asleep)
+            send_frame(cpu_time + latency_ms * 1000UL);
+        break;
+    case 0xE4:              // keeps its mode over a sleep
+        if (cmd[4] == 0 && !asleep) {
+            asleep = true;
+            slept_at = cpu_time;
+        } else if (cmd[4] == 1 && asleep) {
+            asleep = false;
+            asleep_us += cpu_time - slept_at;
+            woke_at = cpu_time;
+            next_active = cpu_time + interval_ms * 1000UL;
+        }
+        break;
+    }
+}
+
+int SimPMS5003::available()
+{
+    receive();
+    return rx.size();
+}
+
+int SimPMS5003::read()
+{
+    receive();
+    if (rx.empty())
+        return -1;
+    uint8_t c = rx.front();
+    rx.pop_front();
+    return c;
+}
+
+int SimPMS5003::peek()
+{
+    receive();
+    return rx.empty() ? -1 : rx.front();
+}
+
+bool SimPMS5003::overflowed()
+{
+    bool was = overflow;
+    overflow = false;
+    return was;
+}
+
+/*  SimSDCard  */
+#define SD_R1_IDLE      0x01
+#define SD_R1_ILLEGAL   0x04
+#define SD_R1_PARAM     0x40
+
+SimSDCard::SimSDCard(uint8_t cs, uint32_t sectors) : cs(cs), sector_count(sectors)
+{
+    write_busy_us = 400;
+    erase_busy_us = 1000;
+    reset();
+}
+
+void SimSDCard::reset()
+{
+    image.clear();
+    out.clear();
+    cmd_len = 0;
+    app_cmd = false;
+    idle = true;
+    selected = false;
+    state = CARD_CMD;
+    write_multi = false;
+    address = erase_start = erase_end = 0;
+    busy_until = 0;
+    sectors_written = sectors_read = erases = 0;
+}
+
+const uint8_t *SimSDCard::sector(uint32_t n) const
+{
+    std::map<uint32_t, std::vector<uint8_t> >::const_iterator it = image.find(n);
+    return it == image.end() ? NULL : &it->second[0];
+}
+
+void SimSDCard::select(bool selected)
+{
+    this->selected = selected;
+    if (!selected) {
+        out.clear();
+        cmd_len = 0;
+    }
+}
+
+void SimSDCard::busy(unsigned long us)
+{
+    busy_until = cpu_time + us;
+}
+
+void SimSDCard::respond(uint8_t r1)
+{
+    out.push_back(0xFF);
+    out.push_back(r1);
+}
+
+void SimSDCard::queue_data(const uint8_t *data, uint16_t len)
+{
+    out.push_back(0xFF);
+    out.push_back(0xFE);
+    for (uint16_t i = 0; i < len; i++)
+        out.push_back(data ? data[i] : 0);
+    out.push_back(0xFF);
+    out.push_back(0xFF);
+}
+
+void SimSDCard::queue_sector(uint32_t n)
+{
+    sectors_read++;
+    queue_data(sector(n), 512);
+}
+
+void SimSDCard::command()
+{
+    uint8_t index = cmd_buf[0] & 0x3F;
+    uint32_t arg = ((uint32_t)cmd_buf[1] << 24) | ((uint32_t)cmd_buf[2] << 16) |
+                   ((uint32_t)cmd_buf[3] << 8) | cmd_buf[4];
+    uint8_t r1 = idle ? SD_R1_IDLE : 0;
+    bool acmd = app_cmd;
+
+    out.clear();
+    app_cmd = false;
+
+    if (acmd && index == 41) {
+        idle = false;
+        respond(0);
+        return;
+    }
+    if (acmd && index == 13) {
+        respond(r1);
+        out.push_back(0);
+        queue_data(NULL, 64);
+        return;
+    }
+    if (acmd && index == 51) {
+        const uint8_t scr[8] = { 0x02, 0x35, 0x80, 0x00 };
+        respond(r1);
+        queue_data(scr, sizeof(scr));
+        return;
+    }
+    if (acmd && index == 23) {
+        respond(r1);
+        return;
+    }
+
+    switch (index) {
+    case 0:
+        idle = true;
+        state = CARD_CMD;
+        respond(SD_R1_IDLE);
+        break;
+    case 8:
+        respond(r1);
+        out.push_back(0x00);
+        out.push_back(0x00);
+        out.push_back(0x01);
+        out.push_back(0xAA);
+        break;
+    case 55:
+        app_cmd = true;
+        respond(r1);
+        break;
+    case 58:
+        respond(r1);
+        out.push_back(0xC0);        // powered up, SDHC
+        out.push_back(0xFF);
+        out.push_back(0x80);
+        out.push_back(0x00);
+        break;
+    case 9: {
+        uint32_t c_size = sector_count / 1024 - 1;
+        uint8_t csd[16] = { 0x40, 0x0E, 0x00, 0x32, 0x5B, 0x59, 0x00,
+                            (uint8_t)((c_size >> 16) & 0x3F), (uint8_t)(c_size >> 8), (uint8_t)c_size,
+                            0x7F, 0x80, 0x0A, 0x40, 0x00, 0x01 };
+        respond(r1);
+        queue_data(csd, sizeof(csd));
+        break;
+    }
+    case 10:
+        respond(r1);
+        queue_data(NULL, 16);
+        break;
+    case 6:
+        respond(r1);
+        queue_data(NULL, 64);
+        break;
+    case 13:
+        respond(r1);
+        out.push_back(0);
+        break;
+    case 12:
+        state = CARD_CMD;
+        respond(r1);
+        break;
+    case 17:
+    case 18:
+        if (arg >= sector_count) {
+            respond(SD_R1_PARAM);
+            break;
+        }
+        respond(r1);
+        if (index == 17) {
+            queue_sector(arg);
+        } else {
+            state = CARD_READ_MULTI;
+            address = arg;
+        }
+        break;
+    case 24:
+    case 25:
+        if (arg >= sector_count) {
+            respond(SD_R1_PARAM);
+            break;
+        }
+        respond(r1);
+        state = CARD_WRITE_TOKEN;
+        write_multi = index == 25;
+        address = arg;
+        break;
+    case 32:
+        erase_start = arg;
+        respond(r1);
+        break;
+    case 33:
+        erase_end = arg;
+        respond(r1);
+        break;
+    case 38: {
+        std::map<uint32_t, std::vector<uint8_t> >::iterator it = image.lower_bound(erase_start);
+        while (it != image.end() && it->first <= erase_end)
+            image.erase(it++);
+        erases++;
+        respond(r1);
+        busy(erase_busy_us * ((erase_end - erase_start) / 2048 + 1));
+        break;
+    }
+    case 59:
+        respond(r1);
+        break;
+    default:
+        respond(r1 | SD_R1_ILLEGAL);
+        break;
+    }
+}
+
+void SimSDCard::data_byte(uint8_t in)
+{
+    block.push_back(in);
+    if (block.size() < 512 + 2)
+        return;
+
+    block.resize(512);
+    image[address] = block;
+    sectors_written++;
+    out.push_back(0x05);            // data accepted
+    busy(write_busy_us);
+
+    if (write_multi && ++address < sector_count) {
+        state = CARD_WRITE_TOKEN;
+    } else {
+        state = CARD_CMD;
+    }
+}
+
+uint8_t SimSDCard::transfer(uint8_t in)
+{
+    uint8_t r = 0xFF;
+
+    if (!out.empty()) {
+        r = out.front();
+        out.pop_front();
+    } else if (state == CARD_READ_MULTI) {
+        queue_sector(address++);
+    } else if (cpu_time < busy_until) {
+        r = 0x00;                   // programming: MISO held low
+    }
+
+    switch (state) {
+    case CARD_WRITE_TOKEN:
+        if (in == 0xFE || in == 0xFC) {
+            block.clear();
+            state = CARD_WRITE_DATA;
+        } else if (in == 0xFD) {
+            state = CARD_CMD;
+            busy(write_busy_us);
+        }
+        break;
+    case CARD_WRITE_DATA:
+        data_byte(in);
+        break;
+    default:
+        if (cmd_len > 0 || (in & 0xC0) == 0x40) {
+            cmd_buf[cmd_len++] = in;
+            if (cmd_len == sizeof(cmd_buf)) {
+                cmd_len = 0;
+                command();
+            }
+        }
+        break;
+    }
+    return r;
+}
+
+bool SimSDCard::format()
+{
+    SdFat32 fs;
+    bool ok = fs.cardBegin(SdSpiConfig(cs, SHARED_SPI)) && fs.format();
+    fs.end();
+    sectors_written = sectors_read = erases = 0;
+    busy_until = 0;
+    return ok;
+}
+
+/*  SimBoard  */
+SimBoard::SimBoard()
+    : ads48(0x48), ads49(0x49), rtc(5), alpha_one(0x69), alpha_two(0x6E), sd(4, 131072)  // SQW on pin 5, 64 MB card
+{
+    sim_i2c.detach_all();
+    sim_i2c.attach(&ads48);
+    sim_i2c.attach(&ads49);
+    sim_i2c.attach(&sht25);
+    sim_i2c.attach(&s300);
+    sim_i2c.attach(&rtc);
+    sim_i2c.attach(&alpha_one);
+    sim_i2c.attach(&alpha_two);
+    sim_pms = &pms;
+    sim_sd = &sd;
+    sim_rtc = &rtc;
+
+    // Fig 1 heater, Fig 1, Fig 2 heater, Fig 2 | CO ch1, CO ch2, e2V heater, e2V
+    const double ads[2][4] = { { 12000, 8000, 11000, 9000 }, { 4500, 4300, 10000, 7000 } };
+    for (int i = 0; i < 4; i++) {
+        ads48.ain[i].set(ads[0][i]);
+        ads49.ain[i].set(ads[1][i]);
+        alpha_one.ch[i].set(1000 + 100 * i);
+        alpha_two.ch[i].set(2000 + 100 * i);
+    }
+    sht25.temperature.set(22.5);
+    sht25.humidity.set(41);
+    s300.co2.set(415);
+}
+
+SimBoard::~SimBoard()
+{
+    sim_i2c.detach_all();
+    sim_pms = NULL;
+    sim_sd = NULL;
+    sim_rtc = NULL;
+}
+
+/*  Cold start: clock at 0, RTC set, blank FAT16 card in the slot  */
+void SimBoard::power_on(uint32_t unixtime)
+{
+    cpu_time = 0;
+    rtc.set(unixtime);
+    pms.reset();
+    sd.reset();
+    sd.format();
+    sim_i2c.transfers = sim_i2c.nacks = sim_i2c.bytes = sim_i2c.busy_us = 0;
+    sim_i2c.stuck_bits = 0;
+    sim_i2c.scl_pulses = 0;
+    cpu_time = 0;
+    rtc.set(unixtime);
+    Serial.sim_out.clear();
+}
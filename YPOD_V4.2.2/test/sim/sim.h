@@ -0,0 +1,311 @@
+/*******************************************************************************
+ * @file    sim.h
+ * @brief   Simulated YPOD board for host builds of the whole sketch: an I2C
+ *          bus with ADS1115, SHT25, S300, DS3231 and MCP342x models, a
+ *          scripted PMS5003 behind SoftwareSerial and an SPI-mode SD card
+ *          that the real SdFat formats and writes in memory.
+ *
+ *          Bus traffic costs virtual time (I2C bits at the Wire clock, SPI
+ *          bytes, clock stretching, SD busy periods), so cycle and blocking
+ *          times come out the same on every run.
+ *
+ * @author  Percy Smith, percy.smith@colorado.edu
+ * @date    October 17, 2026
+ * @log     Board model & scripted traces for the sim tests
+******************************************************************************/
+#ifndef _SIM_H
+#define _SIM_H
+
+#include <deque>
+#include <map>
+#include <vector>
+#include "Arduino.h"
+
+#define SIM_SPI_BYTE_NS       1500      // SdFat on a 16 MHz AVR (8 MHz SCK + loop)
+#define SIM_I2C_OVERHEAD_US   20        // start, stop & driver per transaction
+
+void sim_advance_ns(unsigned long ns);
+
+// Power-down (avr/sleep.h): time asleep and number of wakes
+extern unsigned long sim_slept_us;
+extern unsigned long sim_sleeps;
+
+/*! Sensor signal over time: (ms, value) points joined by straight lines and
+ *  held flat past either end */
+class SimTrace
+{
+public:
+    SimTrace(double value = 0);
+    void set(double value);
+    void add(unsigned long ms, double value);
+    double at(unsigned long ms) const;
+    double now() const { return at(millis()); }
+
+private:
+    std::vector<std::pair<unsigned long, double> > points;
+};
+
+/*! One I2C target; write() gets the bytes of a write transfer, read() fills
+ *  a read transfer. Returning false / 0 is a NACK on the address */
+class SimI2CDevice
+{
+public:
+    SimI2CDevice(uint8_t address) : address(address) {}
+    virtual ~SimI2CDevice() {}
+    virtual bool write(const uint8_t *buf, uint8_t len) = 0;
+    virtual uint8_t read(uint8_t *buf, uint8_t len) = 0;
+    virtual void general_call(uint8_t cmd) { (void)cmd; }
+
+    const uint8_t address;
+};
+
+/*! The bus: routes TwoWire transfers and charges their time */
+class SimI2C
+{
+public:
+    SimI2C();
+    void attach(SimI2CDevice *device);
+    void detach_all();
+    void set_clock(uint32_t hz);
+    bool write(uint8_t address, const uint8_t *buf, uint8_t len);
+    uint8_t read(uint8_t address, uint8_t *buf, uint8_t len);
+    void scl_pulse();
+
+    uint32_t clock;
+    unsigned stuck_bits;        // a slave holds SDA low for this many more SCL clocks
+    unsigned long scl_pulses;   // clocked by hand (bus clear)
+    unsigned long transfers;
+    unsigned long nacks;
+    unsigned long bytes;
+    unsigned long busy_us;      // time the master spent on the bus
+
+private:
+    SimI2CDevice *find(uint8_t address);
+    void charge(uint8_t len);
+    std::vector<SimI2CDevice *> devices;
+};
+
+extern SimI2C sim_i2c;
+
+/*! ADS1115: single-shot conversions take 1/DR; AIN0..3 read from traces in
+ *  counts at the configured gain */
+class SimADS1115 : public SimI2CDevice
+{
+public:
+    SimADS1115(uint8_t address) : SimI2CDevice(address) { reset(); }
+    void reset();
+    bool write(const uint8_t *buf, uint8_t len) override;
+    uint8_t read(uint8_t *buf, uint8_t len) override;
+
+    SimTrace ain[4];
+    unsigned long conversions;
+
+private:
+    uint8_t pointer;
+    uint16_t reg[4];
+    unsigned long done_at;
+    uint16_t pending;
+};
+
+/*! SHT25: hold-master T/RH measurements stretch the clock for their
+ *  conversion time; no-hold ones NACK the read until done */
+class SimSHT2x : public SimI2CDevice
+{
+public:
+    SimSHT2x() : SimI2CDevice(0x40) { reset(); }
+    void reset();
+    bool write(const uint8_t *buf, uint8_t len) override;
+    uint8_t read(uint8_t *buf, uint8_t len) override;
+
+    SimTrace temperature;       // C
+    SimTrace humidity;          // %RH
+    unsigned long measurements;
+    unsigned long corrupt;      // results still to send with a bad CRC
+
+private:
+    uint8_t command;
+    unsigned long done_at;
+    uint16_t result;
+    uint8_t user_reg;
+};
+
+/*! ELT S300 CO2: 'R' (0x52) then a 7 byte read, status in byte 0 & ppm in
+ *  bytes 1-2 */
+class SimS300 : public SimI2CDevice
+{
+public:
+    SimS300() : SimI2CDevice(0x31) { reset(); }
+    void reset();
+    bool write(const uint8_t *buf, uint8_t len) override;
+    uint8_t read(uint8_t *buf, uint8_t len) override;
+
+    SimTrace co2;               // ppm
+    unsigned long reads;
+    uint8_t status;             // 0x08 normal
+    unsigned long short_reads;  // replies still to cut to 2 bytes
+
+private:
+    uint8_t command;
+};
+
+/*! DS3231: time registers follow the virtual clock from a settable start;
+ *  SQW/INT is a 1 Hz square wave (falling as the seconds advance) when the
+ *  control register selects it. With INTCN set it is the active-low alarm
+ *  interrupt: alarm 1 (all its match modes) sets A1F, and A1IE routes it */
+class SimDS3231 : public SimI2CDevice
+{
+public:
+    SimDS3231(uint8_t sqw_pin) : SimI2CDevice(0x68), sqw_pin(sqw_pin) { reset(); }
+    void reset();
+    void set(uint32_t unixtime);
+    uint32_t unixtime() const;
+    int sqw();
+    unsigned long next_change() const;
+    bool write(const uint8_t *buf, uint8_t len) override;
+    uint8_t read(uint8_t *buf, uint8_t len) override;
+
+    const uint8_t sqw_pin;
+    unsigned long reads;
+
+    unsigned long alarms;       // A1F set
+
+private:
+    uint8_t reg_value(uint8_t reg) const;
+    void check_alarm();
+    bool alarm1_at(uint32_t t) const;
+    uint8_t pointer;
+    uint8_t reg[0x13];
+    uint32_t alarm_seen;        // last second checked against alarm 1
+    uint32_t base;              // unixtime at cpu_time == base_us
+    unsigned long base_us;
+};
+
+/*! MCP3424: one-shot or continuous conversions, general call reset/latch/
+ *  conversion, RDY bit in the trailing config byte */
+class SimMCP342x : public SimI2CDevice
+{
+public:
+    SimMCP342x(uint8_t address) : SimI2CDevice(address) { reset(); }
+    void reset();
+    bool write(const uint8_t *buf, uint8_t len) override;
+    uint8_t read(uint8_t *buf, uint8_t len) override;
+    void general_call(uint8_t cmd) override;
+
+    SimTrace ch[4];             // counts at the configured resolution
+    unsigned long conversions;
+    unsigned long reads;
+    int nack_channel;           // NACK the next config write for this channel (-1 none)
+
+private:
+    void start();
+    uint8_t config;
+    unsigned long done_at;
+    long result;
+    bool fresh;
+};
+
+/*! PMS5003 on the SoftwareSerial RX pin: active mode sends a frame every
+ *  interval, passive mode answers each read request after `latency_ms`;
+ *  asleep it does neither */
+class SimPMS5003
+{
+public:
+    SimPMS5003() { reset(); }
+    void reset();
+    void command(uint8_t c);
+    int available();
+    int read();
+    int peek();
+    bool overflowed();
+
+    SimTrace pm1, pm25, pm10;   // ug/m3, atmospheric
+    unsigned long latency_ms;
+    unsigned long interval_ms;  // active mode
+    unsigned long frames;
+    bool asleep;                // sleep command: fan off, nothing sent
+    unsigned long woke_at;      // cpu_time of the last wake-up command
+    unsigned long asleep_us;    // total, up to the last wake-up
+    unsigned long rx_bytes;     // bytes the RX interrupt took in
+    unsigned long dropped;      // lost to a full 64-byte buffer
+
+private:
+    void send_frame(unsigned long at);
+    void receive();
+    std::deque<std::pair<unsigned long, uint8_t> > wire;  // (arrival us, byte)
+    std::deque<uint8_t> rx;
+    uint8_t cmd[7];
+    uint8_t cmd_len;
+    bool passive;
+    unsigned long slept_at;
+    unsigned long next_active;
+    bool overflow;
+};
+
+extern SimPMS5003 *sim_pms;
+
+/*! SDHC card in SPI mode over a sparse in-memory image (erased = 0x00) */
+class SimSDCard
+{
+public:
+    SimSDCard(uint8_t cs, uint32_t sectors);
+    void reset();
+    void select(bool selected);
+    uint8_t transfer(uint8_t in);
+    bool format();
+
+    const uint8_t cs;
+    const uint32_t sector_count;
+    unsigned long sectors_written;
+    unsigned long sectors_read;
+    unsigned long erases;
+    unsigned long write_busy_us;    // programming time after each sector
+    unsigned long erase_busy_us;    // per MB erased
+
+    const uint8_t *sector(uint32_t n) const;   // NULL if erased
+
+private:
+    void command();
+    void respond(uint8_t r1);
+    void queue_data(const uint8_t *data, uint16_t len);
+    void queue_sector(uint32_t n);
+    void data_byte(uint8_t in);
+    void busy(unsigned long us);
+
+    std::map<uint32_t, std::vector<uint8_t> > image;
+    std::deque<uint8_t> out;
+    uint8_t cmd_buf[6];
+    uint8_t cmd_len;
+    bool app_cmd;
+    bool idle;
+    bool selected;
+    enum { CARD_CMD, CARD_WRITE_TOKEN, CARD_WRITE_DATA, CARD_READ_MULTI } state;
+    bool write_multi;
+    uint32_t address;
+    uint32_t erase_start;
+    uint32_t erase_end;
+    std::vector<uint8_t> block;
+    unsigned long busy_until;
+};
+
+extern SimSDCard *sim_sd;
+extern SimDS3231 *sim_rtc;
+
+/*! Every part of the board, wired to the fakes */
+struct SimBoard
+{
+    SimBoard();
+    ~SimBoard();
+    void power_on(uint32_t unixtime);
+
+    SimADS1115 ads48;
+    SimADS1115 ads49;
+    SimSHT2x sht25;
+    SimS300 s300;
+    SimDS3231 rtc;
+    SimMCP342x alpha_one;
+    SimMCP342x alpha_two;
+    SimPMS5003 pms;
+    SimSDCard sd;
+};
+
+#endif  //_SIM_H
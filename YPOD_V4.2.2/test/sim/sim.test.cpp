@@ -0,0 +1,532 @@
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <time.h>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include "sim.h"
+#include "scheduler.h"
+#include "sd_logger.h"
+#include "soft_clock.h"
+#include "sht_module.h"
+#if LOG_BINARY
+#include "binlog_decode.h"
+#endif
+
+/*  The sketch (sketch.cpp)  */
+void setup();
+void loop();
+extern Scheduler scheduler;
+extern SD_Logger logger;
+extern char fileName[];
+extern SoftClock rtc_clock;
+extern uint8_t prof_line;               // 0xFF once a profile report is out
+
+const uint32_t BOOT_TIME = 1791849600UL;    // 2026-10-13T00:00:00
+const unsigned long LOOP_US = 50;
+#if LOG_BINARY
+const char LOG_EXT[] = ".BIN";
+#else
+const char LOG_EXT[] = ".CSV";
+#endif           // loop() overhead with nothing due
+
+SimBoard *board;    // built in main(), after the bus globals
+
+/*  Cost of one record, from the end of the previous one  */
+struct RecordStats {
+    std::string line;
+    unsigned long at_ms;
+    unsigned long loops;
+    unsigned long busy_us;          // inside loop()
+    unsigned long max_loop_us;      // longest single loop() pass
+    unsigned long i2c_us;
+    unsigned long sd_sectors;
+    unsigned long sd_bytes;         // logged to the file (CSV or binary)
+    unsigned long pms_rx_bytes;
+};
+
+std::vector<RecordStats> records;
+std::vector<std::string> diagnostics;   // '#' lines (profiler reports)
+size_t serial_seen;                     // Serial.sim_out read up to here
+
+// Runs loop() until it prints the next record line (or `limit_ms` passes)
+bool next_record(unsigned long limit_ms = 5000)
+{
+    RecordStats r = RecordStats();
+    unsigned long i2c = sim_i2c.busy_us;
+    unsigned long sectors = board->sd.sectors_written;
+    unsigned long logged = logger.size();
+    unsigned long rx = board->pms.rx_bytes;
+    size_t out = serial_seen;           // '#' lines after the last record too
+    unsigned long deadline = millis() + limit_ms;
+
+    for (;;) {
+        size_t end = Serial.sim_out.find('\n', out);
+        if (end != std::string::npos) {
+            std::string line = Serial.sim_out.substr(out, end + 1 - out);
+            out = end + 1;
+            serial_seen = out;
+            if (line[0] != '#') {
+                r.line = line;
+                break;
+            }
+            diagnostics.push_back(line);
+            continue;
+        }
+        if (millis() > deadline)
+            return false;
+        unsigned long start = cpu_time;
+        loop();
+        unsigned long spent = cpu_time - start;
+        r.busy_us += spent;
+        if (spent > r.max_loop_us)
+            r.max_loop_us = spent;
+        r.loops++;
+        sim_advance(LOOP_US);
+    }
+
+    r.at_ms = millis();
+    r.i2c_us = sim_i2c.busy_us - i2c;
+    r.sd_sectors = board->sd.sectors_written - sectors;
+    r.sd_bytes = logger.size() - logged;
+    r.pms_rx_bytes = board->pms.rx_bytes - rx;
+    records.push_back(r);
+    return true;
+}
+
+std::vector<std::string> split(const std::string &line)
+{
+    std::vector<std::string> fields;
+    size_t start = 0, comma;
+    std::string body = line.substr(0, line.find('\n'));
+    while ((comma = body.find(',', start)) != std::string::npos) {
+        fields.push_back(body.substr(start, comma - start));
+        start = comma + 1;
+    }
+    fields.push_back(body.substr(start));
+    return fields;
+}
+
+TEST(Sim, BootsAndLogs)
+{
+    board->power_on(BOOT_TIME);
+    board->ads48.ain[1].add(0, 8000);
+    board->ads48.ain[1].add(20000, 14000);  // Fig 1 ramps over the first 20 s
+    setup();
+
+    EXPECT_EQ("YPODE8_2026_10_13" + std::string(LOG_EXT), fileName);
+    EXPECT_TRUE(logger.is_open());
+    for (int i = 0; i < 60; i++)
+        ASSERT_TRUE(next_record()) << "record " << i;
+}
+
+TEST(Sim, RecordsCarryTheSimulatedSensors)
+{
+    ASSERT_FALSE(records.empty());
+    const RecordStats &r = records.back();
+    std::vector<std::string> f = split(r.line);
+
+    EXPECT_EQ(0u, r.line.compare(0, 11, "2026-10-13T"));
+    EXPECT_EQ("YPODE8", f[3]);
+    EXPECT_EQ("YPOD_V4.2.2", f[4]);
+    EXPECT_EQ("9000", f[11]);       // Fig 2 (ads48 AIN3)
+    EXPECT_EQ("7000", f[12]);       // e2V (ads49 AIN3)
+    EXPECT_EQ("4500", f[14]);       // CO ch1
+    EXPECT_EQ("4300", f[15]);       // CO ch2
+    EXPECT_EQ("5", f[17]);          // PM1 env
+    EXPECT_EQ("8", f[18]);          // PM2.5 env
+    EXPECT_EQ("12", f[19]);         // PM10 env
+    EXPECT_EQ("1000", f[20]);       // alpha one ch1
+    EXPECT_EQ("2300", f[27]);       // alpha two ch4
+    EXPECT_EQ(0, board->pms.dropped);
+    EXPECT_EQ(0, sim_i2c.nacks);
+
+    // Fig 1 follows its ramp
+    long first = atol(split(records.front().line)[10].c_str());
+    long last = atol(f[10].c_str());
+    EXPECT_LT(first, 9000);
+    EXPECT_GT(last, 12000);
+}
+
+TEST(Sim, CostPerRecord)
+{
+    ASSERT_GT(records.size(), 10u);
+    unsigned long busy = 0, max_loop = 0, i2c = 0, sectors = 0, bytes = 0, logged = 0, rx = 0;
+    // skip the first record: it includes the first PMS request from setup()
+    for (size_t i = 1; i < records.size(); i++) {
+        busy += records[i].busy_us;
+        i2c += records[i].i2c_us;
+        sectors += records[i].sd_sectors;
+        bytes += records[i].line.size();
+        logged += records[i].sd_bytes;
+        rx += records[i].pms_rx_bytes;
+        if (records[i].max_loop_us > max_loop)
+            max_loop = records[i].max_loop_us;
+    }
+    size_t n = records.size() - 1;
+    unsigned long span = records.back().at_ms - records.front().at_ms;
+
+    printf("  cycle %lu ms, %lu B/record (serial), %lu B/record logged, SD %lu B/record\n",
+           span / n, bytes / n, logged / n, sectors * 512 / n);
+    printf("  CPU %lu us/record (I2C %lu us), longest loop() %lu us, PMS ISR %lu B/record\n",
+           busy / n, i2c / n, max_loop, rx / n);
+
+    EXPECT_NEAR(span / n, scheduler.cycle_time(), 5);
+    EXPECT_GE(sectors * 512, logged - LOG_SECTOR_SIZE);   // all but the sector in SdFat's cache
+    EXPECT_LT(busy / n, span / n * 1000);
+}
+
+TEST(Sim, ClockCountsTheSqw)
+{
+    ASSERT_TRUE(rtc_clock.has_sqw());
+    // one read at boot, then one per RTC_RESYNC_MS instead of one per record
+    EXPECT_LE(board->rtc.reads, 2 + millis() / RTC_RESYNC_MS);
+    EXPECT_EQ(0, rtc_clock.slip_count());
+
+    for (int i = 0; i < 10; i++) {
+        ASSERT_TRUE(next_record());
+        EXPECT_EQ(0, records.back().line.compare(0, 19, rtc_clock.text()));
+        rtc_clock.poll();           // an edge since the last loop() tick
+        rtc_clock.update();
+        EXPECT_EQ(board->rtc.unixtime(), rtc_clock.unixtime());
+    }
+}
+
+TEST(Sim, ProfilerReportsEachStage)
+{
+    while (diagnostics.empty() && millis() < PROFILE_PERIOD_MS + 5000)
+        ASSERT_TRUE(next_record());
+    ASSERT_FALSE(diagnostics.empty());
+    // a line per loop() pass, each once Serial is idle: records go on in between
+    while (prof_line != 0xFF)
+        ASSERT_TRUE(next_record());
+    ASSERT_TRUE(next_record());
+
+    unsigned long sht25_max = 0, serial_p50 = 0;
+    std::set<std::string> i2c_devices;
+    for (size_t i = 0; i < diagnostics.size(); i++) {
+        std::vector<std::string> f = split(diagnostics[i]);
+        ASSERT_EQ(8u, f.size()) << diagnostics[i];
+        if (f[0] == "#I2C") {
+            // every device is counted, the library-driven ones (DS3231,
+            // MCP342x & their general call) included; none of it NACKed
+            // or got stuck
+            printf("  I2C %s n=%-6s total=%-7s max=%s us\n",
+                   f[2].c_str(), f[3].c_str(), f[4].c_str(), f[7].c_str());
+            EXPECT_TRUE(i2c_devices.insert(f[2]).second) << diagnostics[i];
+            EXPECT_EQ("0", f[5]) << diagnostics[i];
+            EXPECT_EQ("0", f[6]) << diagnostics[i];
+            continue;
+        }
+        EXPECT_EQ("#PROF", f[0]);
+        printf("  %-10s n=%-6s p50=%-7s p95=%-7s max=%s us\n",
+               f[2].c_str(), f[3].c_str(), f[5].c_str(), f[6].c_str(), f[7].c_str());
+        if (f[2] == "SHT25")
+            sht25_max = atol(f[7].c_str());
+        if (f[2] == "SERIAL")
+            serial_p50 = atol(f[5].c_str());
+    }
+    // no-hold T & RH: the task sends commands & reads results, never
+    // holds the bus for the 85 + 29 ms of conversions
+    EXPECT_LT(sht25_max, 2000u);
+    // the echo only fills the 64 byte TX buffer; 9600 baud drains it
+    // between loop() passes, nothing waits on the UART
+    EXPECT_LT(serial_p50, 2000u);
+    const std::set<std::string> fitted = {
+        "0x00", "0x31", "0x40", "0x48", "0x49", "0x68", "0x69", "0x6E"
+    };
+    EXPECT_EQ(fitted, i2c_devices);
+}
+
+// The roll runs in bounded steps over the passes after the first record of
+// the day: close the old file, open & preallocate the new one, then erase
+// its extent one LOG_ERASE_SECTORS chunk per pass. With a slow card erase
+// (40 ms per MB here) no pass holds loop() for more than one chunk of it
+TEST(Sim, MidnightStartsANewFile)
+{
+    const unsigned long CARD_ERASE_US = board->sd.erase_busy_us;
+    const unsigned long ERASE_US = 40000;
+    board->sd.erase_busy_us = ERASE_US;
+    unsigned long erases = board->sd.erases;
+
+    // the sketch sees the jump at its next resync, up to RTC_RESYNC_MS
+    // on: it lands before midnight, which the clock then counts through
+    board->rtc.set(BOOT_TIME + 86400 - RTC_RESYNC_MS / 1000 - 5);
+    do {
+        ASSERT_TRUE(next_record());
+    } while (records.back().line.compare(0, 10, "2026-10-14") != 0);
+    for (int i = 0; i < 10; i++)
+        ASSERT_TRUE(next_record());
+    board->sd.erase_busy_us = CARD_ERASE_US;
+
+    EXPECT_EQ("YPODE8_2026_10_14" + std::string(LOG_EXT), fileName);
+    EXPECT_TRUE(logger.is_open());
+    EXPECT_TRUE(logger.is_contiguous());
+    EXPECT_FALSE(logger.busy());
+    unsigned long chunks = (LOG_DAY_BYTES / LOG_SECTOR_SIZE + LOG_ERASE_SECTORS - 1) / LOG_ERASE_SECTORS;
+    EXPECT_GE(board->sd.erases - erases, chunks);
+    EXPECT_EQ(0, logger.error_count());
+    EXPECT_EQ(0, logger.dropped_count());
+    EXPECT_EQ(1, rtc_clock.slip_count());     // the jump, caught by a resync
+
+    // no pause: the record cycle around midnight stays on schedule
+    unsigned long longest = 0, roll_us = 0, day_us = 0;
+    for (size_t i = records.size() - 15; i < records.size(); i++) {
+        unsigned long gap = records[i].at_ms - records[i - 1].at_ms;
+        if (gap > longest)
+            longest = gap;
+        roll_us = std::max(roll_us, records[i].max_loop_us);
+    }
+    for (size_t i = 1; i < records.size() - 15; i++)
+        day_us = std::max(day_us, records[i].max_loop_us);
+    printf("  longest loop() pass: %lu us across midnight, %lu us before\n", roll_us, day_us);
+    EXPECT_LT(longest, 2 * scheduler.cycle_time());
+    EXPECT_LT(roll_us, 150000u);            // the FAT chain walks of truncate & preallocate
+    EXPECT_LT(roll_us, day_us + LOG_DAY_BYTES / 1048576 * ERASE_US);    // not the whole extent's erase
+}
+
+// A result with a bad CRC blanks T & RH for that record only, and the
+// calibrated columns that take them: CO, CO2 and TVOC
+TEST(Sim, CorruptShtReadIsDropped)
+{
+    const uint8_t example[2] = { 0x68, 0x3A };    // Sensirion's CRC example
+    EXPECT_EQ(0x7C, SHT_Module::crc8(example, 2));
+
+    ASSERT_TRUE(next_record());
+    std::vector<std::string> before = split(records.back().line);
+    ASSERT_NE("", before[7]);
+
+    board->sht25.corrupt = 1;                   // the next cycle's T
+    ASSERT_TRUE(next_record());
+    std::vector<std::string> bad = split(records.back().line);
+    EXPECT_EQ(0, board->sht25.corrupt);
+    EXPECT_EQ("", bad[7]);
+    EXPECT_EQ("", bad[8]);
+    EXPECT_EQ("", bad[9]);                      // TVOC, T & RH compensated
+    EXPECT_EQ("", bad[13]);                     // CO, RH compensated
+    EXPECT_EQ("", bad[16]);                     // CO2, RH & T compensated
+    EXPECT_EQ(before[10], bad[10]);             // the raw channels are still logged
+    EXPECT_EQ(before.size(), bad.size());
+
+    ASSERT_TRUE(next_record());
+    std::vector<std::string> after = split(records.back().line);
+    EXPECT_EQ(before[7], after[7]);
+    EXPECT_EQ(before[8], after[8]);
+    EXPECT_NE("", after[13]);
+    EXPECT_NE("", after[16]);
+}
+
+// A short S300 reply is asked for again within the cycle; a sensor still
+// warming up leaves CO2 blank
+TEST(Sim, S300RepliesAreChecked)
+{
+    ASSERT_TRUE(next_record());
+    std::vector<std::string> before = split(records.back().line);
+    ASSERT_NE("", before[16]);
+
+    board->s300.short_reads = 1;
+    unsigned long reads = board->s300.reads;
+    ASSERT_TRUE(next_record());
+    std::vector<std::string> retried = split(records.back().line);
+    EXPECT_EQ(0, board->s300.short_reads);
+    EXPECT_EQ(reads + 2, board->s300.reads);
+    EXPECT_EQ(before[16], retried[16]);
+
+    // the echo reaches the host ~150 ms into the next cycle, after its
+    // S300 read: a status change shows one record later
+    board->s300.status = 0x00;
+    ASSERT_TRUE(next_record());
+    ASSERT_TRUE(next_record());
+    std::vector<std::string> warming = split(records.back().line);
+    EXPECT_EQ("", warming[16]);
+    EXPECT_EQ(before.size(), warming.size());
+    EXPECT_EQ(before[14], warming[14]);         // the rest is still logged
+
+    board->s300.status = 0x08;
+    ASSERT_TRUE(next_record());
+    ASSERT_TRUE(next_record());
+    EXPECT_EQ(before[16], split(records.back().line)[16]);
+}
+
+// The quadstat is polled only once a 16 bit conversion can be done; a
+// channel that does not start blanks all eight columns of that record
+TEST(Sim, QuadWaitsForItsConversions)
+{
+    ASSERT_TRUE(next_record());
+    std::vector<std::string> before = split(records.back().line);
+    ASSERT_EQ("1000", before[20]);
+
+    unsigned long reads = board->alpha_one.reads;
+    unsigned long conversions = board->alpha_one.conversions;
+    for (int i = 0; i < 5; i++)
+        ASSERT_TRUE(next_record());
+    reads = board->alpha_one.reads - reads;
+    conversions = board->alpha_one.conversions - conversions;
+    printf("  quadstat: %lu reads for %lu conversions\n", reads, conversions);
+    EXPECT_LT(reads, 2 * conversions);          // at most one early poll each
+
+    board->alpha_two.nack_channel = 2;          // mid-sequence
+    int blank = 0;
+    for (int i = 0; i < 3; i++) {
+        ASSERT_TRUE(next_record());
+        std::vector<std::string> f = split(records.back().line);
+        ASSERT_EQ(before.size(), f.size());
+        if (f[20] == "") {
+            blank++;
+            for (int c = 20; c <= 27; c++)
+                EXPECT_EQ("", f[c]) << c;
+            EXPECT_EQ(before[16], f[16]);       // the other sensors still log
+        } else {
+            EXPECT_EQ(before[20], f[20]);
+            EXPECT_EQ(before[27], f[27]);
+        }
+    }
+    EXPECT_EQ(-1, board->alpha_two.nack_channel);
+    EXPECT_EQ(1, blank);
+}
+
+// A slave holding SDA low (reset mid-byte) makes the next transfer time
+// out; the bus is clocked free and the following records read normally
+TEST(Sim, StuckBusIsCleared)
+{
+    EXPECT_EQ((uint32_t)I2C_CLOCK_HZ, sim_i2c.clock);
+    ASSERT_TRUE(next_record());
+    std::vector<std::string> before = split(records.back().line);
+
+    unsigned long pulses = sim_i2c.scl_pulses;
+    sim_i2c.stuck_bits = 3;
+    ASSERT_TRUE(next_record());
+    EXPECT_EQ(0u, sim_i2c.stuck_bits);
+    EXPECT_EQ(pulses + 3, sim_i2c.scl_pulses);   // stopped once SDA let go
+    EXPECT_EQ((uint32_t)I2C_CLOCK_HZ, sim_i2c.clock);
+
+    ASSERT_TRUE(next_record());
+    ASSERT_TRUE(next_record());
+    std::vector<std::string> after = split(records.back().line);
+    EXPECT_EQ(before.size(), after.size());
+    EXPECT_EQ(before[7], after[7]);             // T
+    EXPECT_EQ(before[16], after[16]);           // CO2
+    EXPECT_LT(records.back().at_ms - records[records.size() - 2].at_ms, 2000u);
+}
+
+// Each day's file holds exactly that day's records (runs last: ends the log)
+TEST(Sim, SDFilesMatchSerialEcho)
+{
+    // what each text-mode file starts with: one name per field
+    const std::string header = "Timestamp(UTC),EAST_LONGITUDE(deg),NORTH_LATITUDE(deg),ID(-),firmware(-),"
+        "T_BMP(C),P_BMP(hPa),T(C),RH(%),TVOC(ppm),Fig1(raw),Fig2(raw),e2V(raw),CO(ppm),CO_ch1(raw),"
+        "CO_ch2(raw),CO2(ppm),PM1(ug/m3),PM2.5(ug/m3),PM10(ug/m3),a1C1(raw),a1C2(raw),a2C1(raw),"
+        "a2C2(raw),a3C1(raw),a3C2(raw),a4C1(raw),a4C2(raw),\n";
+    EXPECT_EQ(split(records[0].line).size(), split(header).size());
+
+    std::map<std::string, std::string> days;    // "2026_10_13" -> its lines
+    for (size_t i = 0; i < records.size(); i++) {
+        std::string day = records[i].line.substr(0, 10);
+        day[4] = day[7] = '_';
+        days[day] += records[i].line;
+    }
+    ASSERT_EQ(2u, days.size());
+
+    logger.end();
+    SdFat32 fs;
+    ASSERT_TRUE(fs.begin(SdSpiConfig(SD_CS, SHARED_SPI)));
+
+    for (std::map<std::string, std::string>::iterator d = days.begin(); d != days.end(); ++d) {
+        const std::string &serial = d->second;
+        std::string name = "YPODE8_" + d->first + LOG_EXT;
+        File32 file = fs.open(name.c_str(), O_RDONLY);
+        ASSERT_TRUE(file) << name;
+
+        std::string logged(file.fileSize(), '\0');
+        ASSERT_EQ((int)logged.size(), file.read(&logged[0], logged.size()));
+#if LOG_BINARY
+        // decoded as ypod_bin2csv does it: the text-mode file, header row
+        // included, byte for byte
+        BinlogReader reader;
+        ASSERT_TRUE(reader.open((const uint8_t *)logged.data(), logged.size())) << reader.error();
+        std::string decoded, line;
+        reader.header_csv(decoded);
+        for (size_t i = 0; i < reader.count(); i++) {
+            EXPECT_TRUE(reader.is_record(i));
+            reader.record_csv(i, line);
+            decoded += line;
+        }
+        EXPECT_EQ(header + serial, decoded) << name;
+        printf("  %s: %zu B binary for %zu B of CSV\n", name.c_str(), logged.size(), decoded.size());
+#else
+        EXPECT_EQ(header + serial, logged) << name;
+#endif
+    }
+}
+
+long unixtime(const std::string &text)
+{
+    struct tm t = tm();
+    sscanf(text.c_str(), "%d-%d-%dT%d:%d:%d", &t.tm_year, &t.tm_mon, &t.tm_mday,
+           &t.tm_hour, &t.tm_min, &t.tm_sec);
+    t.tm_year -= 1900;
+    t.tm_mon -= 1;
+    return timegm(&t);
+}
+
+// Every finished 1-min, 15-min & hourly window has its row, matching the
+// records logged in it (runs after the log is ended)
+TEST(Sim, SummaryFilesMatchTheRecords)
+{
+    const char *tiers[] = { "1M", "15M", "1H" };
+    const long periods[] = { 60, 900, 3600 };
+    const size_t FIG1 = 4 + 4 * 3;          // window, ypod, firmware, records; T, RH, TVOC
+    SdFat32 fs;
+    ASSERT_TRUE(fs.begin(SdSpiConfig(SD_CS, SHARED_SPI)));
+
+    for (int t = 0; t < 3; t++) {
+        std::string name = std::string("YPODE8_2026_10_13_") + tiers[t] + ".CSV";
+        File32 file = fs.open(name.c_str(), O_RDONLY);
+        ASSERT_TRUE(file) << name;
+        std::string text(file.fileSize(), '\0');
+        ASSERT_EQ((int)text.size(), file.read(&text[0], text.size()));
+
+        size_t start = text.find('\n') + 1, rows = 0;
+        EXPECT_EQ(0u, text.compare(0, 37, "window_start,ypod,firmware,records,T_"));
+        std::vector<std::string> head = split(text.substr(0, start));
+        ASSERT_EQ(4 + 4 * 21u, head.size());
+        EXPECT_EQ("Fig1_mean", head[FIG1]);
+        for (size_t end; (end = text.find('\n', start)) != std::string::npos; start = end + 1, rows++) {
+            std::vector<std::string> f = split(text.substr(start, end + 1 - start));
+            ASSERT_EQ(head.size(), f.size());
+            long window = unixtime(f[0]);
+            EXPECT_EQ(0, window % periods[t]) << f[0];
+
+            // the records the pod logged in that window
+            long n = 0, lo = 99999, hi = 0;
+            double sum = 0;
+            for (size_t i = 0; i < records.size(); i++) {
+                long at = unixtime(records[i].line.substr(0, 19));
+                if (at < window || at >= window + periods[t])
+                    continue;
+                long fig1 = atol(split(records[i].line)[10].c_str());
+                n++;
+                sum += fig1;
+                lo = fig1 < lo ? fig1 : lo;
+                hi = fig1 > hi ? fig1 : hi;
+            }
+            ASSERT_GT(n, 0) << name << " " << f[0];
+            EXPECT_EQ(n, atol(f[3].c_str())) << name << " " << f[0];
+            EXPECT_NEAR(sum / n, atof(f[FIG1].c_str()), 0.02) << name << " " << f[0];
+            EXPECT_EQ(lo, atof(f[FIG1 + 1].c_str()));
+            EXPECT_EQ(hi, atof(f[FIG1 + 2].c_str()));
+            EXPECT_EQ(n, atol(f[FIG1 + 3].c_str()));
+        }
+        // closed by the jump to just before midnight and by midnight
+        printf("  %s: %zu rows\n", name.c_str(), rows);
+        EXPECT_GE(rows, 2u) << name;
+    }
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    SimBoard sim;
+    board = &sim;
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,455 @@
+/*******************************************************************************
+ * @file    sim_core.cpp
+ * @brief   Fake Arduino core for the whole-sketch simulation: virtual clock,
+ *          pins, Print/Stream, HardwareSerial, TwoWire, SPI & SoftwareSerial
+ *          front ends for the board models in sim.cpp
+ *
+ * @cite    Arduino AVR core >> Print.cpp (number formatting)
+ *
+ * @author  Percy Smith, percy.smith@colorado.edu
+ * @date    October 17, 2026
+ * @log     Virtual clock, pins & serial front ends
+******************************************************************************/
+#include "Arduino.h"
+#include "Wire.h"
+#include "SPI.h"
+#include "SoftwareSerial.h"
+#include "sim.h"
+
+unsigned long cpu_time;
+static unsigned long ns_carry;
+static uint8_t pins[NUM_PINS];
+
+HardwareSerial Serial;
+TwoWire Wire;
+SPIClass SPI;
+
+/*  Clock  */
+unsigned long millis()
+{
+    return cpu_time / 1000;
+}
+
+unsigned long micros()
+{
+    return cpu_time;
+}
+
+void delay(unsigned long ms)
+{
+    cpu_time += (ms * 1000);
+}
+
+void delayMicroseconds(unsigned long us)
+{
+    cpu_time += us;
+}
+
+void sim_advance(unsigned long us)
+{
+    cpu_time += us;
+}
+
+void sim_advance_ns(unsigned long ns)
+{
+    ns_carry += ns;
+    cpu_time += ns_carry / 1000;
+    ns_carry %= 1000;
+}
+
+void yield()
+{
+}
+
+/*  Pins - the SD card watches its chip select, the DS3231 drives SQW  */
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    if (pin == SCL && mode == INPUT_PULLUP && pins[pin] == LOW)
+        sim_i2c.scl_pulse();    // released: the pull-up raises SCL
+    if (pin < NUM_PINS && mode == INPUT_PULLUP)
+        pins[pin] = HIGH;
+}
+
+void digitalWrite(uint8_t pin, uint8_t val)
+{
+    if (pin >= NUM_PINS)
+        return;
+    if (pin == SCL && val == HIGH && pins[pin] == LOW)
+        sim_i2c.scl_pulse();
+    pins[pin] = val;
+    if (sim_sd && pin == sim_sd->cs)
+        sim_sd->select(val == LOW);
+}
+
+int digitalRead(uint8_t pin)
+{
+    if (sim_rtc && pin == sim_rtc->sqw_pin)
+        return sim_rtc->sqw();
+    if (pin == SDA && sim_i2c.stuck_bits)
+        return LOW;
+    return pin < NUM_PINS ? pins[pin] : LOW;
+}
+
+/*  Registers & power-down - the DS3231 SQW/INT pin is the only wake source
+ *  modelled. millis() keeps counting while asleep (the AVR's Timer0 stops)  */
+uint8_t ADCSRA = _BV(ADEN);     // init() turns the ADC on
+uint8_t PCICR, PCMSK0, PCMSK1, PCMSK2;
+unsigned long sim_slept_us;
+unsigned long sim_sleeps;
+
+void sim_sleep_cpu()
+{
+    uint8_t p = sim_rtc ? sim_rtc->sqw_pin : 0;
+    if (!sim_rtc || !(PCICR & _BV(digitalPinToPCICRbit(p)))
+        || !(*digitalPinToPCMSK(p) & _BV(digitalPinToPCMSKbit(p)))) {
+        fprintf(stderr, "sim: power-down with no wake source\n");
+        abort();
+    }
+
+    unsigned long start = cpu_time;
+    int level = sim_rtc->sqw();
+    while (sim_rtc->sqw() == level) {
+        if (cpu_time - start > 40 * 86400000000UL) {
+            fprintf(stderr, "sim: asleep for 40 days\n");
+            abort();
+        }
+        cpu_time = sim_rtc->next_change();
+    }
+    sim_slept_us += cpu_time - start;
+    sim_sleeps++;
+}
+
+/*  String  */
+String::String(const char *str)
+{
+    buf = strdup(str ? str : "");
+}
+
+String::String(const String &other)
+{
+    buf = strdup(other.buf);
+}
+
+String::~String()
+{
+    free(buf);
+}
+
+String &String::operator=(const String &other)
+{
+    if (this != &other) {
+        free(buf);
+        buf = strdup(other.buf);
+    }
+    return *this;
+}
+
+/*  Print  */
+size_t Print::write(const uint8_t *buf, size_t len)
+{
+    size_t n = 0;
+    while (len--)
+        n += write(*buf++);
+    return n;
+}
+
+size_t Print::print(const __FlashStringHelper *str) { return write((const char *)str); }
+size_t Print::print(const String &str) { return write(str.c_str()); }
+size_t Print::print(const char str[]) { return write(str); }
+size_t Print::print(char c) { return write((uint8_t)c); }
+size_t Print::print(unsigned char n, int base) { return print((unsigned long)n, base); }
+size_t Print::print(int n, int base) { return print((long)n, base); }
+size_t Print::print(unsigned int n, int base) { return print((unsigned long)n, base); }
+
+size_t Print::print(long n, int base)
+{
+    if (base == 0)
+        return write((uint8_t)n);
+    if (base == 10 && n < 0)
+        return print('-') + printNumber(-n, 10);
+    return printNumber(n, base);
+}
+
+size_t Print::print(unsigned long n, int base)
+{
+    if (base == 0)
+        return write((uint8_t)n);
+    return printNumber(n, base);
+}
+
+size_t Print::print(double n, int digits) { return printFloat(n, digits); }
+
+size_t Print::println(const __FlashStringHelper *str) { return print(str) + println(); }
+size_t Print::println(const String &str) { return print(str) + println(); }
+size_t Print::println(const char str[]) { return print(str) + println(); }
+size_t Print::println(char c) { return print(c) + println(); }
+size_t Print::println(unsigned char n, int base) { return print(n, base) + println(); }
+size_t Print::println(int n, int base) { return print(n, base) + println(); }
+size_t Print::println(unsigned int n, int base) { return print(n, base) + println(); }
+size_t Print::println(long n, int base) { return print(n, base) + println(); }
+size_t Print::println(unsigned long n, int base) { return print(n, base) + println(); }
+size_t Print::println(double n, int digits) { return print(n, digits) + println(); }
+size_t Print::println() { return write("\r\n"); }
+
+size_t Print::printNumber(unsigned long n, uint8_t base)
+{
+    char buf[8 * sizeof(long) + 1];
+    char *str = &buf[sizeof(buf) - 1];
+
+    *str = '\0';
+    if (base < 2)
+        base = 10;
+    do {
+        char c = n % base;
+        n /= base;
+        *--str = c < 10 ? c + '0' : c + 'A' - 10;
+    } while (n);
+
+    return write(str);
+}
+
+size_t Print::printFloat(double number, uint8_t digits)
+{
+    size_t n = 0;
+
+    if (isnan(number)) return print("nan");
+    if (isinf(number)) return print("inf");
+    if (number > 4294967040.0) return print("ovf");
+    if (number < -4294967040.0) return print("ovf");
+
+    if (number < 0.0) {
+        n += print('-');
+        number = -number;
+    }
+
+    double rounding = 0.5;
+    for (uint8_t i = 0; i < digits; ++i)
+        rounding /= 10.0;
+    number += rounding;
+
+    unsigned long int_part = (unsigned long)number;
+    double remainder = number - (double)int_part;
+    n += print(int_part);
+
+    if (digits > 0)
+        n += print('.');
+    while (digits-- > 0) {
+        remainder *= 10.0;
+        unsigned int toPrint = (unsigned int)remainder;
+        n += print(toPrint);
+        remainder -= toPrint;
+    }
+    return n;
+}
+
+size_t Stream::readBytes(char *buf, size_t len)
+{
+    size_t n = 0;
+    while (n < len && available() > 0)
+        buf[n++] = read();
+    return n;
+}
+
+/*  HardwareSerial - 10 bits per byte at the configured baud  */
+HardwareSerial::HardwareSerial()
+{
+    baud = 0;
+    tx_done = 0;
+}
+
+void HardwareSerial::begin(unsigned long baud)
+{
+    this->baud = baud;
+    tx_done = cpu_time;
+}
+
+void HardwareSerial::end()
+{
+    flush();
+    baud = 0;
+}
+
+int HardwareSerial::available() { return 0; }
+int HardwareSerial::read() { return -1; }
+int HardwareSerial::peek() { return -1; }
+
+int HardwareSerial::availableForWrite()
+{
+    if (!baud || tx_done <= cpu_time)
+        return SERIAL_TX_BUFFER_SIZE - 1;
+    unsigned long byte_us = 10000000UL / baud;
+    long queued = (tx_done - cpu_time + byte_us - 1) / byte_us;
+    return queued >= SERIAL_TX_BUFFER_SIZE - 1 ? 0 : SERIAL_TX_BUFFER_SIZE - 1 - queued;
+}
+
+void HardwareSerial::flush()
+{
+    if (baud && tx_done > cpu_time)
+        sim_advance(tx_done - cpu_time);
+}
+
+size_t HardwareSerial::write(uint8_t c)
+{
+    sim_out += (char)c;
+    if (!baud)
+        return 1;
+
+    unsigned long byte_us = 10000000UL / baud;
+    if (tx_done < cpu_time)
+        tx_done = cpu_time;
+    // blocks until the ISR has made room, like the AVR core
+    unsigned long full = SERIAL_TX_BUFFER_SIZE * byte_us;
+    if (tx_done - cpu_time > full)
+        sim_advance(tx_done - cpu_time - full);
+    tx_done += byte_us;
+    return 1;
+}
+
+/*  TwoWire  */
+TwoWire::TwoWire()
+{
+    tx_len = rx_len = rx_index = 0;
+    transmitting = false;
+    timeout_us = 0;
+    timeout_flag = false;
+}
+
+// the AVR twi_init() goes back to 100 kHz
+void TwoWire::begin()
+{
+    sim_i2c.set_clock(100000);
+}
+
+void TwoWire::end() {}
+
+void TwoWire::setWireTimeout(uint32_t timeout, bool reset_with_timeout)
+{
+    (void)reset_with_timeout;
+    timeout_us = timeout;
+    timeout_flag = false;
+}
+
+/*  A slave holding SDA: the transfer waits out the timeout, then gives up
+ *  (with no timeout set the real one would hang; charged once here)  */
+bool TwoWire::stuck()
+{
+    if (!sim_i2c.stuck_bits)
+        return false;
+    sim_i2c.transfers++;
+    sim_advance(timeout_us ? timeout_us : 1000000UL);
+    timeout_flag = true;
+    return true;
+}
+
+void TwoWire::setClock(uint32_t clock)
+{
+    sim_i2c.set_clock(clock);
+}
+
+void TwoWire::beginTransmission(uint8_t address)
+{
+    tx_address = address;
+    tx_len = 0;
+    transmitting = true;
+}
+
+uint8_t TwoWire::endTransmission(uint8_t stop)
+{
+    (void)stop;
+    if (stuck()) {
+        tx_len = 0;
+        transmitting = false;
+        return 5;
+    }
+    bool ack = sim_i2c.write(tx_address, tx_buf, tx_len);
+    tx_len = 0;
+    transmitting = false;
+    return ack ? 0 : 2;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t quantity, uint8_t stop)
+{
+    (void)stop;
+    if (quantity > BUFFER_LENGTH)
+        quantity = BUFFER_LENGTH;
+    rx_index = 0;
+    if (stuck())
+        return rx_len = 0;
+    rx_len = sim_i2c.read(address, rx_buf, quantity);
+    return rx_len;
+}
+
+size_t TwoWire::write(uint8_t c)
+{
+    if (!transmitting || tx_len >= BUFFER_LENGTH)
+        return 0;
+    tx_buf[tx_len++] = c;
+    return 1;
+}
+
+size_t TwoWire::write(const uint8_t *buf, size_t len)
+{
+    size_t n = 0;
+    while (n < len && write(buf[n]))
+        n++;
+    return n;
+}
+
+int TwoWire::available() { return rx_len - rx_index; }
+int TwoWire::read() { return rx_index < rx_len ? rx_buf[rx_index++] : -1; }
+int TwoWire::peek() { return rx_index < rx_len ? rx_buf[rx_index] : -1; }
+
+/*  SPI - the SD card answers while its chip select is low  */
+void SPIClass::beginTransaction(SPISettings settings)
+{
+    clock = settings.clock;
+}
+
+uint8_t SPIClass::transfer(uint8_t data)
+{
+    sim_advance_ns(SIM_SPI_BYTE_NS);
+    if (!sim_sd || digitalRead(sim_sd->cs) != LOW)
+        return 0xFF;
+    return sim_sd->transfer(data);
+}
+
+void SPIClass::transfer(void *buf, size_t count)
+{
+    uint8_t *p = (uint8_t *)buf;
+    for (size_t i = 0; i < count; i++)
+        p[i] = transfer(p[i]);
+}
+
+/*  SoftwareSerial - TX is bit-banged with interrupts off, ~1 ms per byte  */
+void SoftwareSerial::begin(long speed)
+{
+    (void)speed;
+}
+
+bool SoftwareSerial::overflow()
+{
+    return sim_pms ? sim_pms->overflowed() : false;
+}
+
+int SoftwareSerial::available()
+{
+    return sim_pms ? sim_pms->available() : 0;
+}
+
+int SoftwareSerial::read()
+{
+    return sim_pms ? sim_pms->read() : -1;
+}
+
+int SoftwareSerial::peek()
+{
+    return sim_pms ? sim_pms->peek() : -1;
+}
+
+size_t SoftwareSerial::write(uint8_t c)
+{
+    sim_advance(1042);
+    if (sim_pms)
+        sim_pms->command(c);
+    return 1;
+}
@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include "sim.h"
+#include "sd_logger.h"
+#include "ads_module.h"
+#include "binlog_decode.h"
+
+/*  The sketch (sketch.cpp), built with PMS_EXTENDED, every PM bin,
+ *  ADS_OVERSAMPLE and LOG_BINARY, one record per RECORD_PERIOD_MS  */
+void setup();
+void loop();
+extern SD_Logger logger;
+extern char fileName[];
+
+const uint32_t BOOT_TIME = 1791849600UL;    // 2026-10-13T00:00:00
+const unsigned long LOOP_US = 50;
+
+// CSV columns after the 8 quadstat ones: mean,std,n per ADS channel, then
+// mean,max per PM bin and the frame count
+const size_t ADS_STATS = 28;
+const size_t SUMMARY = ADS_STATS + 3 * ADS_USER_COUNT;
+const size_t FRAMES = SUMMARY + 2 * PMS_SUMMARY_BINS;
+enum { CF_PM25 = 1, ENV_PM1 = 3, ENV_PM25 = 4, COUNT_03UM = 6, COUNT_10UM = 8 };
+
+SimBoard *board;    // built in main(), after the bus globals
+
+struct ExtRecord {
+    std::string line;
+    unsigned long at_ms;
+};
+
+std::vector<ExtRecord> records;
+size_t serial_seen;
+
+// at_ms is when the line's first bytes came out (the record was written);
+// the rest follows as the UART drains
+bool next_record(unsigned long limit_ms = RECORD_PERIOD_MS + 5000)
+{
+    unsigned long deadline = millis() + limit_ms;
+    unsigned long started = 0;
+    for (;;) {
+        size_t end = Serial.sim_out.find('\n', serial_seen);
+        if (end != std::string::npos) {
+            std::string line = Serial.sim_out.substr(serial_seen, end + 1 - serial_seen);
+            serial_seen = end + 1;
+            if (line[0] == '#')
+                continue;
+            records.push_back({ line, started ? started : millis() });
+            return true;
+        }
+        if (!started && Serial.sim_out.size() > serial_seen && Serial.sim_out[serial_seen] != '#')
+            started = millis();
+        if (millis() > deadline)
+            return false;
+        loop();
+        sim_advance(LOOP_US);
+    }
+}
+
+std::vector<std::string> split(const std::string &line)
+{
+    std::vector<std::string> fields;
+    size_t start = 0, comma;
+    std::string body = line.substr(0, line.find('\n'));
+    while ((comma = body.find(',', start)) != std::string::npos) {
+        fields.push_back(body.substr(start, comma - start));
+        start = comma + 1;
+    }
+    fields.push_back(body.substr(start));
+    return fields;
+}
+
+long field(const std::vector<std::string> &f, size_t i)
+{
+    return atol(f[i].c_str());
+}
+
+TEST(SimExtended, EveryFrameIsSummarized)
+{
+    board->power_on(BOOT_TIME);
+    board->pms.pm25.add(0, 10);
+    board->pms.pm25.add(200000, 210);       // +1 ug/m3 per second
+    setup();
+    for (int i = 0; i < 12; i++)
+        ASSERT_TRUE(next_record()) << "record " << i;
+
+    unsigned long summarized = 0;
+    for (size_t i = 1; i < records.size(); i++) {
+        std::vector<std::string> f = split(records[i].line);
+        ASSERT_EQ(FRAMES + 3, f.size()) << records[i].line;   // + age, trailing comma
+        EXPECT_GE(records[i].at_ms - records[i - 1].at_ms, RECORD_PERIOD_MS);
+        EXPECT_LT(records[i].at_ms - records[i - 1].at_ms, RECORD_PERIOD_MS + 500);
+
+        // one frame a second in active mode, none lost to the record cycle
+        // (record 1's window starts at boot, before the PMS's first frame)
+        long frames = field(f, FRAMES);
+        if (i > 1) {
+            EXPECT_NEAR(RECORD_PERIOD_MS / 1000, frames, 1) << records[i].line;
+        }
+        summarized += frames;
+
+        // the ramp: mean mid-interval, max the newest frame's
+        long mean = field(f, SUMMARY + 2 * ENV_PM25), peak = field(f, SUMMARY + 2 * ENV_PM25 + 1);
+        EXPECT_EQ(field(f, 18), peak) << records[i].line;
+        EXPECT_NEAR(peak - (frames - 1) / 2.0, mean, 1) << records[i].line;
+        EXPECT_EQ(mean, field(f, SUMMARY + 2 * CF_PM25));
+
+        // flat PM1: counts follow it exactly
+        EXPECT_EQ("5", f[SUMMARY + 2 * ENV_PM1]);
+        EXPECT_EQ("5", f[SUMMARY + 2 * ENV_PM1 + 1]);
+        EXPECT_EQ("750", f[SUMMARY + 2 * COUNT_03UM]);
+        EXPECT_EQ(8 * peak, field(f, SUMMARY + 2 * COUNT_10UM + 1));
+    }
+    EXPECT_NEAR(board->pms.frames, summarized, RECORD_PERIOD_MS / 1000 + 2);
+    EXPECT_EQ(0, board->pms.dropped);
+}
+
+// ADS_SAMPLES rounds per record, paced over RECORD_PERIOD_MS: the middle
+// half of a record window holds about half of them
+TEST(SimExtended, AdsRoundsArePacedOverTheRecord)
+{
+    ASSERT_TRUE(next_record());
+    unsigned long at = records.back().at_ms;
+    while (millis() < at + RECORD_PERIOD_MS / 4) {
+        loop();
+        sim_advance(LOOP_US);
+    }
+    unsigned long first = board->ads49.conversions;
+    while (millis() < at + 3 * RECORD_PERIOD_MS / 4) {
+        loop();
+        sim_advance(LOOP_US);
+    }
+    unsigned long middle = board->ads49.conversions - first;
+    EXPECT_NEAR(3 * ADS_SAMPLES / 2, middle, 3) << "0x49: CO_ch1, CO_ch2 & e2V";
+
+    ASSERT_TRUE(next_record());
+    std::vector<std::string> f = split(records.back().line);
+    for (size_t i = 0; i < ADS_USER_COUNT; i++)
+        EXPECT_EQ(ADS_SAMPLES, field(f, ADS_STATS + 3 * i + 2)) << records.back().line;
+}
+
+// The binary file decodes to the same summary columns (runs last: ends the log)
+TEST(SimExtended, BinaryFileMatchesSerialEcho)
+{
+    std::string serial;
+    for (size_t i = 0; i < records.size(); i++)
+        serial += records[i].line;
+
+    logger.end();
+    SdFat32 fs;
+    ASSERT_TRUE(fs.begin(SdSpiConfig(SD_CS, SHARED_SPI)));
+    File32 file = fs.open(fileName, O_RDONLY);
+    ASSERT_TRUE(file) << fileName;
+    std::string logged(file.fileSize(), '\0');
+    ASSERT_EQ((int)logged.size(), file.read(&logged[0], logged.size()));
+
+    BinlogReader reader;
+    ASSERT_TRUE(reader.open((const uint8_t *)logged.data(), logged.size())) << reader.error();
+    std::string decoded, line;
+    reader.header_csv(line);
+    EXPECT_EQ(0u, line.find("Timestamp(UTC),")) << line;
+    EXPECT_NE(std::string::npos, line.find(",PM_age(ms),")) << line;
+    for (size_t i = 0; i < reader.count(); i++) {
+        EXPECT_TRUE(reader.is_record(i));
+        reader.record_csv(i, line);
+        decoded += line;
+    }
+    EXPECT_EQ(serial, decoded);
+    printf("  %zu B/record binary, %zu B/record CSV\n",
+           (size_t)reader.header().record_size, serial.size() / records.size());
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    SimBoard sim;
+    board = &sim;
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <map>
+#include <string>
+#include <vector>
+#include "sim.h"
+#include "sd_logger.h"
+#include "soft_clock.h"
+#include "duty_cycle.h"
+
+/*  The sketch (sketch.cpp), built with SLEEP_ENABLED  */
+void setup();
+void loop();
+extern SD_Logger logger;
+extern char fileName[];
+extern SoftClock rtc_clock;
+extern DutyCycle duty;
+
+const uint32_t BOOT_TIME = 1791935717UL;    // 2026-10-13T23:55:17
+const unsigned long LOOP_US = 50;
+
+SimBoard *board;    // built in main(), after the bus globals
+
+/*  One record and what it cost since the previous one  */
+struct SleepRecord {
+    std::string line;
+    unsigned long awake_us;         // loop() time, sleeps excluded
+    unsigned long asleep_us;
+    unsigned long pms_off_us;       // PMS asleep
+};
+
+std::vector<SleepRecord> records;
+size_t serial_seen;
+
+// Runs loop() until it prints the next record line; the sleep after each
+// record happens inside the loop() call that printed it
+bool next_record(unsigned long limit_loops = 1000000)
+{
+    unsigned long start = cpu_time;
+    unsigned long slept = sim_slept_us;
+    unsigned long pms_off = board->pms.asleep_us;
+
+    for (unsigned long i = 0; i < limit_loops; i++) {
+        size_t end = Serial.sim_out.find('\n', serial_seen);
+        if (end != std::string::npos) {
+            std::string line = Serial.sim_out.substr(serial_seen, end + 1 - serial_seen);
+            serial_seen = end + 1;
+            if (line[0] == '#')
+                continue;
+            SleepRecord r;
+            r.line = line;
+            r.asleep_us = sim_slept_us - slept;
+            r.awake_us = cpu_time - start - r.asleep_us;
+            r.pms_off_us = board->pms.asleep_us - pms_off;
+            records.push_back(r);
+            return true;
+        }
+        loop();
+        sim_advance(LOOP_US);
+    }
+    return false;
+}
+
+std::vector<std::string> split(const std::string &line)
+{
+    std::vector<std::string> fields;
+    size_t start = 0, comma;
+    std::string body = line.substr(0, line.find('\n'));
+    while ((comma = body.find(',', start)) != std::string::npos) {
+        fields.push_back(body.substr(start, comma - start));
+        start = comma + 1;
+    }
+    fields.push_back(body.substr(start));
+    return fields;
+}
+
+TEST(SimSleep, SamplesOnTheSlots)
+{
+    board->power_on(BOOT_TIME);
+    setup();
+    ASSERT_TRUE(next_record());     // straight after boot, then on the slots
+    EXPECT_EQ(0u, records[0].line.compare(0, 19, "2026-10-13T23:55:18"));
+
+    const char *slots[] = { "2026-10-13T23:56:00", "2026-10-13T23:57:00", "2026-10-13T23:58:00",
+                            "2026-10-13T23:59:00", "2026-10-14T00:00:00", "2026-10-14T00:01:00",
+                            "2026-10-14T00:02:00", "2026-10-14T00:03:00" };
+    for (const char *slot : slots) {
+        ASSERT_TRUE(next_record()) << slot;
+        EXPECT_EQ(0u, records.back().line.compare(0, 19, slot)) << records.back().line;
+
+        // back on the square wave: the clock keeps counting after the wake
+        std::vector<std::string> f = split(records.back().line);
+        EXPECT_FALSE(f[17].empty());    // a PM frame after the warm-up
+        rtc_clock.poll();
+        rtc_clock.update();
+        EXPECT_EQ(board->rtc.unixtime(), rtc_clock.unixtime());
+    }
+    EXPECT_TRUE(rtc_clock.has_sqw());
+    EXPECT_EQ(0, duty.skip_count());
+    EXPECT_EQ(2u * 9, duty.sleep_count());  // warm-up & slot, per record
+    EXPECT_EQ(duty.sleep_count(), sim_sleeps);
+    EXPECT_EQ(duty.sleep_count(), board->rtc.alarms);
+    EXPECT_EQ("YPODE8_2026_10_14.CSV", std::string(fileName));
+}
+
+TEST(SimSleep, AwakeOnlyForTheBurst)
+{
+    ASSERT_GT(records.size(), 3u);
+    unsigned long awake = 0, asleep = 0, pms_off = 0, longest = 0;
+    // skip the boot record and the first slot (whose sleep started mid-minute)
+    for (size_t i = 2; i < records.size(); i++) {
+        awake += records[i].awake_us;
+        asleep += records[i].asleep_us;
+        pms_off += records[i].pms_off_us;
+        if (records[i].awake_us > longest)
+            longest = records[i].awake_us;
+    }
+    size_t n = records.size() - 2;
+    unsigned long pms_on = awake + asleep - pms_off;
+
+    printf("  awake %lu ms per %d s slot (%.2f %%), longest burst %lu ms, PMS fan on %lu s/slot\n",
+           awake / n / 1000, SLEEP_PERIOD_S, 100.0 * awake / (awake + asleep),
+           longest / 1000, pms_on / n / 1000000);
+
+    EXPECT_EQ(n * SLEEP_PERIOD_S * 1000000UL, awake + asleep);
+    EXPECT_LT(longest, 2000000u);
+    EXPECT_LT(100.0 * awake / (awake + asleep), 3.0);
+    EXPECT_EQ(0, board->pms.dropped);
+    EXPECT_EQ(0, sim_i2c.nacks);
+}
+
+TEST(SimSleep, PmsWarmsUpBeforeEachSlot)
+{
+    EXPECT_FALSE(board->pms.asleep);
+    // the last wake-up command went out one warm-up before this slot
+    unsigned long warm = cpu_time - board->pms.woke_at;
+    EXPECT_GE(warm, SLEEP_PMS_WARMUP_S * 1000000UL);
+    EXPECT_LT(warm, SLEEP_PMS_WARMUP_S * 1000000UL + 100000UL);
+    for (size_t i = 2; i < records.size(); i++)
+        EXPECT_GT(records[i].pms_off_us, (SLEEP_PERIOD_S - SLEEP_PMS_WARMUP_S - 2) * 1000000UL);
+}
+
+// Each day's file on the card, read while the pod sleeps, already holds
+// every record (runs last: mounts the card a second time)
+TEST(SimSleep, CardIsCurrentWhileAsleep)
+{
+    std::map<std::string, std::string> days;    // "2026_10_13" -> its lines
+    for (size_t i = 0; i < records.size(); i++) {
+        std::string day = records[i].line.substr(0, 10);
+        day[4] = day[7] = '_';
+        days[day] += records[i].line;
+    }
+    ASSERT_EQ(2u, days.size());
+
+    SdFat32 fs;
+    ASSERT_TRUE(fs.begin(SdSpiConfig(SD_CS, SHARED_SPI)));
+    for (std::map<std::string, std::string>::iterator d = days.begin(); d != days.end(); ++d) {
+        std::string name = "YPODE8_" + d->first + ".CSV";
+        File32 file = fs.open(name.c_str(), O_RDONLY);
+        ASSERT_TRUE(file) << name;
+
+        std::string logged(file.fileSize(), '\0');
+        ASSERT_EQ((int)logged.size(), file.read(&logged[0], logged.size()));
+        logged.resize(logged.find_last_not_of('\0') + 1);   // the open file's erased extent
+        ASSERT_NE(std::string::npos, logged.find('\n'));
+        EXPECT_EQ(0u, logged.find("Timestamp(UTC),"));       // header row, then the records
+        EXPECT_EQ(d->second, logged.substr(logged.find('\n') + 1)) << name;
+    }
+    EXPECT_EQ(0, logger.error_count());
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    SimBoard sim;
+    board = &sim;
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,15 @@
+/*******************************************************************************
+ * @file    sketch.cpp
+ * @brief   The sketch as the Arduino builder would compile it: core header,
+ *          the library types its functions take, generated prototypes (see
+ *          the Makefile), then the .ino itself
+ *
+ * @author  Percy Smith, percy.smith@colorado.edu
+ * @date    October 17, 2026
+ * @log     The .ino as one translation unit, prototypes first
+******************************************************************************/
+#include <Arduino.h>
+#include <RTClib.h>
+#include "PMS.h"
+#include "sketch_prototypes.h"
+#include "../../YPOD_V4.2.2.ino"
@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+#include <time.h>
+#include <string>
+#include "Arduino.h"
+#include "soft_clock.h"
+
+const int SQW_PIN = 5;
+
+/*  Fake DS3231: its seconds tick with the square wave in Arduino.cpp  */
+uint32_t rtc_base;          // RTC time at cpu_time 0
+unsigned rtc_reads;
+
+uint32_t read_rtc()
+{
+    rtc_reads++;
+    return rtc_base + millis() / 1000;
+}
+
+std::string gm_text(uint32_t unixtime)
+{
+    time_t t = unixtime;
+    char buf[32];
+    strftime(buf, sizeof(buf), "%Y-%m-%dT%H:%M:%S", gmtime(&t));
+    return buf;
+}
+
+/*  Starts a clock at `start` (cpu_time 0.3 s into that second)  */
+void boot(SoftClock &clock, uint32_t start, int irq_pin = -1, int sqw_pin = SQW_PIN)
+{
+    cpu_time = 300000;
+    rtc_base = start;
+    rtc_reads = 0;
+    sim_sqw_pin = sqw_pin;
+    sim_irq_pin = irq_pin;
+    detachInterrupt(0);
+    clock.begin(read_rtc, SQW_PIN);
+}
+
+/*  Runs loop() ticks of `tick_ms` for `ms`, polling as the sketch does  */
+void run(SoftClock &clock, unsigned long ms, unsigned long tick_ms = 10)
+{
+    for (unsigned long t = 0; t < ms; t += tick_ms) {
+        clock.poll();
+        delay(tick_ms);
+    }
+    clock.poll();
+}
+
+TEST(SoftClock, PolledSqwCountsTheSeconds)
+{
+    SoftClock clock;
+    boot(clock, 1791849600UL);
+    ASSERT_TRUE(clock.has_sqw());
+    EXPECT_EQ(1001u, millis());         // started on the first edge
+    EXPECT_EQ(1791849601UL, clock.unixtime());
+
+    for (int i = 0; i < 50; i++) {
+        run(clock, 1000);
+        clock.update();
+        EXPECT_EQ(read_rtc(), clock.unixtime());
+        EXPECT_EQ(gm_text(clock.unixtime()), clock.text());
+    }
+    EXPECT_EQ(1 + 50u, rtc_reads);      // the boot read + the checks above
+    EXPECT_EQ(0, clock.slip_count());
+}
+
+TEST(SoftClock, InterruptSqwCountsTheSeconds)
+{
+    SoftClock clock;
+    boot(clock, 1791849600UL, SQW_PIN);
+    ASSERT_TRUE(clock.has_sqw());
+    EXPECT_EQ(1791849601UL, clock.unixtime());
+
+    delay(7250);                        // no poll() needed
+    clock.update();
+    EXPECT_EQ(1791849608UL, clock.unixtime());
+    EXPECT_EQ(1u, rtc_reads);
+}
+
+TEST(SoftClock, TextCarriesAcrossBoundaries)
+{
+    const uint32_t starts[] = {
+        1798761590UL,   // 2026-12-31T23:59:50, new year
+        1835395190UL,   // 2028-02-28T23:59:50, leap day
+        1835481590UL,   // 2028-02-29T23:59:50
+        1793491190UL,   // 2026-10-31T23:59:50
+        1795996790UL,   // 2026-11-29T23:59:50, 30-day month
+        4107542390UL,   // 2100-02-28T23:59:50, no leap day
+        951782390UL,    // 2000-02-28T23:59:50, leap day
+    };
+    for (uint32_t start : starts) {
+        SoftClock clock;
+        boot(clock, start);
+        for (int i = 0; i < 20; i++) {
+            run(clock, 1000, 50);
+            clock.update();
+            ASSERT_EQ(gm_text(read_rtc()), clock.text()) << start;
+        }
+    }
+}
+
+TEST(SoftClock, SetMatchesGmtime)
+{
+    SoftClock clock;
+    const uint32_t times[] = { 0, 946684800UL, 951827696UL, 1791849600UL,
+                               1835481600UL, 4102444799UL, 4294967295UL };
+    for (uint32_t t : times) {
+        clock.set(t);
+        EXPECT_EQ(gm_text(t), clock.text());
+        EXPECT_EQ(t, clock.unixtime());
+    }
+    clock.set(1791849600UL);
+    clock.set(1791849600UL + 59);       // counted up
+    EXPECT_EQ(gm_text(1791849659UL), clock.text());
+    clock.set(1791849600UL);            // stepped back
+    EXPECT_EQ(gm_text(1791849600UL), clock.text());
+}
+
+TEST(SoftClock, ResyncCatchesAMissedEdge)
+{
+    SoftClock clock;
+    boot(clock, 1791849600UL);
+    rtc_base++;                         // RTC a second ahead: an edge missed
+
+    run(clock, RTC_RESYNC_MS - 2000);
+    clock.update();
+    EXPECT_EQ(read_rtc() - 1, clock.unixtime());
+    EXPECT_EQ(0, clock.slip_count());
+
+    run(clock, 3000);
+    clock.update();
+    EXPECT_EQ(read_rtc(), clock.unixtime());
+    EXPECT_EQ(gm_text(clock.unixtime()), clock.text());
+    EXPECT_EQ(1, clock.slip_count());
+    EXPECT_EQ(1 + 1 + 2u, rtc_reads);   // boot, the resync, the checks
+}
+
+TEST(SoftClock, NoSqwReadsTheRtc)
+{
+    SoftClock clock;
+    boot(clock, 1791849600UL, -1, -1);
+    EXPECT_FALSE(clock.has_sqw());
+    EXPECT_EQ(300 + CLOCK_SQW_WAIT_MS, millis());
+
+    for (int i = 0; i < 5; i++) {
+        delay(1700);
+        clock.update();
+        EXPECT_EQ(rtc_base + millis() / 1000, clock.unixtime());
+        EXPECT_EQ(gm_text(clock.unixtime()), clock.text());
+    }
+    EXPECT_EQ(1 + 5u, rtc_reads);
+}
+
+TEST(SoftClock, LostSqwFallsBackToTheRtc)
+{
+    SoftClock clock;
+    boot(clock, 1791849600UL);
+    run(clock, 2000);
+    clock.update();
+    ASSERT_TRUE(clock.has_sqw());
+
+    sim_sqw_pin = -1;                   // wire comes off
+    run(clock, CLOCK_SQW_TIMEOUT_MS + 1000);
+    clock.update();
+    EXPECT_FALSE(clock.has_sqw());
+    EXPECT_EQ(rtc_base + millis() / 1000, clock.unixtime());
+}
+
+TEST(SoftClock, RestartAfterPowerDown)
+{
+    SoftClock clock;
+    boot(clock, 1791849600UL);
+    run(clock, 2000);
+    clock.update();
+
+    // asleep until an alarm at a whole second: no edges, millis() stopped
+    rtc_base += 3600;
+    clock.restart(read_rtc());
+    EXPECT_EQ(gm_text(read_rtc()), clock.text());
+
+    run(clock, 5000);
+    clock.update();
+    EXPECT_EQ(read_rtc(), clock.unixtime());
+    EXPECT_EQ(0, clock.slip_count());
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
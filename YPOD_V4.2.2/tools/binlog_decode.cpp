@@ -0,0 +1,324 @@
+/*******************************************************************************
+ * @file    binlog_decode.cpp
+ * @brief   Host-side reader for LOG_BINARY files (see binlog_decode.h)
+ *
+ * @author  Percy Smith, percy.smith@colorado.edu
+ * @date    October 17, 2026
+ * @log     Header checks, erased tail & AVR float rounding
+******************************************************************************/
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "binlog_decode.h"
+
+/*! Little-endian field of `size` bytes (the AVR's byte order) */
+static uint32_t get_le(const uint8_t *p, uint8_t size)
+{
+  uint32_t v = 0;
+  for (uint8_t i = size; i > 0; i--)
+    v = (v << 8) | p[i - 1];
+  return v;
+}
+
+/*! Bytes a column takes in a record */
+static uint8_t column_size(uint8_t type)
+{
+  switch (type)
+  {
+    case BIN_TIME:
+    case BIN_U32:
+    case BIN_I32:
+    case BIN_F32:
+    case BIN_I32_F:
+      return 4;
+    case BIN_U16:
+    case BIN_I16:
+    case BIN_I16_F:
+      return 2;
+    default:
+      return 0;
+  }
+}
+
+/*! '\0'-padded header text, which may fill its whole field */
+static std::string header_text(const char *text, size_t size)
+{
+  size_t n = 0;
+  while (n < size && text[n])
+    n++;
+  return std::string(text, n);
+}
+
+BinlogReader::BinlogReader()
+{
+  file = NULL;
+  file_size = 0;
+  memset(&head, 0, sizeof(head));
+  schema = NULL;
+  row_size = 0;
+  err = "no file";
+} //BinlogReader()
+
+/**************************************************************************/
+ /*!
+ *    @brief  Checks the header & schema; `data` must outlive the reader
+ *    @return False (see error()) if this is not a readable LOG_BINARY file
+ */
+/**************************************************************************/
+bool BinlogReader::open(const uint8_t *data, size_t size)
+{
+  file = data;
+  file_size = size;
+  err = NULL;
+
+  if (size < sizeof(head) || memcmp(data, BIN_MAGIC, sizeof(head.magic)) != 0)
+  {
+    err = "not a YPOD binary log";
+    return false;
+  }
+  memcpy(&head, data, sizeof(head));
+  schema = data + sizeof(head);
+
+  if (head.version < 1 || head.version > BIN_VERSION)
+  {
+    err = "unsupported format version";
+    return false;
+  }
+  if (head.header_size < sizeof(head) + 2 * head.columns || head.header_size > size)
+  {
+    err = "truncated header";
+    return false;
+  }
+
+  // the CSV header row; versions 1 & 2 have none
+  row_size = head.header_size - sizeof(head) - 2 * head.columns;
+  bool row_ok = head.version < 3 ? row_size == 0
+                                 : row_size == 0 || schema[2 * head.columns + row_size - 1] == '\n';
+  if (!row_ok)
+  {
+    err = "bad header row";
+    return false;
+  }
+
+  uint16_t record_size = 1 + flag_bytes();
+  for (uint8_t i = 0; i < head.columns; i++)
+  {
+    if (schema[2 * i] >= BIN_TYPES || schema[2 * i + 1] > 8 * flag_bytes())
+    {
+      err = "unknown column type";
+      return false;
+    }
+    record_size += column_size(schema[2 * i]);
+  }
+  if (record_size != head.record_size)
+  {
+    err = "record size does not match the schema";
+    return false;
+  }
+
+  return true;
+} //bool BinlogReader::open(const uint8_t *data, size_t size)
+
+const char *BinlogReader::error()
+{
+  return err ? err : "";
+} //const char *BinlogReader::error()
+
+const binlog_header_t &BinlogReader::header()
+{
+  return head;
+} //const binlog_header_t &BinlogReader::header()
+
+/**************************************************************************/
+ /*!
+ *    @brief  The CSV header row the text mode starts a file with ("" if
+ *            the file does not carry one: version 1 & 2)
+ */
+/**************************************************************************/
+void BinlogReader::header_csv(std::string &line)
+{
+  line.clear();
+  if (err)
+    return;
+  line.assign((const char *)schema + 2 * head.columns, row_size);
+} //void BinlogReader::header_csv(std::string &line)
+
+/**************************************************************************/
+ /*!
+ *    @brief  Whole records after the header (incl. an erased, never
+ *            truncated tail - see is_record())
+ */
+/**************************************************************************/
+size_t BinlogReader::count()
+{
+  if (err)
+    return 0;
+  return (file_size - head.header_size) / head.record_size;
+} //size_t BinlogReader::count()
+
+/**************************************************************************/
+ /*!
+ *    @brief  False for erased space (power cut before the file was
+ *            truncated) or a record that does not start with BIN_SYNC
+ */
+/**************************************************************************/
+bool BinlogReader::is_record(size_t index)
+{
+  return file[head.header_size + index * head.record_size] == BIN_SYNC;
+} //bool BinlogReader::is_record(size_t index)
+
+/**************************************************************************/
+ /*!
+ *    @brief  One record as its RETIGO CSV line (every field followed by
+ *            ',', then '\n' - as Record builds it)
+ */
+/**************************************************************************/
+void BinlogReader::record_csv(size_t index, std::string &line)
+{
+  const uint8_t *rec = file + head.header_size + index * head.record_size;
+  const uint8_t *p = rec + 1 + flag_bytes();
+  uint16_t flags = get_le(rec + 1, flag_bytes());
+  char tmp[16];
+
+  line.clear();
+  for (uint8_t i = 0; i < head.columns; i++)
+  {
+    uint8_t type = schema[2 * i];
+    uint8_t flag = schema[2 * i + 1];
+    uint8_t size = column_size(type);
+    uint32_t v = get_le(p, size);
+    p += size;
+
+    if (flag && !(flags & (1 << (flag - 1))))
+    {
+      line += ',';
+      continue;
+    }
+
+    switch (type)
+    {
+      case BIN_TIME:
+        line += binlog_time(head.base_time + v);
+        break;
+      case BIN_POD_ID:
+        line += header_text(head.pod_id, sizeof(head.pod_id));
+        break;
+      case BIN_FIRMWARE:
+        line += header_text(head.firmware, sizeof(head.firmware));
+        break;
+      case BIN_U16:
+      case BIN_U32:
+        snprintf(tmp, sizeof(tmp), "%lu", (unsigned long)v);
+        line += tmp;
+        break;
+      case BIN_I16:
+        snprintf(tmp, sizeof(tmp), "%d", (int)(int16_t)v);
+        line += tmp;
+        break;
+      case BIN_I32:
+        snprintf(tmp, sizeof(tmp), "%ld", (long)(int32_t)v);
+        line += tmp;
+        break;
+      case BIN_F32:
+      {
+        float f;
+        memcpy(&f, &v, sizeof(f));
+        line += binlog_float(f);
+        break;
+      }
+      case BIN_I16_F:
+        line += binlog_float((float)(int16_t)v);
+        break;
+      case BIN_I32_F:
+        line += binlog_float((float)(int32_t)v);
+        break;
+      default:
+        break;
+    }
+    line += ',';
+  }
+  line += '\n';
+} //void BinlogReader::record_csv(size_t index, std::string &line)
+
+/*! Bytes of flags after each record's sync byte: 1 in version 1 files */
+uint8_t BinlogReader::flag_bytes()
+{
+  return head.version == 1 ? 1 : 2;
+} //uint8_t BinlogReader::flag_bytes()
+
+/**************************************************************************/
+ /*!
+ *    @brief  "YYYY-MM-DDThh:mm:ss" for a unixtime (RTClib's, i.e. the pod's
+ *            local clock counted as UTC)
+ *
+ *    @cite   H. Hinnant, "chrono-Compatible Low-Level Date Algorithms"
+ *            (civil_from_days)
+ */
+/**************************************************************************/
+std::string binlog_time(uint32_t unixtime)
+{
+  long days = unixtime / 86400;
+  uint32_t sec = unixtime % 86400;
+
+  days += 719468;
+  long era = days / 146097;
+  unsigned doe = days - era * 146097;
+  unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  unsigned mp = (5 * doy + 2) / 153;
+  unsigned d = doy - (153 * mp + 2) / 5 + 1;
+  unsigned m = mp < 10 ? mp + 3 : mp - 9;
+  unsigned y = yoe + era * 400 + (m <= 2);
+
+  char buf[40];
+  snprintf(buf, sizeof(buf), "%04u-%02u-%02uT%02u:%02u:%02u",
+           y, m, d, (unsigned)(sec / 3600), (unsigned)(sec / 60 % 60), (unsigned)(sec % 60));
+  return buf;
+} //std::string binlog_time(uint32_t unixtime)
+
+/**************************************************************************/
+ /*!
+ *    @brief  Print::print(float, digits) as the AVR does it: SdFat's
+ *            fmtDouble() with every step in float (incl. "nan", an unsigned
+ *            "inf" and "ovf")
+ *
+ *    @cite   SdFat >> common/FmtNumber.cpp fmtDouble()
+ */
+/**************************************************************************/
+std::string binlog_float(float value, uint8_t digits)
+{
+  static const float pow_ten[] = {1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f};
+  static const float rnd[] = {5e-1f, 5e-2f, 5e-3f, 5e-4f, 5e-5f,
+                              5e-6f, 5e-7f, 5e-8f, 5e-9f, 5e-10f};
+  const uint8_t max_prec = sizeof(pow_ten) / sizeof(pow_ten[0]);
+  volatile float num = value;   // no excess precision (x87) between the steps
+  bool neg = num < 0;
+  char buf[32];
+
+  if (neg)
+    num = -num;
+  if (isnan(num))
+    return "nan";
+  if (isinf(num))
+    return "inf";
+  if (num > 4294967040.0f)
+    return "ovf";
+
+  if (digits > max_prec)
+    digits = max_prec;
+  num = num + rnd[digits];
+  uint32_t ul = num;
+
+  std::string out = neg ? "-" : "";
+  snprintf(buf, sizeof(buf), "%lu", (unsigned long)ul);
+  out += buf;
+  if (digits)
+  {
+    volatile float frac = num - (float)ul;
+    uint32_t f = frac * pow_ten[digits - 1];
+    snprintf(buf, sizeof(buf), ".%0*lu", (int)digits, (unsigned long)f);
+    out += buf;
+  }
+  return out;
+} //std::string binlog_float(float value, uint8_t digits)
@@ -0,0 +1,50 @@
+/*******************************************************************************
+ * @file    binlog_decode.h
+ * @brief   Host-side reader for LOG_BINARY files (see ../binlog.h): checks the
+ *          header and prints the header row and each record as the RETIGO
+ *          CSV the text mode would have logged, byte for byte
+ *
+ *          Floats are formatted with float arithmetic like SdFat's
+ *          fmtDouble() on the AVR (double == float there)
+ *
+ * @author  Percy Smith, percy.smith@colorado.edu
+ * @date    October 17, 2026
+ * @log     Decoder shared by ypod_bin2csv & the host tests
+******************************************************************************/
+#ifndef _BINLOG_DECODE_H
+#define _BINLOG_DECODE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+
+#include "binlog.h"
+
+/*! One LOG_BINARY file held in memory */
+class BinlogReader {
+  public:
+    BinlogReader();
+    bool open(const uint8_t *data, size_t size);
+    const char *error();
+
+    const binlog_header_t &header();
+    void header_csv(std::string &line);
+    size_t count();
+    bool is_record(size_t index);
+    void record_csv(size_t index, std::string &line);
+
+  private:
+    uint8_t flag_bytes();
+
+    const uint8_t *file;
+    size_t file_size;
+    binlog_header_t head;
+    const uint8_t *schema;      // head.columns x { type, flag }
+    uint16_t row_size;          // CSV header row after the schema (version 3)
+    const char *err;
+};  //class BinlogReader
+
+std::string binlog_time(uint32_t unixtime);
+std::string binlog_float(float value, uint8_t digits = 2);
+
+#endif  //_BINLOG_DECODE_H
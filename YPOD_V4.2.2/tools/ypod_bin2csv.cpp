@@ -0,0 +1,91 @@
+/*******************************************************************************
+ * @file    ypod_bin2csv.cpp
+ * @brief   Converts a LOG_BINARY daily file (YPODID_YYYY_MM_DD.BIN) back to
+ *          the RETIGO CSV the pod writes in text mode
+ *
+ *          ypod_bin2csv YPODE8_2026_10_13.BIN [YPODE8_2026_10_13.CSV]
+ *
+ *          Without an output name the CSV goes to stdout. It starts with the
+ *          header row stored in the file (format version 3), so it matches
+ *          the text mode's file byte for byte. Erased space left by a power
+ *          cut is skipped; the counts are reported on stderr
+ *
+ * @author  Percy Smith, percy.smith@colorado.edu
+ * @date    October 17, 2026
+ * @log     Binary record mode; prints the header row first
+******************************************************************************/
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include "binlog_decode.h"
+
+static bool read_file(const char *path, std::vector<uint8_t> &data)
+{
+  FILE *in = fopen(path, "rb");
+  if (!in)
+    return false;
+
+  uint8_t buf[4096];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), in)) > 0)
+    data.insert(data.end(), buf, buf + n);
+
+  bool ok = !ferror(in);
+  fclose(in);
+  return ok;
+}
+
+int main(int argc, char **argv)
+{
+  std::vector<uint8_t> data;
+  BinlogReader reader;
+
+  if (argc < 2 || argc > 3)
+  {
+    fprintf(stderr, "usage: %s FILE.BIN [FILE.CSV]\n", argv[0]);
+    return 2;
+  }
+  if (!read_file(argv[1], data))
+  {
+    perror(argv[1]);
+    return 1;
+  }
+  if (!reader.open(data.data(), data.size()))
+  {
+    fprintf(stderr, "%s: %s\n", argv[1], reader.error());
+    return 1;
+  }
+
+  FILE *out = argc == 3 ? fopen(argv[2], "wb") : stdout;
+  if (!out)
+  {
+    perror(argv[2]);
+    return 1;
+  }
+
+  std::string line;
+  size_t written = 0, skipped = 0;
+  reader.header_csv(line);
+  if (line.empty())
+    fprintf(stderr, "%s: version %u file, no header row\n", argv[1], (unsigned)reader.header().version);
+  fwrite(line.data(), 1, line.size(), out);
+  for (size_t i = 0; i < reader.count(); i++)
+  {
+    if (!reader.is_record(i))
+    {
+      skipped++;
+      continue;
+    }
+    reader.record_csv(i, line);
+    fwrite(line.data(), 1, line.size(), out);
+    written++;
+  }
+
+  bool ok = fflush(out) == 0 && !ferror(out);
+  if (out != stdout)
+    ok = fclose(out) == 0 && ok;
+
+  fprintf(stderr, "%s: %zu records, %zu empty slots skipped\n", argv[1], written, skipped);
+  return ok ? 0 : 1;
+}